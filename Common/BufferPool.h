@@ -0,0 +1,201 @@
+/**
+ * @file BufferPool.h
+ * @brief Fixed-size cache of the pages of a file, read and written with pread/pwrite.
+ *
+ * A BufferPool keeps up to framesCount pages of a file in memory. fetch() returns a pinned handle
+ * to a page, reading it from the file only if it isn't cached; a pinned page is never evicted, so
+ * its data stays valid until the handle is destroyed. When every frame is used, the CLOCK policy
+ * picks the page to evict: a hand sweeps the frames, giving a second chance to the pages used since
+ * it last passed, and a modified (dirty) page is written back before its frame is reused.
+ *
+ * The pool counts the pages it reads and writes, the I/Os an algorithm on top of it performs.
+ * It is not thread-safe.
+ *
+ * Usage example:
+ * --------------
+ * BufferPool pool(fd, 4096, 64);
+ * {
+ *     BufferPool::Page page = pool.fetch(3);
+ *     page.data()[0] = 1;
+ *     page.markDirty();
+ * }
+ * pool.flush();
+ *
+ * @note This class relies on POSIX pread/pwrite.
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_BUFFERPOOL_H
+#define DSA_BUFFERPOOL_H
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "../Hashing/HashTable.h"
+
+class BufferPool {
+public:
+    /**
+     * @brief A page pinned in the pool, unpinned when the handle is destroyed. Movable only.
+     */
+    class Page {
+    public:
+        Page(Page&& other) noexcept : pool(std::exchange(other.pool, nullptr)), frame(other.frame) {}
+        Page(const Page& other) = delete;
+        Page& operator=(const Page& other) = delete;
+        Page& operator=(Page&& other) = delete;
+
+        ~Page() {
+            if (pool) pool->frames[frame].pins--;
+        }
+
+        [[nodiscard]] char* data() const { return pool->memory.data() + frame * pool->pageSize; }
+
+        [[nodiscard]] std::uint32_t number() const { return pool->frames[frame].page; }
+
+        /**
+         * @brief Marks the page as modified, so it is written back before being evicted.
+         */
+        void markDirty() const { pool->frames[frame].dirty = true; }
+
+    private:
+        friend class BufferPool;
+        BufferPool* pool;
+        std::size_t frame;
+
+        Page(BufferPool* pool, std::size_t frame) : pool(pool), frame(frame) { pool->frames[frame].pins++; }
+    };
+
+    /**
+     * @param fd The file, opened for reading and writing. The pool doesn't close it.
+     * @param pageSize Size of a page, in bytes.
+     * @param framesCount Number of pages kept in memory, at least as many as the pages pinned at once.
+     */
+    BufferPool(int fd, std::uint32_t pageSize, std::size_t framesCount)
+            : fd(fd), pageSize(pageSize), frames(framesCount), memory(framesCount * pageSize),
+              frameOf(static_cast<int>(framesCount * 2) | 1) {
+        if (framesCount == 0) throw std::invalid_argument("A buffer pool needs at least one frame.");
+    }
+
+    BufferPool(const BufferPool& other) = delete;
+    BufferPool& operator=(const BufferPool& other) = delete;
+
+    /**
+     * @return the page, read from the file unless it is cached.
+     * @throws std::runtime_error If the page can't be read, or every frame is pinned.
+     */
+    Page fetch(std::uint32_t pageNumber) {
+        if (const int* frame = frameOf.find(pageNumber)) {
+            frames[*frame].referenced = true;
+            return Page(this, static_cast<std::size_t>(*frame));
+        }
+
+        std::size_t frame = claimFrame(pageNumber);
+        auto offset = static_cast<off_t>(pageNumber) * pageSize;
+        if (::pread(fd, memory.data() + frame * pageSize, pageSize, offset) != static_cast<ssize_t>(pageSize)) {
+            release(frame);
+            throw std::runtime_error("Couldn't read page " + std::to_string(pageNumber));
+        }
+        pageReads++;
+        return Page(this, frame);
+    }
+
+    /**
+     * @return a page of zeros, replacing the page's content in the file (it isn't read), marked dirty.
+     * @throws std::runtime_error If every frame is pinned.
+     */
+    Page create(std::uint32_t pageNumber) {
+        std::size_t frame;
+        if (const int* cached = frameOf.find(pageNumber)) frame = static_cast<std::size_t>(*cached);
+        else frame = claimFrame(pageNumber);
+
+        std::memset(memory.data() + frame * pageSize, 0, pageSize);
+        frames[frame].dirty = true;
+        return Page(this, frame);
+    }
+
+    /**
+     * @brief Writes every dirty page to the file, keeping them cached.
+     * @throws std::runtime_error If a page can't be written.
+     */
+    void flush() {
+        for (std::size_t frame = 0; frame < frames.size(); ++frame)
+            if (frames[frame].dirty) writeBack(frame);
+    }
+
+    [[nodiscard]] std::uint64_t reads() const { return pageReads; }
+
+    [[nodiscard]] std::uint64_t writes() const { return pageWrites; }
+
+    [[nodiscard]] std::size_t framesCount() const { return frames.size(); }
+
+private:
+    static constexpr std::uint32_t NO_PAGE = std::numeric_limits<std::uint32_t>::max();
+
+    struct Frame {
+        std::uint32_t page = NO_PAGE;
+        int pins = 0;
+        bool dirty = false;
+        bool referenced = false;  // Used since the clock hand last passed
+    };
+
+    int fd;
+    std::uint32_t pageSize;
+    std::vector<Frame> frames;
+    std::vector<char> memory;                // The frames' pages, contiguous
+    HashTable<std::uint32_t, int> frameOf;   // Frame of each cached page
+    std::size_t hand = 0;
+    std::uint64_t pageReads = 0;
+    std::uint64_t pageWrites = 0;
+
+    /**
+     * @brief Evicts a page if needed, and assigns the frame to the given page.
+     */
+    std::size_t claimFrame(std::uint32_t pageNumber) {
+        // Two sweeps clear every reference bit, a third one finding nothing means everything is pinned
+        for (std::size_t step = 0; step < 3 * frames.size(); ++step) {
+            std::size_t frame = hand;
+            hand = (hand + 1) % frames.size();
+
+            Frame& candidate = frames[frame];
+            if (candidate.pins > 0) continue;
+            if (candidate.referenced) {
+                candidate.referenced = false;
+                continue;
+            }
+
+            if (candidate.page != NO_PAGE) {
+                if (candidate.dirty) writeBack(frame);
+                frameOf.remove(candidate.page);
+            }
+            candidate.page = pageNumber;
+            candidate.referenced = true;
+            candidate.dirty = false;
+            frameOf.insert(pageNumber, static_cast<int>(frame));
+            return frame;
+        }
+        throw std::runtime_error("Every page of the buffer pool is pinned.");
+    }
+
+    void release(std::size_t frame) {
+        frameOf.remove(frames[frame].page);
+        frames[frame] = Frame();
+    }
+
+    void writeBack(std::size_t frame) {
+        auto offset = static_cast<off_t>(frames[frame].page) * pageSize;
+        if (::pwrite(fd, memory.data() + frame * pageSize, pageSize, offset) != static_cast<ssize_t>(pageSize))
+            throw std::runtime_error("Couldn't write page " + std::to_string(frames[frame].page));
+        frames[frame].dirty = false;
+        pageWrites++;
+    }
+};
+
+#endif //DSA_BUFFERPOOL_H
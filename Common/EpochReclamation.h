@@ -0,0 +1,205 @@
+/**
+ * @file EpochReclamation.h
+ * @brief Epoch based memory reclamation, deferring the deletion of nodes unlinked from lock-free structures.
+ *
+ * A thread that unlinks a node from a lock-free structure can't delete it right away: other threads
+ * may have read a pointer to it before it was unlinked and still be traversing it. Instead, every
+ * access to the structure is done inside a Guard, and unlinked nodes are retired rather than deleted.
+ *
+ * The process has a global epoch counter. A Guard publishes the epoch it started in, and the epoch
+ * only advances once every thread inside a Guard has observed the current one. A node retired during
+ * epoch e may still be referenced by guards started in epoch e (or e - 1, which may not have seen the
+ * new value yet), but not by any guard started in epoch e + 1 or later: once the global epoch reaches
+ * e + 2 no thread can reach the node, and it is deleted.
+ *
+ * Entering and leaving a Guard is a couple of stores to a thread local record, with a single fence.
+ * Retired nodes are kept in the retiring thread's record and freed by that thread, every 64 retires.
+ * A thread staying inside a Guard indefinitely blocks the reclamation (but never the other threads'
+ * operations), so guards should cover one operation each.
+ *
+ * Usage example:
+ * --------------
+ * EpochReclamation& epochs = EpochReclamation::shared();
+ * {
+ *     EpochReclamation::Guard guard = epochs.guard();
+ *     Node* node = unlinkFirst(list);
+ *     epochs.retire(node, [](void* pointer) { delete static_cast<Node*>(pointer); });
+ * }
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_EPOCHRECLAMATION_H
+#define DSA_EPOCHRECLAMATION_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+class EpochReclamation {
+public:
+    using Deleter = void (*)(void*);
+
+    /**
+     * @brief Keeps the nodes reachable by the current thread alive until it is destroyed. Guards can be nested.
+     */
+    class Guard {
+    public:
+        Guard(Guard&& other) noexcept : owner(other.owner) { other.owner = nullptr; }
+        Guard(const Guard& other) = delete;
+        Guard& operator=(const Guard& other) = delete;
+        Guard& operator=(Guard&& other) = delete;
+
+        ~Guard() {
+            if (owner) owner->leave();
+        }
+
+    private:
+        friend class EpochReclamation;
+        EpochReclamation* owner;
+
+        explicit Guard(EpochReclamation* owner) : owner(owner) { owner->enter(); }
+    };
+
+    /**
+     * @return the instance shared by the whole process.
+     */
+    static EpochReclamation& shared() {
+        static EpochReclamation instance;
+        return instance;
+    }
+
+    EpochReclamation(const EpochReclamation& other) = delete;
+    EpochReclamation& operator=(const EpochReclamation& other) = delete;
+
+    /**
+     * @brief Deletes every node still retired, no thread may be using them anymore.
+     */
+    ~EpochReclamation() {
+        Record* record = records.load(std::memory_order_acquire);
+        while (record) {
+            Record* next = record->next;
+            for (Retired& retired : record->retired) retired.deleter(retired.pointer);
+            delete record;
+            record = next;
+        }
+    }
+
+    /**
+     * @brief Enters a protected section, the nodes read until the guard is destroyed won't be deleted meanwhile.
+     */
+    Guard guard() { return Guard(this); }
+
+    /**
+     * @brief Schedules a node for deletion, once no thread can hold a reference to it.
+     *
+     * @param pointer The node, already unreachable from the structure it was in.
+     * @param deleter Called with the node to delete it, possibly from another thread later on.
+     */
+    void retire(void* pointer, Deleter deleter) {
+        Record& record = localRecord();
+        record.retired.push_back({pointer, deleter, epoch.load(std::memory_order_acquire)});
+        if (record.retired.size() % COLLECT_PERIOD == 0) {
+            tryAdvance();
+            collect(record);
+        }
+    }
+
+private:
+    static constexpr std::size_t COLLECT_PERIOD = 64;
+    static constexpr std::uint64_t ACTIVE = 1;   // Low bit of a record's state, the epoch being the other bits
+
+    struct Retired {
+        void* pointer;
+        Deleter deleter;
+        std::uint64_t epoch;
+    };
+
+    /**
+     * @brief State of a thread, never freed before the instance so other threads can always read it.
+     * Records of exited threads are reused by new threads, along with their retired nodes.
+     */
+    struct alignas(64) Record {
+        std::atomic<std::uint64_t> state{0};  // epoch << 1 | ACTIVE inside a guard, 0 outside
+        std::atomic<bool> owned{true};
+        int nesting = 0;
+        std::vector<Retired> retired;
+        Record* next = nullptr;
+    };
+
+    /**
+     * @brief Releases the calling thread's record when the thread exits.
+     */
+    struct LocalRecord {
+        Record* record = nullptr;
+
+        ~LocalRecord() {
+            if (record) record->owned.store(false, std::memory_order_release);
+        }
+    };
+
+    std::atomic<std::uint64_t> epoch{0};
+    std::atomic<Record*> records{nullptr};
+
+    EpochReclamation() = default;
+
+    Record& localRecord() {
+        static thread_local LocalRecord local;
+        if (!local.record) local.record = acquireRecord();
+        return *local.record;
+    }
+
+    Record* acquireRecord() {
+        for (Record* record = records.load(std::memory_order_acquire); record; record = record->next) {
+            bool owned = false;
+            if (!record->owned.load(std::memory_order_relaxed)
+                && record->owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+                return record;
+        }
+
+        auto* record = new Record();
+        record->next = records.load(std::memory_order_relaxed);
+        while (!records.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed));
+        return record;
+    }
+
+    void enter() {
+        Record& record = localRecord();
+        if (record.nesting++ > 0) return;
+
+        record.state.store(epoch.load(std::memory_order_relaxed) << 1 | ACTIVE, std::memory_order_relaxed);
+        // The published epoch must be visible to tryAdvance() before any node of the structure is read
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void leave() {
+        Record& record = localRecord();
+        if (--record.nesting > 0) return;
+        record.state.store(0, std::memory_order_release);
+    }
+
+    /**
+     * @brief Moves the global epoch forward if every thread inside a guard has observed the current one.
+     */
+    void tryAdvance() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto current = epoch.load(std::memory_order_relaxed);
+        for (Record* record = records.load(std::memory_order_acquire); record; record = record->next) {
+            auto state = record->state.load(std::memory_order_acquire);
+            if ((state & ACTIVE) && (state >> 1) != current) return;
+        }
+        epoch.compare_exchange_strong(current, current + 1, std::memory_order_acq_rel, std::memory_order_relaxed);
+    }
+
+    void collect(Record& record) {
+        auto current = epoch.load(std::memory_order_acquire);
+        std::size_t kept = 0;
+        for (Retired& retired : record.retired) {
+            if (retired.epoch + 2 <= current) retired.deleter(retired.pointer);
+            else record.retired[kept++] = retired;
+        }
+        record.retired.resize(kept);
+    }
+};
+
+#endif //DSA_EPOCHRECLAMATION_H
@@ -0,0 +1,121 @@
+/**
+ * @file Instrumentation.h
+ * @brief Opt-in instrumentation policies shared by the containers of this repository.
+ *
+ * Every container takes an Instrumentation policy (a template parameter, or a build flag for the Trie)
+ * and reports its internal work through the policy's static hooks:
+ * node allocations and de-allocations, node visits, key comparisons and structural events
+ * (tree rotations and hash table rehashes).
+ *
+ * - NoInstrumentation is the default. All its hooks are empty inline functions,
+ *   so an uninstrumented container compiles to exactly the same code as before.
+ * - CountingInstrumentation accumulates the events into thread local counters.
+ *   A CountingInstrumentation::Scope snapshots them, so the cost of a single operation
+ *   (or of any region) is the difference between two snapshots.
+ *
+ * Usage example:
+ * --------------
+ * AVLTree<int, std::less<int>, CountingInstrumentation> tree;
+ * CountingInstrumentation::Scope scope;
+ * tree.insert(5);
+ * std::cout << scope.elapsed().comparisons;
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_INSTRUMENTATION_H
+#define DSA_INSTRUMENTATION_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Counters of the events reported by the containers.
+ */
+struct InstrumentationCounters {
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t allocatedBytes = 0;
+    std::uint64_t deallocatedBytes = 0;
+    std::uint64_t nodeVisits = 0;
+    std::uint64_t comparisons = 0;
+    std::uint64_t rotations = 0;
+    std::uint64_t rehashes = 0;
+
+    InstrumentationCounters operator-(const InstrumentationCounters& other) const {
+        InstrumentationCounters result;
+        result.allocations = allocations - other.allocations;
+        result.deallocations = deallocations - other.deallocations;
+        result.allocatedBytes = allocatedBytes - other.allocatedBytes;
+        result.deallocatedBytes = deallocatedBytes - other.deallocatedBytes;
+        result.nodeVisits = nodeVisits - other.nodeVisits;
+        result.comparisons = comparisons - other.comparisons;
+        result.rotations = rotations - other.rotations;
+        result.rehashes = rehashes - other.rehashes;
+        return result;
+    }
+};
+
+/**
+ * @brief Default policy, every hook is a no-op.
+ */
+struct NoInstrumentation {
+    static void onAllocate(std::size_t) {}
+    static void onDeallocate(std::size_t) {}
+    static void onVisit() {}
+    static void onCompare() {}
+    static void onRotate() {}
+    static void onRehash() {}
+};
+
+/**
+ * @brief Policy counting every reported event in thread local counters.
+ */
+struct CountingInstrumentation {
+    class Scope;
+
+    static InstrumentationCounters& counters() {
+        static thread_local InstrumentationCounters threadCounters;
+        return threadCounters;
+    }
+
+    static void reset() { counters() = InstrumentationCounters(); }
+
+    static void onAllocate(std::size_t bytes) {
+        counters().allocations++;
+        counters().allocatedBytes += bytes;
+    }
+    static void onDeallocate(std::size_t bytes) {
+        counters().deallocations++;
+        counters().deallocatedBytes += bytes;
+    }
+    static void onVisit() { counters().nodeVisits++; }
+    static void onCompare() { counters().comparisons++; }
+    static void onRotate() { counters().rotations++; }
+    static void onRehash() { counters().rehashes++; }
+};
+
+/**
+ * @brief Snapshot of the calling thread's counters, used to measure a single operation or region.
+ */
+class CountingInstrumentation::Scope {
+public:
+    Scope() : start(CountingInstrumentation::counters()) {}
+
+    /**
+     * @return the events counted by this thread since the scope was created (or last restarted).
+     */
+    [[nodiscard]] InstrumentationCounters elapsed() const {
+        return CountingInstrumentation::counters() - start;
+    }
+
+    /**
+     * @brief Restarts the scope from the current counters.
+     */
+    void restart() { start = CountingInstrumentation::counters(); }
+
+private:
+    InstrumentationCounters start;
+};
+
+#endif //DSA_INSTRUMENTATION_H
@@ -0,0 +1,143 @@
+/**
+ * @file LatencyHistogram.h
+ * @brief HDR style histogram of latencies (or any non negative integer values).
+ *
+ * Values are counted in log-linear buckets: every power of two range is split into
+ * 2^SUB_BUCKET_BITS linear sub buckets, so any recorded value is known within 1/128 of itself
+ * (below 256 exactly), whatever its magnitude. Recording is a few arithmetic operations
+ * and an increment, and the memory used is fixed (about 60KB) no matter how many values are recorded.
+ *
+ * Usage example:
+ * --------------
+ * LatencyHistogram histogram;
+ * histogram.record(latencyNs);
+ * std::cout << histogram.percentile(99.9);
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_LATENCYHISTOGRAM_H
+#define DSA_LATENCYHISTOGRAM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+class LatencyHistogram {
+public:
+    LatencyHistogram() : counts(BUCKETS_COUNT, 0) {}
+
+    /**
+     * @brief Records a single value.
+     */
+    void record(std::uint64_t value) {
+        counts[bucketIndex(value)]++;
+        totalCount++;
+        sum += value;
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+
+    /**
+     * @brief Adds the values recorded by another histogram to this one.
+     */
+    void merge(const LatencyHistogram& other) {
+        for (std::size_t i = 0; i < counts.size(); ++i)
+            counts[i] += other.counts[i];
+        totalCount += other.totalCount;
+        sum += other.sum;
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+    }
+
+    /**
+     * @brief Removes every recorded value.
+     */
+    void reset() {
+        *this = LatencyHistogram();
+    }
+
+    /*region Constant Methods */
+
+    [[nodiscard]] std::uint64_t count() const { return totalCount; }
+
+    [[nodiscard]] std::uint64_t min() const { return totalCount ? minValue : 0; }
+
+    [[nodiscard]] std::uint64_t max() const { return maxValue; }
+
+    [[nodiscard]] double mean() const { return totalCount ? static_cast<double>(sum) / totalCount : 0; }
+
+    /**
+     * @brief Gets the value below which the given percentage of the recorded values fall.
+     *
+     * @param percentage A percentage in [0, 100], e.g. 99.9.
+     * @return The highest value equivalent (within the histogram precision) to the percentile,
+     *         never more than max(). 0 if nothing was recorded.
+     * @throws std::invalid_argument If the percentage is outside [0, 100].
+     */
+    [[nodiscard]] std::uint64_t percentile(double percentage) const {
+        if (percentage < 0 || percentage > 100)
+            throw std::invalid_argument("Percentile must be between 0 and 100.");
+        if (totalCount == 0) return 0;
+
+        // Rank of the value in the sorted recorded values, at least 1
+        auto rank = static_cast<std::uint64_t>(percentage / 100 * totalCount + 0.5);
+        rank = std::max<std::uint64_t>(rank, 1);
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= rank)
+                return std::min(highestEquivalentValue(i), maxValue);
+        }
+        return maxValue;
+    }
+
+    /*endregion*/
+
+private:
+    // 2^7 sub buckets per power of two, i.e. values are known within 1/128 of themselves
+    static constexpr int SUB_BUCKET_BITS = 7;
+    static constexpr std::uint64_t SUB_BUCKETS = std::uint64_t(1) << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKETS_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    std::vector<std::uint64_t> counts;
+    std::uint64_t totalCount = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t minValue = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t maxValue = 0;
+
+    static int mostSignificantBit(std::uint64_t value) {
+        int bit = 0;
+        while (value >>= 1) bit++;
+        return bit;
+    }
+
+    /**
+     * @brief Maps a value to its bucket.
+     *
+     * Values below 2 * SUB_BUCKETS have a bucket of their own. Larger values are shifted right until
+     * they fall in [SUB_BUCKETS, 2 * SUB_BUCKETS), each shift moving them to the next SUB_BUCKETS buckets.
+     */
+    static std::size_t bucketIndex(std::uint64_t value) {
+        if (value < 2 * SUB_BUCKETS) return value;
+
+        int shift = mostSignificantBit(value) - SUB_BUCKET_BITS;
+        return shift * SUB_BUCKETS + (value >> shift);
+    }
+
+    /**
+     * @return the largest value mapped to the given bucket.
+     */
+    static std::uint64_t highestEquivalentValue(std::size_t index) {
+        if (index < 2 * SUB_BUCKETS) return index;
+
+        std::uint64_t shift = index / SUB_BUCKETS - 1;
+        std::uint64_t subBucket = index - shift * SUB_BUCKETS;
+        return ((subBucket + 1) << shift) - 1;
+    }
+};
+
+#endif //DSA_LATENCYHISTOGRAM_H
@@ -0,0 +1,58 @@
+/**
+ * @file MemoryResource.h
+ * @brief Helpers to create and destroy container nodes through a std::pmr::memory_resource.
+ *
+ * Every node-based container of this repository takes an optional std::pmr::memory_resource
+ * (the default resource if none is given) and allocates all of its nodes from it.
+ * Passing a request scoped std::pmr::monotonic_buffer_resource, for example, turns node allocation
+ * into a pointer bump and releases every node at once with the resource.
+ *
+ * Usage example:
+ * --------------
+ * std::pmr::monotonic_buffer_resource arena;
+ * AVLTree<int> tree(&arena);
+ * tree.insert(5);
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_MEMORYRESOURCE_H
+#define DSA_MEMORYRESOURCE_H
+
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Allocates a node from a memory resource and constructs it in place.
+ *
+ * @param resource The memory resource to allocate from.
+ * @param args The arguments forwarded to the node's constructor.
+ * @return Pointer to the constructed node.
+ */
+template<typename Node, typename... Args>
+Node* newNode(std::pmr::memory_resource* resource, Args&&... args) {
+    void* memory = resource->allocate(sizeof(Node), alignof(Node));
+    try {
+        return ::new(memory) Node(std::forward<Args>(args)...);
+    } catch (...) {
+        resource->deallocate(memory, sizeof(Node), alignof(Node));
+        throw;
+    }
+}
+
+/**
+ * @brief Destroys a node and returns its memory to the resource it was allocated from.
+ *
+ * @param resource The memory resource the node was allocated from.
+ * @param node The node to destroy, nothing happens if it is nullptr.
+ */
+template<typename Node>
+void deleteNode(std::pmr::memory_resource* resource, Node* node) {
+    if(!node) return;
+
+    node->~Node();
+    resource->deallocate(node, sizeof(Node), alignof(Node));
+}
+
+#endif //DSA_MEMORYRESOURCE_H
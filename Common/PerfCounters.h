@@ -0,0 +1,174 @@
+/**
+ * @file PerfCounters.h
+ * @brief Hardware performance counters read around a code region through Linux perf_event_open.
+ *
+ * PerfCounters opens a group of counters (cycles, instructions, cache references and misses,
+ * branch misses) for the calling thread. start() and stop() enable and disable the whole group,
+ * so regions can be measured repeatedly and their counts accumulate until reset().
+ *
+ * If the counters can't be opened (non-Linux platform, restrictive perf_event_paranoid, missing
+ * hardware support), isAvailable() returns false and every reading is zero,
+ * so callers don't need a separate code path.
+ *
+ * Usage example:
+ * --------------
+ * PerfCounters perf;
+ * perf.start();
+ * table.get(key);
+ * perf.stop();
+ * std::cout << perf.read().cacheMisses;
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_PERFCOUNTERS_H
+#define DSA_PERFCOUNTERS_H
+
+#include <cstdint>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class PerfCounters {
+public:
+    struct Values {
+        std::uint64_t cycles = 0;
+        std::uint64_t instructions = 0;
+        std::uint64_t cacheReferences = 0;
+        std::uint64_t cacheMisses = 0;
+        std::uint64_t branchMisses = 0;
+    };
+
+    /*region Big Five */
+
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters& other) = delete;
+    PerfCounters& operator=(const PerfCounters& other) = delete;
+
+    /*endregion*/
+
+    /**
+     * @return true if the hardware counters could be opened, false otherwise.
+     */
+    [[nodiscard]] bool isAvailable() const;
+
+    /**
+     * @brief Starts (or resumes) counting.
+     */
+    void start();
+
+    /**
+     * @brief Stops counting, the counts are kept until reset().
+     */
+    void stop();
+
+    /**
+     * @brief Zeroes the counts.
+     */
+    void reset();
+
+    /**
+     * @return The counts accumulated between start() and stop() calls since the last reset().
+     */
+    [[nodiscard]] Values read() const;
+
+private:
+    static const int EVENTS_COUNT = 5;
+    int fds[EVENTS_COUNT] = {-1, -1, -1, -1, -1};   // fds[0] is the group leader
+};
+
+/*region Implementation */
+
+#ifdef __linux__
+
+inline PerfCounters::PerfCounters() {
+    const std::uint64_t configs[EVENTS_COUNT] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_REFERENCES,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int i = 0; i < EVENTS_COUNT; ++i) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = i == 0;     // Members follow the leader, only the leader starts disabled
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds[0], 0);
+
+        if(fds[i] < 0){
+            // All or nothing, partial groups would make readings misleading
+            for (int j = 0; j < i; ++j) close(fds[j]);
+            for (int& fd: fds) fd = -1;
+            return;
+        }
+    }
+}
+
+inline PerfCounters::~PerfCounters() {
+    for (int fd: fds) {
+        if(fd >= 0) close(fd);
+    }
+}
+
+inline bool PerfCounters::isAvailable() const {
+    return fds[0] >= 0;
+}
+
+inline void PerfCounters::start() {
+    if(isAvailable()) ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+inline void PerfCounters::stop() {
+    if(isAvailable()) ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+inline void PerfCounters::reset() {
+    if(isAvailable()) ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+}
+
+inline PerfCounters::Values PerfCounters::read() const {
+    std::uint64_t counts[EVENTS_COUNT] = {};
+
+    for (int i = 0; i < EVENTS_COUNT; ++i) {
+        if(fds[i] < 0 || ::read(fds[i], &counts[i], sizeof(counts[i])) != sizeof(counts[i]))
+            counts[i] = 0;
+    }
+
+    Values values;
+    values.cycles = counts[0];
+    values.instructions = counts[1];
+    values.cacheReferences = counts[2];
+    values.cacheMisses = counts[3];
+    values.branchMisses = counts[4];
+    return values;
+}
+
+#else
+
+inline PerfCounters::PerfCounters() = default;
+inline PerfCounters::~PerfCounters() = default;
+inline bool PerfCounters::isAvailable() const { return false; }
+inline void PerfCounters::start() {}
+inline void PerfCounters::stop() {}
+inline void PerfCounters::reset() {}
+inline PerfCounters::Values PerfCounters::read() const { return {}; }
+
+#endif
+
+/*endregion*/
+
+#endif //DSA_PERFCOUNTERS_H
@@ -0,0 +1,310 @@
+/**
+ * @file TaskScheduler.h
+ * @brief Work stealing task scheduler for the parallel container operations.
+ *
+ * A TaskScheduler owns a set of worker threads, each with its own deque of tasks.
+ * A worker pushes and pops the tasks it forks at the back of its deque (so it keeps working on
+ * the most recent, cache warm, subproblem), and an idle worker steals from the front of another
+ * worker's deque (the oldest, usually largest, subproblem). Threads outside the pool submit
+ * their tasks to a shared queue the workers steal from too.
+ *
+ * Parallelism is fork/join only:
+ *  - parallelInvoke(first, second) runs both functions, possibly in parallel, and returns once both are done.
+ *  - parallelFor(begin, end, body) runs body(i) for every i of [begin, end), splitting the range recursively.
+ * A thread waiting for a forked task runs other tasks meanwhile instead of blocking, so nested
+ * parallel calls (a parallel clone of each subtree, for example) can't deadlock the pool.
+ * An exception thrown by a task is rethrown by the call that forked it.
+ *
+ * Usage example:
+ * --------------
+ * TaskScheduler& scheduler = TaskScheduler::shared();
+ * scheduler.parallelFor(0, (int) buckets.size(), [&](int i) { rehashBucket(i); });
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_TASKSCHEDULER_H
+#define DSA_TASKSCHEDULER_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskScheduler {
+public:
+    /*region Big Five */
+
+    /**
+     * @brief Starts the worker threads.
+     * @param workersCount Number of worker threads, the number of hardware threads by default.
+     */
+    explicit TaskScheduler(unsigned workersCount = std::max(1u, std::thread::hardware_concurrency()));
+
+    /**
+     * @brief Stops the workers. Must not be called while parallel calls are running.
+     */
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler& other) = delete;
+    TaskScheduler& operator=(const TaskScheduler& other) = delete;
+
+    /*endregion*/
+
+    /**
+     * @return a scheduler shared by the whole process, started on first use.
+     */
+    static TaskScheduler& shared() {
+        static TaskScheduler scheduler;
+        return scheduler;
+    }
+
+    [[nodiscard]] unsigned workersCount() const { return static_cast<unsigned>(workers.size()); }
+
+    /**
+     * @brief Runs both functions, the second one possibly on another thread, and waits for both.
+     * @throws Whatever either function throws (the first one's exception if both throw).
+     */
+    template<typename First, typename Second>
+    void parallelInvoke(First&& first, Second&& second);
+
+    /**
+     * @brief Runs body(i) for every i in [begin, end).
+     *
+     * @param grain Size of the chunks the range is split into, the range is split in about 8 chunks
+     *              per worker if 0. Chunks are run sequentially, in order.
+     * @throws Whatever body throws.
+     */
+    template<typename Index, typename Body>
+    void parallelFor(Index begin, Index end, Body&& body, Index grain = 0);
+
+private:
+    struct Task {
+        std::function<void()> function;
+        std::atomic<bool> done{false};
+        std::exception_ptr exception;
+
+        void run() {
+            try {
+                function();
+            } catch (...) {
+                exception = std::current_exception();
+            }
+            done.store(true, std::memory_order_release);
+        }
+    };
+
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<Task*> tasks;
+    };
+
+    struct Worker {
+        TaskQueue queue;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    TaskQueue submitted;             // tasks forked by threads outside the pool
+
+    std::atomic<int> queuedCount{0}; // tasks in all the queues
+    std::atomic<bool> stopping{false};
+    std::atomic<int> sleepingCount{0};  // workers waiting for tasks
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+
+    // Index of the calling thread in currentScheduler's workers
+    static thread_local TaskScheduler* currentScheduler;
+    static thread_local int currentWorker;
+
+    TaskQueue& localQueue();
+    void push(Task* task);
+    bool popLocal(Task* task);
+    Task* findTask();
+    void join(Task& task);
+    void workerLoop(int index);
+
+    template<typename Index, typename Body>
+    void parallelForRange(Index begin, Index end, Body& body, Index grain);
+};
+
+inline thread_local TaskScheduler* TaskScheduler::currentScheduler = nullptr;
+inline thread_local int TaskScheduler::currentWorker = -1;
+
+/*region Big Five */
+
+inline TaskScheduler::TaskScheduler(unsigned workersCount) {
+    workersCount = std::max(1u, workersCount);
+    for (unsigned i = 0; i < workersCount; ++i)
+        workers.push_back(std::make_unique<Worker>());
+
+    // Start the threads once every queue exists, as they steal from each other
+    for (unsigned i = 0; i < workersCount; ++i)
+        workers[i]->thread = std::thread(&TaskScheduler::workerLoop, this, static_cast<int>(i));
+}
+
+inline TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+
+    for (auto& worker : workers)
+        worker->thread.join();
+}
+
+/*endregion*/
+
+/*region Public Methods */
+
+template<typename First, typename Second>
+void TaskScheduler::parallelInvoke(First&& first, Second&& second) {
+    // second may be stolen, it lives on this frame until join() returns
+    Task task;
+    task.function = [&second]() { second(); };
+    push(&task);
+
+    std::exception_ptr firstException;
+    try {
+        first();
+    } catch (...) {
+        firstException = std::current_exception();
+    }
+
+    // If nobody stole second yet, run it here, otherwise help until the thief is done
+    if (popLocal(&task)) task.run();
+    else join(task);
+
+    if (firstException) std::rethrow_exception(firstException);
+    if (task.exception) std::rethrow_exception(task.exception);
+}
+
+template<typename Index, typename Body>
+void TaskScheduler::parallelFor(Index begin, Index end, Body&& body, Index grain) {
+    if (begin >= end) return;
+
+    if (grain <= 0) {
+        Index chunks = static_cast<Index>(8 * workersCount());
+        grain = std::max<Index>(1, (end - begin) / chunks);
+    }
+    parallelForRange(begin, end, body, grain);
+}
+
+template<typename Index, typename Body>
+void TaskScheduler::parallelForRange(Index begin, Index end, Body& body, Index grain) {
+    if (end - begin <= grain) {
+        for (Index i = begin; i < end; ++i) body(i);
+        return;
+    }
+
+    Index middle = begin + (end - begin) / 2;
+    parallelInvoke([&]() { parallelForRange(begin, middle, body, grain); },
+                   [&]() { parallelForRange(middle, end, body, grain); });
+}
+
+/*endregion*/
+
+/*region Private Methods */
+
+inline TaskScheduler::TaskQueue& TaskScheduler::localQueue() {
+    if (currentScheduler == this) return workers[currentWorker]->queue;
+    return submitted;
+}
+
+inline void TaskScheduler::push(Task* task) {
+    auto& queue = localQueue();
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+    }
+    // Sequentially consistent with the sleeping worker's side: either the worker sees
+    // the task before waiting, or this thread sees the worker sleeping and wakes it up
+    queuedCount.fetch_add(1);
+    if (sleepingCount.load() == 0) return;
+
+    // Taking the lock orders the notification after the worker started waiting
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wakeUp.notify_one();
+}
+
+inline bool TaskScheduler::popLocal(Task* task) {
+    auto& queue = localQueue();
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    // Tasks forked later were joined already, so task is at the back unless it was stolen
+    if (queue.tasks.empty() || queue.tasks.back() != task) return false;
+
+    queue.tasks.pop_back();
+    queuedCount.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+inline TaskScheduler::Task* TaskScheduler::findTask() {
+    if (queuedCount.load(std::memory_order_acquire) == 0) return nullptr;
+
+    // Newest task of the own queue first
+    auto& own = localQueue();
+    {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            Task* task = own.tasks.back();
+            own.tasks.pop_back();
+            queuedCount.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    // Then steal the oldest task of another queue, starting after the own one to spread the thieves
+    int queuesCount = static_cast<int>(workers.size()) + 1;
+    int start = currentScheduler == this ? currentWorker + 1 : 0;
+    for (int i = 0; i < queuesCount; ++i) {
+        int index = (start + i) % queuesCount;
+        auto& victim = index < static_cast<int>(workers.size()) ? workers[index]->queue : submitted;
+        if (&victim == &own) continue;
+
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            Task* task = victim.tasks.front();
+            victim.tasks.pop_front();
+            queuedCount.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+inline void TaskScheduler::join(Task& task) {
+    while (!task.done.load(std::memory_order_acquire)) {
+        if (Task* other = findTask()) other->run();
+        else std::this_thread::yield();
+    }
+}
+
+inline void TaskScheduler::workerLoop(int index) {
+    currentScheduler = this;
+    currentWorker = index;
+
+    while (true) {
+        if (Task* task = findTask()) {
+            task->run();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingCount++;
+        wakeUp.wait(lock, [this]() { return stopping || queuedCount.load() > 0; });
+        sleepingCount--;
+        if (stopping) return;
+    }
+}
+
+/*endregion*/
+
+#endif //DSA_TASKSCHEDULER_H
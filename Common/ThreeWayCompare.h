@@ -0,0 +1,65 @@
+/**
+ * @file ThreeWayCompare.h
+ * @brief Three-way comparison of two keys through a Compare policy, using as few comparisons as possible.
+ *
+ * Ordered containers need to know whether a key is less than, greater than or equivalent to a node's key.
+ * With only a "less" predicate that takes up to two calls per node: compare(a, b), then compare(b, a).
+ * threeWayCompare() takes a single comparison whenever the language allows it:
+ *  - If the Compare policy itself is three-way (returns an ordering, e.g. std::compare_three_way).
+ *  - If the Compare policy is std::less and the key type has operator<=>, which is then used directly.
+ * Otherwise (C++17, or a custom "less" predicate) it falls back to the two calls.
+ *
+ * Every comparator call is reported to the Instrumentation policy (see Instrumentation.h).
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_THREEWAYCOMPARE_H
+#define DSA_THREEWAYCOMPARE_H
+
+#include <functional>
+#include <type_traits>
+
+#if defined(__cpp_impl_three_way_comparison) && defined(__cpp_lib_three_way_comparison)
+#include <compare>
+#include <concepts>
+#define DSA_HAS_THREE_WAY_COMPARISON 1
+#endif
+
+/**
+ * @brief Compares two keys with a Compare policy.
+ *
+ * @param compare The comparator, either a "less" predicate returning bool or a three-way comparator.
+ * @param first The first key.
+ * @param second The second key.
+ * @return A negative value if first comes before second, a positive value if it comes after it,
+ *         and zero if they are equivalent.
+ */
+template<typename Instrumentation, typename Compare, typename T>
+int threeWayCompare(const Compare& compare, const T& first, const T& second) {
+#ifdef DSA_HAS_THREE_WAY_COMPARISON
+    if constexpr (!std::is_same_v<std::invoke_result_t<const Compare&, const T&, const T&>, bool>) {
+        // Three-way comparator
+        Instrumentation::onCompare();
+        auto order = compare(first, second);
+        return order < 0 ? -1 : (order > 0 ? 1 : 0);
+    }
+    else if constexpr ((std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>)
+                       && std::three_way_comparable<T>) {
+        // std::less orders by operator<, which agrees with operator<=>
+        Instrumentation::onCompare();
+        auto order = first <=> second;
+        return order < 0 ? -1 : (order > 0 ? 1 : 0);
+    }
+    else
+#endif
+    {
+        Instrumentation::onCompare();
+        if(compare(first, second)) return -1;
+
+        Instrumentation::onCompare();
+        return compare(second, first) ? 1 : 0;
+    }
+}
+
+#endif //DSA_THREEWAYCOMPARE_H
@@ -0,0 +1,214 @@
+/**
+ * @file TimingWheel.h
+ * @brief Hierarchical timing wheel, tracking the expiry time of intrusively linked timers.
+ *
+ * A timer is a TimerHook embedded in the object to expire (a hash table node, for example), so
+ * scheduling and cancelling it allocate nothing and take O(1).
+ *
+ * Time is counted in integer ticks. The wheel has 11 levels of 64 slots: a timer is placed at the
+ * level of the highest 6 bit digit its expiry time differs from the current time in, and in the slot
+ * of its expiry's digit there. When the current time reaches a slot of a level above the first, the
+ * slot's timers are moved down to lower levels; when it reaches a slot of the first level, the slot's
+ * timers expire. Each level keeps a bitmask of its occupied slots, so advance() jumps straight to the
+ * next occupied slot: its work is proportional to the expired timers and the timers moved down (at
+ * most 10 times each), whatever the number of ticks elapsed.
+ *
+ * Usage example:
+ * --------------
+ * struct Session : TimerHook { std::string user; };
+ * TimingWheel wheel(now);
+ * wheel.schedule(&session, now + 30000);
+ * wheel.advance(later, [](TimerHook* hook) { closeSession(static_cast<Session*>(hook)); });
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_TIMINGWHEEL_H
+#define DSA_TIMINGWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Links an object into a TimingWheel, the object inherits from it.
+ */
+struct TimerHook {
+    static constexpr std::uint64_t NEVER = std::numeric_limits<std::uint64_t>::max();
+
+    std::uint64_t expiry = NEVER;   // Tick the timer expires at, kept when it is cancelled
+    TimerHook* prev = nullptr;
+    TimerHook* next = nullptr;
+    std::uint32_t slot = UNSCHEDULED;
+
+    /**
+     * @return true if the timer is in a wheel.
+     */
+    [[nodiscard]] bool scheduled() const { return slot != UNSCHEDULED; }
+
+private:
+    friend class TimingWheel;
+    static constexpr std::uint32_t UNSCHEDULED = std::numeric_limits<std::uint32_t>::max();
+};
+
+class TimingWheel {
+public:
+    /**
+     * @param now The current tick.
+     */
+    explicit TimingWheel(std::uint64_t now = 0) : current(now) {}
+
+    TimingWheel(const TimingWheel& other) = delete;
+    TimingWheel& operator=(const TimingWheel& other) = delete;
+
+    /**
+     * @brief Schedules a timer, which must not be scheduled already.
+     *
+     * @param hook The timer.
+     * @param expiry The tick the timer expires at, a past tick makes it expire on the next advance().
+     */
+    void schedule(TimerHook* hook, std::uint64_t expiry) {
+        hook->expiry = expiry;
+        place(hook);
+        count++;
+    }
+
+    /**
+     * @brief Removes a timer from the wheel, nothing happens if it isn't scheduled.
+     */
+    void cancel(TimerHook* hook) {
+        if (!hook->scheduled()) return;
+        unlink(hook);
+        count--;
+    }
+
+    /**
+     * @brief Moves the current time forward, expiring the timers due by then.
+     *
+     * @param now The new current tick, nothing happens if it is before the current one.
+     * @param onExpired Called with each expired timer, already removed from the wheel. It may
+     * schedule and cancel timers, other than through advance().
+     */
+    template<typename OnExpired>
+    void advance(std::uint64_t now, OnExpired onExpired) {
+        if (now < current) return;
+
+        std::uint64_t event;
+        int level, slot;
+        while (nextEvent(event, level, slot) && event <= now) {
+            current = event;
+
+            // The slot's timers either expire now, or are due later and move to a lower level
+            TimerHook*& head = slots[level * SLOTS + slot];
+            while (head) {
+                TimerHook* hook = head;
+                unlink(hook);
+                if (hook->expiry <= current) {
+                    count--;
+                    onExpired(hook);
+                } else {
+                    place(hook);
+                }
+            }
+        }
+        current = now;
+    }
+
+    /**
+     * @return the current tick.
+     */
+    [[nodiscard]] std::uint64_t now() const { return current; }
+
+    /**
+     * @return number of scheduled timers.
+     */
+    [[nodiscard]] std::size_t size() const { return count; }
+
+private:
+    static constexpr int BITS = 6;
+    static constexpr int SLOTS = 1 << BITS;
+    static constexpr int LEVELS = (64 + BITS - 1) / BITS;
+
+    std::uint64_t current;
+    std::size_t count = 0;
+    std::uint64_t occupied[LEVELS] = {};                 // Bit i of level l is set if slot i of level l isn't empty
+    TimerHook* slots[LEVELS * SLOTS] = {};
+
+    static int highestBit(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(word);
+#else
+        int bit = 0;
+        while (word >>= 1) bit++;
+        return bit;
+#endif
+    }
+
+    static int lowestBit(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int bit = 0;
+        while (!(word & 1)) { word >>= 1; bit++; }
+        return bit;
+#endif
+    }
+
+    /**
+     * @brief Links a timer into the slot of its expiry, relative to the current time.
+     */
+    void place(TimerHook* hook) {
+        auto expiry = hook->expiry < current ? current : hook->expiry;
+        auto differentBits = expiry ^ current;
+        int level = differentBits ? highestBit(differentBits) / BITS : 0;
+        int slot = static_cast<int>((expiry >> (level * BITS)) & (SLOTS - 1));
+
+        hook->slot = static_cast<std::uint32_t>(level * SLOTS + slot);
+        hook->prev = nullptr;
+        hook->next = slots[hook->slot];
+        if (hook->next) hook->next->prev = hook;
+        slots[hook->slot] = hook;
+        occupied[level] |= std::uint64_t(1) << slot;
+    }
+
+    void unlink(TimerHook* hook) {
+        if (hook->prev) hook->prev->next = hook->next;
+        else slots[hook->slot] = hook->next;
+        if (hook->next) hook->next->prev = hook->prev;
+
+        if (!slots[hook->slot])
+            occupied[hook->slot / SLOTS] &= ~(std::uint64_t(1) << (hook->slot % SLOTS));
+        hook->prev = hook->next = nullptr;
+        hook->slot = TimerHook::UNSCHEDULED;
+    }
+
+    /**
+     * @brief Finds the earliest tick a slot must be processed at.
+     *
+     * A timer of level l expires after the current time's digit l, so the occupied slots from the next
+     * digit on are the candidates (and the current digit on the first level). A lower level's slots are
+     * all processed before a higher level's, so the first level having a candidate holds the earliest.
+     *
+     * @return false if the wheel is empty.
+     */
+    bool nextEvent(std::uint64_t& event, int& level, int& slot) const {
+        for (level = 0; level < LEVELS; ++level) {
+            int shift = level * BITS;
+            int digit = static_cast<int>((current >> shift) & (SLOTS - 1));
+            int firstCandidate = level == 0 ? digit : digit + 1;
+            if (firstCandidate == SLOTS) continue;
+
+            auto candidates = occupied[level] & (~std::uint64_t(0) << firstCandidate);
+            if (!candidates) continue;
+
+            slot = lowestBit(candidates);
+            int higherShift = shift + BITS;
+            std::uint64_t higherDigits = higherShift >= 64 ? 0 : current >> higherShift << higherShift;
+            event = higherDigits | (static_cast<std::uint64_t>(slot) << shift);
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif //DSA_TIMINGWHEEL_H
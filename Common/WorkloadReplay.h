@@ -0,0 +1,633 @@
+/**
+ * @file WorkloadReplay.h
+ * @brief Replays a recorded trace of operations against a container, measuring throughput and latencies.
+ *
+ * A trace is a sequence of operations (insert, get, remove, extractMin, prefix), each with the
+ * timestamp it was recorded at. Traces are read from either format:
+ *  - CSV, one operation per line: `timestamp,operation,key[,value]`, e.g. `1500,insert,apple,3`.
+ *    The timestamp is in nanoseconds, empty lines and lines starting with '#' are skipped.
+ *    Keys and values can't contain commas.
+ *  - Binary (written by writeBinaryTrace()): the magic "DSATRACE", the operations count,
+ *    then per operation its timestamp, type, key length, value length, key and value bytes.
+ * makeZipfianTrace() generates synthetic cache workloads.
+ *
+ * replayTrace() converts the trace to the container's key and value types up front, then runs
+ * the operations either back to back or at the rate they were recorded. Each operation's latency
+ * goes to a LatencyHistogram of its type. When paced, latencies are measured from the time the
+ * operation was due rather than the time it started, so a slow operation delaying the next ones
+ * shows in their latencies instead of being hidden.
+ *
+ * Operations are timed with CycleClock (calibrated time stamp counter reads). The slowest operations
+ * are kept along with the Instrumentation events (see Instrumentation.h) counted while they ran, so a
+ * latency spike can be traced back to a rehash, rotations or a large allocation. Events are only
+ * counted for containers instantiated with CountingInstrumentation.
+ *
+ * ReplayAdapter tells replayTrace() how to run each operation type on a container. It is specialized
+ * for the containers of this repository; operations a container doesn't support are counted as skipped.
+ *
+ * Usage example:
+ * --------------
+ * auto trace = readTrace("production.trace");
+ * HashTable<std::string, std::string> table;
+ * auto report = replayTrace(table, trace);
+ * printReplayReport(std::cout, report);
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_WORKLOADREPLAY_H
+#define DSA_WORKLOADREPLAY_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "CycleClock.h"
+#include "Instrumentation.h"
+#include "LatencyHistogram.h"
+#include "../Hashing/CacheTable.h"
+#include "../Hashing/CuckooHashTable.h"
+#include "../Hashing/HashTable.h"
+#include "../Heaps/BinaryMinHeap.h"
+#include "../Heaps/BinomialMinHeap.h"
+#include "../Heaps/LeftistMinHeap.h"
+#include "../Trees/AVLTree.h"
+#include "../Trees/BinarySearchTree.h"
+#include "../Tries/Trie.h"
+
+/*region Trace */
+
+enum class TraceOperationType : std::uint8_t { Insert, Get, Remove, ExtractMin, Prefix };
+
+constexpr int TRACE_OPERATION_TYPES = 5;
+
+inline const char* traceOperationName(TraceOperationType type) {
+    static const char* const names[TRACE_OPERATION_TYPES] = {"insert", "get", "remove", "extractMin", "prefix"};
+    return names[static_cast<int>(type)];
+}
+
+/**
+ * @brief A recorded operation, with its key and value as they appear in the trace.
+ */
+struct TraceOperation {
+    TraceOperationType type = TraceOperationType::Get;
+    std::uint64_t timestamp = 0; // nanoseconds, only relative timestamps matter
+    std::string key;
+    std::string value;
+};
+
+using Trace = std::vector<TraceOperation>;
+
+/**
+ * @brief Reads a CSV trace.
+ * @throws std::runtime_error If the file can't be read or has an invalid line.
+ */
+inline Trace readCsvTrace(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("Couldn't open trace " + path);
+
+    Trace trace;
+    std::string line;
+    for (int lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        for (std::string field; std::getline(stream, field, ',');)
+            fields.push_back(field);
+
+        auto invalidLine = [&]() {
+            return std::runtime_error("Invalid line " + std::to_string(lineNumber) + " in trace " + path);
+        };
+        if (fields.size() < 2 || fields.size() > 4) throw invalidLine();
+
+        TraceOperation operation;
+        try {
+            operation.timestamp = std::stoull(fields[0]);
+        } catch (const std::exception&) {
+            throw invalidLine();
+        }
+
+        bool known = false;
+        for (int type = 0; type < TRACE_OPERATION_TYPES; ++type) {
+            if (fields[1] == traceOperationName(static_cast<TraceOperationType>(type))) {
+                operation.type = static_cast<TraceOperationType>(type);
+                known = true;
+            }
+        }
+        if (!known) throw invalidLine();
+
+        if (fields.size() > 2) operation.key = fields[2];
+        if (fields.size() > 3) operation.value = fields[3];
+        trace.push_back(std::move(operation));
+    }
+    return trace;
+}
+
+namespace TraceFormat {
+    constexpr char MAGIC[8] = {'D', 'S', 'A', 'T', 'R', 'A', 'C', 'E'};
+
+    template<typename T>
+    void write(std::ostream& stream, const T& value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template<typename T>
+    T read(std::istream& stream) {
+        T value{};
+        if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+            throw std::runtime_error("Truncated trace.");
+        return value;
+    }
+}
+
+/**
+ * @brief Writes a trace in the binary format, which is faster to read than CSV for large traces.
+ * @throws std::runtime_error If the file can't be written.
+ */
+inline void writeBinaryTrace(const std::string& path, const Trace& trace) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) throw std::runtime_error("Couldn't write trace to " + path);
+
+    file.write(TraceFormat::MAGIC, sizeof(TraceFormat::MAGIC));
+    TraceFormat::write<std::uint64_t>(file, trace.size());
+    for (const auto& operation : trace) {
+        TraceFormat::write<std::uint64_t>(file, operation.timestamp);
+        TraceFormat::write<std::uint8_t>(file, static_cast<std::uint8_t>(operation.type));
+        TraceFormat::write<std::uint32_t>(file, operation.key.size());
+        TraceFormat::write<std::uint32_t>(file, operation.value.size());
+        file.write(operation.key.data(), operation.key.size());
+        file.write(operation.value.data(), operation.value.size());
+    }
+    if (!file) throw std::runtime_error("Couldn't write trace to " + path);
+}
+
+/**
+ * @brief Reads a binary trace.
+ * @throws std::runtime_error If the file can't be read or isn't a valid trace.
+ */
+inline Trace readBinaryTrace(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("Couldn't open trace " + path);
+
+    char magic[sizeof(TraceFormat::MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    if (!file || std::memcmp(magic, TraceFormat::MAGIC, sizeof(magic)) != 0)
+        throw std::runtime_error("Invalid trace " + path);
+
+    // The lengths are checked against the bytes left before allocating, a corrupt one can't ask for 4 GiB
+    file.seekg(0, std::ios::end);
+    auto fileSize = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(sizeof(magic));
+
+    auto count = TraceFormat::read<std::uint64_t>(file);
+    Trace trace;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        TraceOperation operation;
+        operation.timestamp = TraceFormat::read<std::uint64_t>(file);
+        auto type = TraceFormat::read<std::uint8_t>(file);
+        if (type >= TRACE_OPERATION_TYPES) throw std::runtime_error("Invalid trace " + path);
+        operation.type = static_cast<TraceOperationType>(type);
+
+        auto keyLength = TraceFormat::read<std::uint32_t>(file);
+        auto valueLength = TraceFormat::read<std::uint32_t>(file);
+        if (static_cast<std::uint64_t>(keyLength) + valueLength > fileSize - static_cast<std::uint64_t>(file.tellg()))
+            throw std::runtime_error("Truncated trace " + path);
+        operation.key.resize(keyLength);
+        operation.value.resize(valueLength);
+        file.read(operation.key.data(), operation.key.size());
+        file.read(operation.value.data(), operation.value.size());
+        if (!file) throw std::runtime_error("Truncated trace " + path);
+
+        trace.push_back(std::move(operation));
+    }
+    return trace;
+}
+
+/**
+ * @brief Reads a trace in either format, telling them apart by the binary format's magic.
+ */
+inline Trace readTrace(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("Couldn't open trace " + path);
+
+    char magic[sizeof(TraceFormat::MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    bool isBinary = file && std::memcmp(magic, TraceFormat::MAGIC, sizeof(magic)) == 0;
+    return isBinary ? readBinaryTrace(path) : readCsvTrace(path);
+}
+
+/**
+ * @brief Generates a trace of gets of keys drawn from a Zipfian distribution, the usual model of cache workloads.
+ *
+ * Key i (named "key<i>", i from 0) is drawn with a probability proportional to 1 / (i + 1)^skew.
+ * Operations are 1 microsecond apart.
+ *
+ * @param operations Number of operations.
+ * @param keysCount Number of distinct keys.
+ * @param skew Higher values concentrate the gets on fewer keys, 0.99 is typical of web caches.
+ * @param seed Seed of the random generator, the same seed gives the same trace.
+ */
+inline Trace makeZipfianTrace(std::size_t operations, std::size_t keysCount, double skew = 0.99,
+                              std::uint64_t seed = 1) {
+    if (keysCount == 0) throw std::invalid_argument("A Zipfian trace needs at least one key.");
+
+    // Cumulative distribution, sampled by binary search
+    std::vector<double> cumulative(keysCount);
+    double total = 0;
+    for (std::size_t i = 0; i < keysCount; ++i) {
+        total += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+        cumulative[i] = total;
+    }
+
+    std::mt19937_64 generator(seed);
+    std::uniform_real_distribution<double> uniform(0, total);
+
+    Trace trace(operations);
+    for (std::size_t i = 0; i < operations; ++i) {
+        auto rank = std::lower_bound(cumulative.begin(), cumulative.end(), uniform(generator)) - cumulative.begin();
+        rank = std::min<std::ptrdiff_t>(rank, static_cast<std::ptrdiff_t>(keysCount) - 1);
+
+        trace[i].type = TraceOperationType::Get;
+        trace[i].timestamp = i * 1000;
+        trace[i].key = "key" + std::to_string(rank);
+        trace[i].value = "value" + std::to_string(rank);
+    }
+    return trace;
+}
+
+/**
+ * @brief Converts a key or value of the trace to the container's type.
+ * @throws std::invalid_argument If the field isn't a valid T.
+ */
+template<typename T>
+T parseTraceField(const std::string& field) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return field;
+    } else {
+        T value{};
+        std::istringstream stream(field);
+        if (!(stream >> value)) throw std::invalid_argument("Invalid trace field: " + field);
+        return value;
+    }
+}
+
+/*endregion*/
+
+/*region Adapters */
+
+/**
+ * @brief A trace operation converted to a container's key and value types.
+ */
+template<typename Key, typename Value>
+struct ReplayOperation {
+    TraceOperationType type;
+    std::uint64_t timestamp;
+    Key key;
+    Value value;
+};
+
+enum class ReplayOutcome { Hit, Miss, Unsupported };
+
+/**
+ * @brief How a trace is replayed against a Container.
+ *
+ * A specialization declares the Key and Value types trace fields are converted to,
+ * and `static ReplayOutcome apply(Container&, const ReplayOperation<Key, Value>&)`.
+ */
+template<typename Container>
+struct ReplayAdapter;
+
+/**
+ * @brief Shared adapter of the hash tables.
+ */
+template<typename Table, typename K, typename V>
+struct HashTableReplayAdapter {
+    using Key = K;
+    using Value = V;
+
+    static ReplayOutcome apply(Table& table, const ReplayOperation<Key, Value>& operation) {
+        switch (operation.type) {
+            case TraceOperationType::Insert:
+                table.insert(operation.key, operation.value);
+                return ReplayOutcome::Hit;
+            case TraceOperationType::Get:
+                return table.contains(operation.key) ? ReplayOutcome::Hit : ReplayOutcome::Miss;
+            case TraceOperationType::Remove:
+                table.remove(operation.key);
+                return ReplayOutcome::Hit;
+            default:
+                return ReplayOutcome::Unsupported;
+        }
+    }
+};
+
+template<typename K, typename V, typename Instrumentation, bool Expiring>
+struct ReplayAdapter<HashTable<K, V, Instrumentation, Expiring>>
+        : HashTableReplayAdapter<HashTable<K, V, Instrumentation, Expiring>, K, V> {};
+
+template<typename K, typename V, typename Instrumentation, bool OptimisticReads>
+struct ReplayAdapter<CuckooHashTable<K, V, Instrumentation, OptimisticReads>>
+        : HashTableReplayAdapter<CuckooHashTable<K, V, Instrumentation, OptimisticReads>, K, V> {};
+
+/**
+ * @brief Adapter of the cache, used read through: a get that misses inserts the trace value,
+ * as the caller would after fetching it, so the get hits and misses are the cache's hit ratio.
+ */
+template<typename K, typename V, typename Instrumentation>
+struct ReplayAdapter<CacheTable<K, V, Instrumentation>> {
+    using Key = K;
+    using Value = V;
+
+    static ReplayOutcome apply(CacheTable<K, V, Instrumentation>& cache, const ReplayOperation<Key, Value>& operation) {
+        switch (operation.type) {
+            case TraceOperationType::Insert:
+                cache.insert(operation.key, operation.value);
+                return ReplayOutcome::Hit;
+            case TraceOperationType::Get:
+                if (cache.find(operation.key)) return ReplayOutcome::Hit;
+                cache.insert(operation.key, operation.value);
+                return ReplayOutcome::Miss;
+            case TraceOperationType::Remove:
+                cache.remove(operation.key);
+                return ReplayOutcome::Hit;
+            default:
+                return ReplayOutcome::Unsupported;
+        }
+    }
+};
+
+/**
+ * @brief Shared adapter of the search trees, trace values are ignored.
+ */
+template<typename Tree, typename Comparable>
+struct TreeReplayAdapter {
+    using Key = Comparable;
+    using Value = std::string;
+
+    static ReplayOutcome apply(Tree& tree, const ReplayOperation<Key, Value>& operation) {
+        switch (operation.type) {
+            case TraceOperationType::Insert:
+                tree.insert(operation.key);
+                return ReplayOutcome::Hit;
+            case TraceOperationType::Get:
+                return tree.contains(operation.key) ? ReplayOutcome::Hit : ReplayOutcome::Miss;
+            case TraceOperationType::Remove:
+                tree.remove(operation.key);
+                return ReplayOutcome::Hit;
+            default:
+                return ReplayOutcome::Unsupported;
+        }
+    }
+};
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+struct ReplayAdapter<AVLTree<Comparable, Compare, Instrumentation>>
+        : TreeReplayAdapter<AVLTree<Comparable, Compare, Instrumentation>, Comparable> {};
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+struct ReplayAdapter<BinarySearchTree<Comparable, Compare, Instrumentation>>
+        : TreeReplayAdapter<BinarySearchTree<Comparable, Compare, Instrumentation>, Comparable> {};
+
+/**
+ * @brief Shared adapter of the min heaps, trace values are ignored.
+ */
+template<typename Heap, typename Comparable>
+struct HeapReplayAdapter {
+    using Key = Comparable;
+    using Value = std::string;
+
+    static ReplayOutcome apply(Heap& heap, const ReplayOperation<Key, Value>& operation) {
+        switch (operation.type) {
+            case TraceOperationType::Insert:
+                heap.insert(operation.key);
+                return ReplayOutcome::Hit;
+            case TraceOperationType::ExtractMin:
+                if (heap.isEmpty()) return ReplayOutcome::Miss;
+                heap.extractMin();
+                return ReplayOutcome::Hit;
+            default:
+                return ReplayOutcome::Unsupported;
+        }
+    }
+};
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+struct ReplayAdapter<BinaryMinHeap<Comparable, Compare, Instrumentation>>
+        : HeapReplayAdapter<BinaryMinHeap<Comparable, Compare, Instrumentation>, Comparable> {};
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+struct ReplayAdapter<BinomialMinHeap<Comparable, Compare, Instrumentation>>
+        : HeapReplayAdapter<BinomialMinHeap<Comparable, Compare, Instrumentation>, Comparable> {};
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+struct ReplayAdapter<LeftistMinHeap<Comparable, Compare, Instrumentation>>
+        : HeapReplayAdapter<LeftistMinHeap<Comparable, Compare, Instrumentation>, Comparable> {};
+
+template<>
+struct ReplayAdapter<Trie> {
+    using Key = std::string;
+    using Value = std::string;
+
+    static ReplayOutcome apply(Trie& trie, const ReplayOperation<Key, Value>& operation) {
+        switch (operation.type) {
+            case TraceOperationType::Insert:
+                trie.insert(operation.key);
+                return ReplayOutcome::Hit;
+            case TraceOperationType::Get:
+                return trie.contains(operation.key) ? ReplayOutcome::Hit : ReplayOutcome::Miss;
+            case TraceOperationType::Remove:
+                trie.remove(operation.key);
+                return ReplayOutcome::Hit;
+            case TraceOperationType::Prefix:
+                return trie.getWords(operation.key).empty() ? ReplayOutcome::Miss : ReplayOutcome::Hit;
+            default:
+                return ReplayOutcome::Unsupported;
+        }
+    }
+};
+
+/*endregion*/
+
+/*region Replay */
+
+enum class ReplayPacing { FullSpeed, RecordedRate };
+
+/**
+ * @brief Results of the operations of a single type.
+ */
+struct OperationReport {
+    std::uint64_t operations = 0; // replayed operations, skipped ones excluded
+    std::uint64_t hits = 0;       // operations that found their key (or element)
+    std::uint64_t skipped = 0;    // operations the container doesn't support
+    LatencyHistogram latency;     // nanoseconds
+};
+
+/**
+ * @brief One of the slowest operations of a replay.
+ */
+struct ReplayOutlier {
+    std::size_t index = 0;             // position of the operation in the trace
+    TraceOperationType type = TraceOperationType::Get;
+    std::uint64_t latency = 0;         // nanoseconds
+    InstrumentationCounters events;    // counted while the operation ran
+
+    /**
+     * @return true if the container restructured itself during the operation (rehash or rebalancing).
+     */
+    [[nodiscard]] bool isStructural() const { return events.rehashes > 0 || events.rotations > 0; }
+};
+
+struct ReplayReport {
+    // Number of slowest operations kept in outliers
+    static constexpr int OUTLIERS_COUNT = 16;
+
+    std::array<OperationReport, TRACE_OPERATION_TYPES> operations;
+    std::vector<ReplayOutlier> outliers; // slowest first
+    std::uint64_t elapsed = 0; // nanoseconds
+
+    OperationReport& operator[](TraceOperationType type) { return operations[static_cast<int>(type)]; }
+    const OperationReport& operator[](TraceOperationType type) const { return operations[static_cast<int>(type)]; }
+
+    /**
+     * @return replayed operations per second.
+     */
+    [[nodiscard]] double throughput() const {
+        std::uint64_t total = 0;
+        for (const auto& report : operations) total += report.operations;
+        return elapsed ? total * 1e9 / elapsed : 0;
+    }
+};
+
+/**
+ * @brief Replays a trace against a container.
+ *
+ * @param container The container to run the operations on.
+ * @param trace The recorded operations, in order.
+ * @param pacing FullSpeed runs the operations back to back, RecordedRate keeps the recorded gaps between them
+ *        (an operation recorded before the first one runs right away).
+ * @return per operation type counts and latency histograms, and the total elapsed time.
+ * @throws std::invalid_argument If a key or value can't be converted to the container's types.
+ */
+template<typename Container, typename Adapter = ReplayAdapter<Container>>
+ReplayReport replayTrace(Container& container, const Trace& trace, ReplayPacing pacing = ReplayPacing::FullSpeed) {
+    using Key = typename Adapter::Key;
+    using Value = typename Adapter::Value;
+    using Clock = std::chrono::steady_clock;
+
+    // Convert every field before replaying, so parsing isn't measured
+    std::vector<ReplayOperation<Key, Value>> operations;
+    operations.reserve(trace.size());
+    for (const auto& operation : trace) {
+        operations.push_back({operation.type, operation.timestamp,
+                              operation.key.empty() ? Key{} : parseTraceField<Key>(operation.key),
+                              operation.value.empty() ? Value{} : parseTraceField<Value>(operation.value)});
+    }
+
+    ReplayReport report;
+    if (operations.empty()) return report;
+
+    // Slowest operations so far, the fastest of them on top
+    struct FasterOutlier {
+        bool operator()(const ReplayOutlier& first, const ReplayOutlier& second) const {
+            return first.latency < second.latency;
+        }
+    };
+    BinaryMinHeap<ReplayOutlier, FasterOutlier> slowest;
+
+    auto firstTimestamp = operations.front().timestamp;
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        const auto& operation = operations[i];
+
+        // Time the operation spent waiting behind previous ones when paced
+        std::uint64_t lateness = 0;
+        if (pacing == ReplayPacing::RecordedRate) {
+            // An operation recorded before the first one is due right away, not 2^64 ns later
+            auto offset = operation.timestamp > firstTimestamp ? operation.timestamp - firstTimestamp : 0;
+            auto due = start + std::chrono::nanoseconds(offset);
+            auto now = Clock::now();
+            if (due > now) std::this_thread::sleep_until(due);
+            else lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(now - due).count();
+        }
+
+        auto eventsBefore = CountingInstrumentation::counters();
+        auto startTicks = CycleClock::now();
+        auto outcome = Adapter::apply(container, operation);
+        auto endTicks = CycleClock::now();
+
+        auto& operationReport = report[operation.type];
+        if (outcome == ReplayOutcome::Unsupported) {
+            operationReport.skipped++;
+            continue;
+        }
+        operationReport.operations++;
+        if (outcome == ReplayOutcome::Hit) operationReport.hits++;
+
+        auto latency = lateness + CycleClock::toNanoseconds(endTicks - startTicks);
+        operationReport.latency.record(latency);
+
+        if (slowest.size() < ReplayReport::OUTLIERS_COUNT || latency > slowest.getMin().latency) {
+            if (slowest.size() == ReplayReport::OUTLIERS_COUNT) slowest.removeMin();
+            slowest.insert(ReplayOutlier{i, operation.type, latency, CountingInstrumentation::counters() - eventsBefore});
+        }
+    }
+    report.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+    report.outliers.resize(slowest.size());
+    for (auto outlier = report.outliers.rbegin(); outlier != report.outliers.rend(); ++outlier)
+        *outlier = slowest.extractMin();
+
+    return report;
+}
+
+/**
+ * @brief Prints the throughput, a line of latency percentiles (in nanoseconds) per operation type
+ * and the slowest operations, flagging those that coincided with a rehash or rebalancing.
+ */
+inline void printReplayReport(std::ostream& out, const ReplayReport& report) {
+    out << "throughput: " << std::fixed << std::setprecision(0) << report.throughput() << " ops/s\n";
+    out << std::left << std::setw(12) << "operation" << std::right
+        << std::setw(12) << "count" << std::setw(12) << "hits" << std::setw(10) << "skipped"
+        << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p99"
+        << std::setw(10) << "p99.9" << std::setw(12) << "max" << '\n';
+
+    for (int type = 0; type < TRACE_OPERATION_TYPES; ++type) {
+        const auto& operationReport = report.operations[type];
+        if (operationReport.operations == 0 && operationReport.skipped == 0) continue;
+
+        const auto& latency = operationReport.latency;
+        out << std::left << std::setw(12) << traceOperationName(static_cast<TraceOperationType>(type)) << std::right
+            << std::setw(12) << operationReport.operations << std::setw(12) << operationReport.hits
+            << std::setw(10) << operationReport.skipped << std::setw(10) << latency.mean()
+            << std::setw(10) << latency.percentile(50) << std::setw(10) << latency.percentile(99)
+            << std::setw(10) << latency.percentile(99.9) << std::setw(12) << latency.max() << '\n';
+    }
+
+    if (report.outliers.empty()) return;
+    out << "slowest operations:\n";
+    for (const auto& outlier : report.outliers) {
+        out << "  #" << outlier.index << ' ' << traceOperationName(outlier.type) << ' ' << outlier.latency << "ns"
+            << " (rehashes " << outlier.events.rehashes << ", rotations " << outlier.events.rotations
+            << ", allocations " << outlier.events.allocations << ", visits " << outlier.events.nodeVisits << ')'
+            << (outlier.isStructural() ? " STRUCTURAL" : "") << '\n';
+    }
+}
+
+/*endregion*/
+
+#endif //DSA_WORKLOADREPLAY_H
@@ -0,0 +1,160 @@
+/**
+ * @file BlockedBloomFilter.h
+ * @brief Declaration and implementation of the BlockedBloomFilter class, a compact approximate set of hashes.
+ *
+ * A Bloom filter answers "definitely absent" or "maybe present" using a few bits per key, so a
+ * lookup that would miss can be answered without touching the data itself (a bucket chain in cold
+ * memory, a page on disk).
+ *
+ * The filter is "split block": the bit array is made of 512 bit blocks, one cache line each, and a key
+ * sets one bit in each of the 8 words of a single block. A lookup is therefore one cache access whatever
+ * the number of bits, and the 8 bit tests are independent. With 10 bits per key about 1% of the absent
+ * keys are reported as maybe present.
+ *
+ * Bits can't be cleared, since a bit may be shared by several keys: removing a key leaves it reported
+ * as maybe present until the owner rebuilds the filter (HashTable does when it rehashes, or when
+ * removed keys become numerous).
+ *
+ * Keys are given as 64 bit hashes, mixed again by the filter, so std::hash values (often the identity)
+ * can be used as is. The filter can be saved and loaded, to keep it in memory for a table on disk.
+ *
+ * Usage example:
+ * --------------
+ * BlockedBloomFilter filter(1000000);
+ * filter.insert(std::hash<std::string>{}("apple"));
+ * if (filter.mayContain(std::hash<std::string>{}(key))) readFromDisk(key);
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_BLOCKEDBLOOMFILTER_H
+#define DSA_BLOCKEDBLOOMFILTER_H
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "SeededHash.h"
+
+class BlockedBloomFilter {
+public:
+    /**
+     * @brief Constructs an empty filter.
+     *
+     * @param expectedKeys Number of keys the filter is sized for, more keys raise the false positive rate.
+     * @param bitsPerKey Bits per expected key, 10 gives about 1% of false positives, 16 about 0.1%.
+     */
+    explicit BlockedBloomFilter(std::size_t expectedKeys = 0, int bitsPerKey = 10)
+            : blocks(blocksFor(expectedKeys, bitsPerKey)), bitsPerKey(bitsPerKey) {
+        if (bitsPerKey <= 0)
+            throw std::invalid_argument("A Bloom filter needs at least one bit per key.");
+    }
+
+    /**
+     * @brief Adds a key, given by its hash.
+     */
+    void insert(std::uint64_t hash) {
+        auto mixed = seededHash(hash, 0);
+        Block& block = blocks[blockIndex(mixed)];
+        for (int word = 0; word < WORDS; ++word)
+            block.words[word] |= bitOf(mixed, word);
+    }
+
+    /**
+     * @return false if the key was definitely never inserted, true if it may have been.
+     */
+    [[nodiscard]] bool mayContain(std::uint64_t hash) const {
+        auto mixed = seededHash(hash, 0);
+        const Block& block = blocks[blockIndex(mixed)];
+
+        // The 8 tests are combined without branching, a branch per word would mispredict often
+        std::uint64_t missing = 0;
+        for (int word = 0; word < WORDS; ++word)
+            missing |= bitOf(mixed, word) & ~block.words[word];
+        return missing == 0;
+    }
+
+    /**
+     * @brief Removes every key, keeping the size.
+     */
+    void clear() {
+        for (Block& block : blocks)
+            for (auto& word : block.words) word = 0;
+    }
+
+    /**
+     * @return size of the bit array, in bytes.
+     */
+    [[nodiscard]] std::size_t sizeInBytes() const { return blocks.size() * sizeof(Block); }
+
+    [[nodiscard]] int getBitsPerKey() const { return bitsPerKey; }
+
+    /**
+     * @brief Writes the filter to a binary stream.
+     */
+    void save(std::ostream& stream) const {
+        std::uint64_t header[2] = {static_cast<std::uint64_t>(bitsPerKey), blocks.size()};
+        stream.write(MAGIC, sizeof(MAGIC));
+        stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(blocks.data()), static_cast<std::streamsize>(sizeInBytes()));
+    }
+
+    /**
+     * @brief Reads a filter written by save().
+     * @throws std::runtime_error If the stream doesn't hold a valid filter.
+     */
+    static BlockedBloomFilter load(std::istream& stream) {
+        char magic[sizeof(MAGIC)] = {};
+        std::uint64_t header[2] = {};
+        if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+            || !stream.read(reinterpret_cast<char*>(header), sizeof(header))
+            || header[0] == 0 || header[0] > 64 || header[1] == 0)
+            throw std::runtime_error("Invalid Bloom filter.");
+
+        BlockedBloomFilter filter;
+        filter.bitsPerKey = static_cast<int>(header[0]);
+        // Read block by block, so a corrupted count fails instead of allocating
+        filter.blocks.clear();
+        for (std::uint64_t i = 0; i < header[1]; ++i) {
+            Block block;
+            if (!stream.read(reinterpret_cast<char*>(&block), sizeof(block)))
+                throw std::runtime_error("Invalid Bloom filter.");
+            filter.blocks.push_back(block);
+        }
+        return filter;
+    }
+
+private:
+    static constexpr int WORDS = 8;
+    static constexpr char MAGIC[8] = {'D', 'S', 'A', 'B', 'L', 'O', 'O', 'M'};
+
+    struct alignas(64) Block {
+        std::uint64_t words[WORDS] = {};
+    };
+
+    std::vector<Block> blocks;
+    int bitsPerKey;
+
+    static std::size_t blocksFor(std::size_t expectedKeys, int bitsPerKey) {
+        auto bits = expectedKeys * static_cast<std::size_t>(bitsPerKey > 0 ? bitsPerKey : 1);
+        return bits / (WORDS * 64) + 1;
+    }
+
+    std::size_t blockIndex(std::uint64_t mixed) const {
+        // The high half picks the block (with a multiplication rather than a division), the low half the bits
+        return static_cast<std::size_t>(((mixed >> 32) * blocks.size()) >> 32);
+    }
+
+    static std::uint64_t bitOf(std::uint64_t mixed, int word) {
+        // Odd constants spreading the low half differently for every word ("split block" Bloom filters)
+        static constexpr std::uint32_t SALTS[WORDS] = {0x47B6137Bu, 0x44974D91u, 0x8824AD5Bu, 0xA2B7289Du,
+                                                       0x705495C7u, 0x2DF1424Bu, 0x9EFC4947u, 0x5C6BFB31u};
+        auto product = static_cast<std::uint32_t>(mixed) * SALTS[word];
+        return std::uint64_t(1) << (product >> 26);
+    }
+};
+
+#endif //DSA_BLOCKEDBLOOMFILTER_H
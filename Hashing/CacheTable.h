@@ -0,0 +1,653 @@
+/**
+ * @file CacheTable.h
+ * @brief Declaration and implementation of CacheTable, a bounded hash table evicting with S3-FIFO,
+ * and of ShardedCacheTable, its concurrent version.
+ *
+ * A CacheTable is a HashTable (chained buckets, nodes from a std::pmr::memory_resource) holding at most
+ * a given capacity, counted in entries or in the weight of the entries (their size in bytes, for example).
+ * Every node is also in one of two FIFO queues, and inserting past the capacity evicts with S3-FIFO
+ * ("FIFO queues are all you need for cache eviction"):
+ *  - New keys go to the small queue, which holds about 10% of the capacity. Keys leaving it are
+ *    promoted to the main queue if they were hit meanwhile, and evicted otherwise. Keys used once
+ *    (a scan) are therefore evicted quickly, without pushing the frequently used keys out.
+ *  - The main queue is a CLOCK: its oldest key is evicted if it wasn't hit since it was last
+ *    examined, and moved to the newest end otherwise.
+ *  - The hashes of the keys evicted from the small queue are remembered in a ghost queue as long as
+ *    the cache's entries count; a key found there when inserted again goes directly to the main queue.
+ * A hit only increments a small saturating counter of the node: no list is reordered and nothing
+ * is written but that counter, so concurrent lookups don't need exclusive access.
+ *
+ * ShardedCacheTable splits the capacity among independent CacheTables selected by the keys' hash,
+ * each behind a reader-writer lock: lookups of a shard run concurrently, inserts and removals of a shard
+ * are serialized.
+ *
+ * The Instrumentation policy (see Common/Instrumentation.h) is notified of node allocations,
+ * node visits, key comparisons and rehashes.
+ *
+ * Usage example:
+ * --------------
+ * // At most 64 MiB of values
+ * CacheTable<std::string, std::string> cache(64 << 20, [](const std::string&, const std::string& value) {
+ *     return value.size();
+ * });
+ * cache.insert("user:1", loadUser(1));
+ * if (const std::string* user = cache.find("user:1")) render(*user);
+ * cache.stats().hitRatio();
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_CACHETABLE_H
+#define DSA_CACHETABLE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "HashTable.h"
+#include "SeededHash.h"
+#include "../Common/Instrumentation.h"
+#include "../Common/MemoryResource.h"
+
+/**
+ * @brief Counters of a cache's lookups and evictions.
+ */
+struct CacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t insertions = 0;
+    std::uint64_t evictions = 0;
+
+    [[nodiscard]] double hitRatio() const {
+        return hits + misses == 0 ? 0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+    }
+};
+
+template<typename Key, typename Value, typename Instrumentation = NoInstrumentation>
+class CacheTable {
+public:
+    /**
+     * @brief Weight of an entry, counted against the capacity.
+     */
+    using Weigher = std::size_t (*)(const Key& key, const Value& value);
+
+    /*region Big Five & Other Constructors*/
+
+    /**
+     * @brief Constructs an empty cache.
+     *
+     * @param capacity Maximum total weight of the entries.
+     * @param weigher Weight of an entry, every entry weighs 1 if null (the capacity is then in entries).
+     * @param resource The memory resource used for node allocations. It must outlive the cache.
+     */
+    explicit CacheTable(std::size_t capacity, Weigher weigher = nullptr,
+                        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Destructor
+    ~CacheTable();
+
+    CacheTable(const CacheTable& other) = delete;
+    CacheTable& operator=(const CacheTable& other) = delete;
+
+    /*endregion*/
+
+    /*region Constant Methods */
+
+    /**
+     * @brief Looks up a key, counting a hit or a miss.
+     *
+     * Safe to call concurrently with other lookups (see ShardedCacheTable).
+     *
+     * @return pointer to the value of the key, nullptr if the key isn't cached.
+     */
+    const Value* find(const Key& key) const;
+
+    /**
+     * @brief Retrieves the value associated with the given key, counting a hit or a miss.
+     *
+     * If the key is not cached, it throws a runtime error.
+     *
+     * @param key The key to search for.
+     * @return copy of the value associated with the key.
+     */
+    Value get(const Key& key) const;
+
+    /**
+     * @brief Checks if a key is cached, without counting it as a hit or a miss.
+     */
+    bool contains(const Key& key) const;
+
+    /**
+     * @return entries count
+     * */
+    [[nodiscard]] int size() const;
+
+    /**
+     * @return total weight of the entries
+     * */
+    [[nodiscard]] std::size_t weight() const;
+
+    [[nodiscard]] std::size_t capacity() const;
+
+    [[nodiscard]] CacheStats stats() const;
+
+    // endregion
+
+    /* region Non-Constant Methods */
+
+    /**
+     * @brief Inserts a key-value pair, evicting entries while the capacity is exceeded.
+     *
+     * If the key is already cached, its value is updated. An entry heavier than the whole capacity
+     * isn't cached.
+     *
+     * @param key The key of the element to be inserted.
+     * @param value The value associated with the key.
+     */
+    void insert(Key key, Value value);
+
+    /**
+     * @brief Removes the entry with the specified key. If the key is not cached, the function does nothing.
+     */
+    void remove(const Key& key);
+
+    /**
+     * @brief Resets the hits, misses, insertions and evictions counters.
+     */
+    void resetStats();
+
+    // endregion
+
+private:
+    static constexpr std::uint8_t MAX_FREQUENCY = 3;
+    static constexpr std::size_t SMALL_QUEUE_FRACTION = 10;  // the small queue holds 1/10 of the capacity
+
+    struct Node {
+        Key key;
+        Value value;
+        std::size_t weight;
+        Node* next = nullptr;        // next node of the bucket
+        Node* older = nullptr;       // neighbours in the node's queue
+        Node* newer = nullptr;
+        mutable std::atomic<std::uint8_t> frequency{0};  // hits since queued, saturating at MAX_FREQUENCY
+        bool inMain = false;
+
+        Node(Key key, Value value, std::size_t weight) : key(std::move(key)), value(std::move(value)), weight(weight) {}
+    };
+
+    /**
+     * @brief Intrusive FIFO queue of nodes, oldest first.
+     */
+    struct Queue {
+        Node* oldest = nullptr;
+        Node* newest = nullptr;
+        std::size_t weight = 0;
+
+        void push(Node* node);
+        void unlink(Node* node);
+    };
+
+    std::size_t maxWeight;
+    Weigher weigher;
+    std::pmr::memory_resource* resource;
+    std::vector<Node*> buckets;       // heads of the bucket lists, a power of two of them
+    int entriesCount = 0;
+    Queue small;
+    Queue main;
+    std::deque<std::uint64_t> ghost;  // hashes of the keys evicted from the small queue, oldest first
+    HashTable<std::uint64_t, int, Instrumentation> ghostCounts;  // occurrences of each hash in ghost
+
+    mutable std::atomic<std::uint64_t> hits{0};
+    mutable std::atomic<std::uint64_t> misses{0};
+    std::uint64_t insertions = 0;
+    std::uint64_t evictions = 0;
+
+    /* Private Constant Methods */
+
+    static std::uint64_t hashOf(const Key& key) {
+        return seededHash(static_cast<std::uint64_t>(std::hash<Key>{}(key)), 0);
+    }
+
+    Node* findNode(const Key& key, std::uint64_t hash) const;
+
+    /* Private Non-Constant Methods */
+
+    /**
+     * @brief Evicts an entry, or promotes one from the small queue to the main queue.
+     */
+    void evict();
+
+    /**
+     * @brief Unlinks the node from its bucket and queue, and deletes it.
+     */
+    void removeNode(Node* node);
+
+    void rememberEvicted(std::uint64_t hash);
+
+    /**
+     * @brief Checks if the hash was evicted from the small queue recently, forgetting it.
+     */
+    bool forgetEvicted(std::uint64_t hash);
+
+    /**
+     * @brief Doubles the buckets count.
+     */
+    void rehash();
+};
+
+template<typename Key, typename Value, typename Instrumentation = NoInstrumentation>
+class ShardedCacheTable {
+public:
+    using Weigher = typename CacheTable<Key, Value, Instrumentation>::Weigher;
+
+    /**
+     * @brief Constructs an empty cache.
+     *
+     * @param capacity Maximum total weight of the entries, split evenly among the shards.
+     * @param shardsCount Number of independent shards, a few times the number of threads using the cache.
+     * @param weigher Weight of an entry, every entry weighs 1 if null.
+     */
+    explicit ShardedCacheTable(std::size_t capacity, int shardsCount = 16, Weigher weigher = nullptr);
+
+    /**
+     * @brief Looks up a key, copying its value.
+     * @return true if the key is cached.
+     */
+    bool find(const Key& key, Value& value) const;
+
+    /**
+     * @return copy of the value associated with the key.
+     * @throws std::runtime_error If the key is not cached.
+     */
+    Value get(const Key& key) const;
+
+    bool contains(const Key& key) const;
+
+    void insert(Key key, Value value);
+
+    void remove(const Key& key);
+
+    /**
+     * @return entries count, of every shard.
+     */
+    [[nodiscard]] int size() const;
+
+    /**
+     * @return the counters of every shard summed.
+     */
+    [[nodiscard]] CacheStats stats() const;
+
+private:
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        CacheTable<Key, Value, Instrumentation> cache;
+
+        Shard(std::size_t capacity, Weigher weigher) : cache(capacity, weigher) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    Shard& shardOf(const Key& key) const {
+        // Another seed than the shards' buckets, so the keys of a shard still spread over all its buckets
+        auto hash = seededHash(static_cast<std::uint64_t>(std::hash<Key>{}(key)), 1);
+        return *shards[hash % shards.size()];
+    }
+};
+
+/*region CacheTable Queue */
+
+template<typename Key, typename Value, typename Instrumentation>
+void CacheTable<Key, Value, Instrumentation>::Queue::push(Node* node) {
+    node->older = newest;
+    node->newer = nullptr;
+    if (newest) newest->newer = node;
+    else oldest = node;
+    newest = node;
+
+    weight += node->weight;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+void CacheTable<Key, Value, Instrumentation>::Queue::unlink(Node* node) {
+    if (node->older) node->older->newer = node->newer;
+    else oldest = node->newer;
+    if (node->newer) node->newer->older = node->older;
+    else newest = node->older;
+    node->older = node->newer = nullptr;
+
+    weight -= node->weight;
+}
+
+/*endregion*/
+
+/*region Big five & other constructors */
+
+template<typename Key, typename Value, typename Instrumentation>
+CacheTable<Key, Value, Instrumentation>::CacheTable(std::size_t capacity, Weigher weigher,
+                                                    std::pmr::memory_resource* resource)
+        : maxWeight(capacity), weigher(weigher), resource(resource), buckets(16, nullptr) {
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+CacheTable<Key, Value, Instrumentation>::~CacheTable() {
+    for (Node* head : buckets) {
+        while (head) {
+            Node* next = head->next;
+            Instrumentation::onDeallocate(sizeof(Node));
+            deleteNode(resource, head);
+            head = next;
+        }
+    }
+}
+
+/*endregion*/
+
+/*region Public Constant Methods */
+
+template<typename Key, typename Value, typename Instrumentation>
+const Value* CacheTable<Key, Value, Instrumentation>::find(const Key& key) const {
+    Node* node = findNode(key, hashOf(key));
+    if (!node) {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // A lost increment between concurrent lookups only delays a promotion
+    auto frequency = node->frequency.load(std::memory_order_relaxed);
+    if (frequency < MAX_FREQUENCY) node->frequency.store(frequency + 1, std::memory_order_relaxed);
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return &node->value;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+Value CacheTable<Key, Value, Instrumentation>::get(const Key& key) const {
+    const Value* value = find(key);
+    if (!value)
+        throw std::runtime_error("key doesn't exist");
+    return *value;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+bool CacheTable<Key, Value, Instrumentation>::contains(const Key& key) const {
+    return findNode(key, hashOf(key)) != nullptr;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+int CacheTable<Key, Value, Instrumentation>::size() const {
+    return entriesCount;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+std::size_t CacheTable<Key, Value, Instrumentation>::weight() const {
+    return small.weight + main.weight;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+std::size_t CacheTable<Key, Value, Instrumentation>::capacity() const {
+    return maxWeight;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+CacheStats CacheTable<Key, Value, Instrumentation>::stats() const {
+    CacheStats result;
+    result.hits = hits.load(std::memory_order_relaxed);
+    result.misses = misses.load(std::memory_order_relaxed);
+    result.insertions = insertions;
+    result.evictions = evictions;
+    return result;
+}
+
+/* endregion */
+
+/*region Public Non-Constant Methods */
+
+template<typename Key, typename Value, typename Instrumentation>
+void CacheTable<Key, Value, Instrumentation>::insert(Key key, Value value) {
+    auto hash = hashOf(key);
+    std::size_t entryWeight = weigher ? weigher(key, value) : 1;
+    Node* node = findNode(key, hash);
+
+    if (node) {
+        // Updated in place, keeping its queue and frequency
+        Queue& queue = node->inMain ? main : small;
+        queue.weight = queue.weight - node->weight + entryWeight;
+        node->weight = entryWeight;
+        node->value = std::move(value);
+    } else {
+        if (entryWeight > maxWeight) return;
+
+        Instrumentation::onAllocate(sizeof(Node));
+        node = newNode<Node>(resource, std::move(key), std::move(value), entryWeight);
+
+        auto& head = buckets[hash & (buckets.size() - 1)];
+        node->next = head;
+        head = node;
+        entriesCount++;
+        insertions++;
+
+        node->inMain = forgetEvicted(hash);
+        (node->inMain ? main : small).push(node);
+
+        if (static_cast<std::size_t>(entriesCount) > buckets.size()) rehash();
+    }
+
+    while (weight() > maxWeight)
+        evict();
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+void CacheTable<Key, Value, Instrumentation>::remove(const Key& key) {
+    Node* node = findNode(key, hashOf(key));
+    if (node) removeNode(node);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+void CacheTable<Key, Value, Instrumentation>::resetStats() {
+    hits.store(0, std::memory_order_relaxed);
+    misses.store(0, std::memory_order_relaxed);
+    insertions = 0;
+    evictions = 0;
+}
+
+/* endregion */
+
+/* region Private Methods */
+
+template<typename Key, typename Value, typename Instrumentation>
+typename CacheTable<Key, Value, Instrumentation>::Node*
+CacheTable<Key, Value, Instrumentation>::findNode(const Key& key, std::uint64_t hash) const {
+    for (Node* node = buckets[hash & (buckets.size() - 1)]; node; node = node->next) {
+        Instrumentation::onVisit();
+        Instrumentation::onCompare();
+        if (node->key == key) return node;
+    }
+    return nullptr;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+void CacheTable<Key, Value, Instrumentation>::evict() {
+    if (small.oldest && (small.weight > maxWeight / SMALL_QUEUE_FRACTION || !main.oldest)) {
+        Node* node = small.oldest;
+
+        // Hit since inserted: worth keeping
+        if (node->frequency.load(std::memory_order_relaxed) > 0) {
+            small.unlink(node);
+            node->frequency.store(0, std::memory_order_relaxed);
+            node->inMain = true;
+            main.push(node);
+            return;
+        }
+
+        rememberEvicted(hashOf(node->key));
+        removeNode(node);
+        evictions++;
+        return;
+    }
+
+    // CLOCK: every hit buys the oldest node another pass through the queue
+    while (true) {
+        Node* node = main.oldest;
+        auto frequency = node->frequency.load(std::memory_order_relaxed);
+        if (frequency == 0) {
+            removeNode(node);
+            evictions++;
+            return;
+        }
+
+        node->frequency.store(frequency - 1, std::memory_order_relaxed);
+        main.unlink(node);
+        main.push(node);
+    }
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+void CacheTable<Key, Value, Instrumentation>::removeNode(Node* node) {
+    (node->inMain ? main : small).unlink(node);
+
+    Node** link = &buckets[hashOf(node->key) & (buckets.size() - 1)];
+    while (*link != node) {
+        Instrumentation::onVisit();
+        link = &(*link)->next;
+    }
+    *link = node->next;
+
+    entriesCount--;
+    Instrumentation::onDeallocate(sizeof(Node));
+    deleteNode(resource, node);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+void CacheTable<Key, Value, Instrumentation>::rememberEvicted(std::uint64_t hash) {
+    ghost.push_back(hash);
+    if (ghostCounts.contains(hash)) ghostCounts[hash]++;
+    else ghostCounts.insert(hash, 1);
+
+    // The ghost queue remembers about as many keys as the cache holds
+    while (ghost.size() > static_cast<std::size_t>(std::max(entriesCount, 1))) {
+        auto oldest = ghost.front();
+        ghost.pop_front();
+        // Hashes forgotten by forgetEvicted() have no count left
+        if (ghostCounts.contains(oldest) && --ghostCounts[oldest] == 0) ghostCounts.remove(oldest);
+    }
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+bool CacheTable<Key, Value, Instrumentation>::forgetEvicted(std::uint64_t hash) {
+    if (!ghostCounts.contains(hash)) return false;
+
+    // Its entry in the ghost queue is left to expire, the count is what's checked
+    ghostCounts.remove(hash);
+    return true;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+void CacheTable<Key, Value, Instrumentation>::rehash() {
+    Instrumentation::onRehash();
+
+    std::vector<Node*> newBuckets(buckets.size() * 2, nullptr);
+    for (Node* head : buckets) {
+        while (head) {
+            Node* next = head->next;
+            auto& newHead = newBuckets[hashOf(head->key) & (newBuckets.size() - 1)];
+            head->next = newHead;
+            newHead = head;
+            head = next;
+        }
+    }
+    buckets = std::move(newBuckets);
+}
+
+/* endregion */
+
+/*region ShardedCacheTable */
+
+template<typename Key, typename Value, typename Instrumentation>
+ShardedCacheTable<Key, Value, Instrumentation>::ShardedCacheTable(std::size_t capacity, int shardsCount,
+                                                                  Weigher weigher) {
+    if (shardsCount <= 0)
+        throw std::invalid_argument("A sharded cache needs at least one shard.");
+
+    for (int i = 0; i < shardsCount; ++i) {
+        // The remainder goes to the first shards
+        std::size_t shardCapacity = capacity / shardsCount + (static_cast<std::size_t>(i) < capacity % shardsCount);
+        shards.push_back(std::make_unique<Shard>(shardCapacity, weigher));
+    }
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+bool ShardedCacheTable<Key, Value, Instrumentation>::find(const Key& key, Value& value) const {
+    Shard& shard = shardOf(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    const Value* cached = shard.cache.find(key);
+    if (!cached) return false;
+    value = *cached;
+    return true;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+Value ShardedCacheTable<Key, Value, Instrumentation>::get(const Key& key) const {
+    Value value{};
+    if (!find(key, value))
+        throw std::runtime_error("key doesn't exist");
+    return value;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+bool ShardedCacheTable<Key, Value, Instrumentation>::contains(const Key& key) const {
+    Shard& shard = shardOf(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.cache.contains(key);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+void ShardedCacheTable<Key, Value, Instrumentation>::insert(Key key, Value value) {
+    Shard& shard = shardOf(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.cache.insert(std::move(key), std::move(value));
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+void ShardedCacheTable<Key, Value, Instrumentation>::remove(const Key& key) {
+    Shard& shard = shardOf(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.cache.remove(key);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+int ShardedCacheTable<Key, Value, Instrumentation>::size() const {
+    int count = 0;
+    for (const auto& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard->mutex);
+        count += shard->cache.size();
+    }
+    return count;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+CacheStats ShardedCacheTable<Key, Value, Instrumentation>::stats() const {
+    CacheStats total;
+    for (const auto& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard->mutex);
+        CacheStats shardStats = shard->cache.stats();
+        total.hits += shardStats.hits;
+        total.misses += shardStats.misses;
+        total.insertions += shardStats.insertions;
+        total.evictions += shardStats.evictions;
+    }
+    return total;
+}
+
+/*endregion*/
+
+#endif //DSA_CACHETABLE_H
@@ -0,0 +1,707 @@
+/**
+ * @file CuckooHashTable.h
+ * @brief Declaration and implementation of the CuckooHashTable class, an open addressing hash table
+ * filled above 90% with worst case O(1) lookups.
+ *
+ * Every key has two candidate buckets of 4 slots, and is always stored in one of them: a lookup
+ * checks at most 8 slots in 2 buckets, whatever the load. The slots hold the keys and values
+ * inline, with no pointer or node per element, so the table uses far less memory than the chained
+ * HashTable for small elements.
+ *
+ * - Each slot has a one byte tag (8 bits of the key's hash, 0 marking a free slot), so most slots
+ *   that can't hold the key are skipped without comparing keys.
+ * - The second bucket is computed from the first bucket and the tag ("partial key cuckoo hashing"),
+ *   so an element can be moved to its other bucket without hashing its key again.
+ * - When both buckets of a new key are full, a breadth first search looks for the shortest chain of
+ *   elements (at most MAX_PATH_LENGTH) to move to their other bucket, ending at a free slot, and
+ *   moves them starting from the end. When there is none, the table doubles its buckets.
+ * Inserts keep succeeding up to a load factor of about 95%.
+ *
+ * Optimistic concurrent reads:
+ * With OptimisticReads set, contains() and get() can run concurrently with each other and with one
+ * mutating call at a time (insert(), remove() and operator[] are serialized by a mutex). Readers take
+ * no lock: every bucket is covered by a version counter that writers make odd while they change the
+ * bucket, and a reader retries when a version it read changed meanwhile. Buckets replaced by a resize
+ * are kept until the table is destroyed, so readers never touch freed memory. Key and Value must be
+ * trivially copyable in this mode, since readers may copy a slot while it is being written.
+ *
+ * Key and Value must be default constructible, the slots being arrays of them.
+ * The Instrumentation policy (see Common/Instrumentation.h) is notified of bucket visits,
+ * key comparisons and resizes.
+ *
+ * Usage example:
+ * --------------
+ * CuckooHashTable<std::uint64_t, std::uint32_t> table(1000000);
+ * table.insert(42, 7);
+ * table.get(42); // 7
+ * table.loadFactor(); // up to ~0.95 before the table grows
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_CUCKOOHASHTABLE_H
+#define DSA_CUCKOOHASHTABLE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SeededHash.h"
+#include "../Common/Instrumentation.h"
+
+template<typename Key, typename Value, typename Instrumentation = NoInstrumentation, bool OptimisticReads = false>
+class CuckooHashTable {
+    static_assert(!OptimisticReads || (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value>),
+                  "Optimistic reads need trivially copyable keys and values.");
+
+public:
+
+    /*region Big Five & Other Constructors*/
+
+    // Default Constructor
+    CuckooHashTable();
+
+    // Destructor
+    ~CuckooHashTable() = default;
+
+    // Copy Constructor
+    CuckooHashTable(const CuckooHashTable& other);
+
+    // Copy Assignment Operator
+    CuckooHashTable& operator=(const CuckooHashTable& other);
+
+    // Move Constructor
+    CuckooHashTable(CuckooHashTable&& other) noexcept;
+
+    // Move Assignment Operator
+    CuckooHashTable& operator=(CuckooHashTable&& other) noexcept;
+
+    /**
+     * @brief Constructs an empty table with room for size elements before it grows.
+     */
+    explicit CuckooHashTable(int size);
+
+    /*endregion*/
+
+    /*region Constant Methods */
+
+    /**
+     * @brief Checks if a key exists in the hash table.
+     */
+    bool contains(const Key& key) const;
+
+    /**
+     * @return elements count
+     * */
+    [[nodiscard]] int size() const;
+
+    /**
+     * @return number of slots, the elements the table can hold before it grows.
+     * */
+    [[nodiscard]] int capacity() const;
+
+    /**
+     * @return ratio of occupied slots.
+     * */
+    [[nodiscard]] double loadFactor() const;
+
+    /**
+     * @brief Retrieves the value associated with the given key.
+     *
+     * If the key is not found in the hash table, it throws a runtime error.
+     *
+     * @param key The key to search for.
+     * @return copy of the value associated with the key.
+     */
+    Value get(const Key& key) const;
+
+    // endregion
+
+    /* region Non-Constant Methods */
+
+    /**
+     * @brief Inserts a key-value pair into the hash table.
+     *
+     * If the key already exists in the hash table, the value will be updated to the new one.
+     *
+     * @param key The key of the element to be inserted.
+     * @param value The value associated with the key.
+     */
+    void insert(Key key, Value value);
+
+    /**
+     * @brief Retrieves a reference to value associated with the given key.
+     *
+     * If the key is not found in the hash table, the function throws a runtime error.
+     * The reference is invalidated by the next insert. With OptimisticReads, writing through it
+     * isn't synchronized with concurrent readers.
+     *
+     * @param key The key to search for.
+     * @return Reference to the value associated with the key.
+     */
+    Value& operator[](const Key& key);
+
+    /**
+     * @brief Removes the key-value pair with the specified key from the hash table.
+     *
+     * If the key is not found in the hash table, the function does nothing.
+     *
+     * @param key The key of the element to be removed.
+     */
+    void remove(const Key& key);
+
+    // endregion
+
+private:
+    static constexpr int SLOTS = 4;               // Slots per bucket
+    static constexpr int MAX_PATH_LENGTH = 5;     // Elements moved at most to make room for an insert
+    static constexpr std::size_t VERSIONS = 4096; // Version counters at most, shared by the buckets
+
+    struct Bucket {
+        std::uint8_t tags[SLOTS] = {};  // 0 marks a free slot
+        Key keys[SLOTS]{};
+        Value values[SLOTS]{};
+    };
+
+    struct Table {
+        std::size_t mask;  // buckets count - 1, a power of two minus one
+        std::vector<Bucket> buckets;
+        std::vector<std::atomic<std::uint32_t>> versions;  // Only used with OptimisticReads
+
+        explicit Table(std::size_t bucketsCount)
+                : mask(bucketsCount - 1), buckets(bucketsCount),
+                  versions(OptimisticReads ? std::min(bucketsCount, VERSIONS) : 0) {}
+
+        Table(const Table& other) : mask(other.mask), buckets(other.buckets), versions(other.versions.size()) {}
+    };
+
+    /**
+     * @brief A bucket reached by the search for a cuckoo path.
+     */
+    struct PathNode {
+        std::size_t bucket;
+        int parent;      // index of the node whose element moves to this bucket, -1 for the key's own buckets
+        int parentSlot;  // slot of that element in the parent's bucket
+        int depth;
+    };
+
+    // The current table is the last one, older ones are kept for concurrent readers
+    std::vector<std::unique_ptr<Table>> tables;
+    std::atomic<Table*> current{nullptr};
+    int elementsCount = 0;
+    std::mutex writeMutex;   // Only used with OptimisticReads
+
+    /* Private Static Methods */
+
+    static std::uint64_t hashOf(const Key& key) {
+        // std::hash is often the identity, mix it so both the bucket and the tag bits are spread
+        return seededHash(static_cast<std::uint64_t>(std::hash<Key>{}(key)), 0);
+    }
+
+    static std::uint8_t tagOf(std::uint64_t hash) {
+        auto tag = static_cast<std::uint8_t>(hash >> 56);
+        return tag ? tag : 1;
+    }
+
+    /**
+     * @return the other bucket of the elements with the given tag in the given bucket.
+     */
+    static std::size_t alternateBucket(std::size_t bucket, std::uint8_t tag, std::size_t mask) {
+        // Odd, so the two buckets differ, and the xor makes it symmetric
+        return (bucket ^ ((tag * 0xC6A4A7935BD1E995ull) | 1)) & mask;
+    }
+
+    static std::size_t bucketsFor(int size);
+
+    /**
+     * @return slot of the key in the bucket, -1 if it isn't there.
+     */
+    static int findSlot(const Bucket& bucket, std::uint8_t tag, const Key& key);
+
+    static int freeSlot(const Bucket& bucket);
+
+    /**
+     * @return a mask with bit i set if the tag of slot i is tag.
+     */
+    static std::uint32_t matchTags(const Bucket& bucket, std::uint8_t tag);
+
+    /**
+     * @pre bits isn't 0.
+     */
+    static int lowestBit(std::uint32_t bits);
+
+    /* Private Methods */
+
+    std::unique_lock<std::mutex> lockWriters();
+
+    /**
+     * @brief Marks the buckets as being written, readers of them retry until endWrite().
+     */
+    void beginWrite(Table& table, std::size_t first, std::size_t second);
+    void endWrite(Table& table, std::size_t first, std::size_t second);
+
+    void place(Table& table, std::size_t bucket, int slot, std::uint8_t tag, Key&& key, Value&& value);
+
+    /**
+     * @brief Frees a slot in one of the two buckets by moving elements to their other bucket.
+     * @return the freed bucket and slot, a -1 slot if there is no path short enough.
+     */
+    std::pair<std::size_t, int> makeRoom(Table& table, std::size_t first, std::size_t second);
+
+    /**
+     * @brief Inserts a key which isn't in the table.
+     * @return false if there was no room for it.
+     */
+    bool insertNew(Table& table, std::uint64_t hash, Key&& key, Value&& value);
+
+    /**
+     * @brief Doubles the buckets count and moves every element to the new buckets.
+     */
+    void grow();
+
+    /**
+     * @brief Looks up the key, copying its value if value isn't null.
+     */
+    bool lookup(const Key& key, Value* value) const;
+
+    Value* findValue(const Key& key);
+};
+
+/*region Big five & other constructors */
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::CuckooHashTable() : CuckooHashTable(64) {}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::CuckooHashTable(int size) {
+    tables.push_back(std::make_unique<Table>(bucketsFor(size)));
+    current.store(tables.back().get(), std::memory_order_release);
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::CuckooHashTable(const CuckooHashTable& other)
+        : elementsCount(other.elementsCount) {
+    tables.push_back(std::make_unique<Table>(*other.tables.back()));
+    current.store(tables.back().get(), std::memory_order_release);
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>&
+CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::operator=(const CuckooHashTable& other) {
+    if (this != &other) {
+        // Copy first, so 'this' is left untouched if copying throws
+        auto copy = std::make_unique<Table>(*other.tables.back());
+        tables.clear();
+        tables.push_back(std::move(copy));
+        current.store(tables.back().get(), std::memory_order_release);
+        elementsCount = other.elementsCount;
+    }
+    return *this;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::CuckooHashTable(CuckooHashTable&& other) noexcept
+        : tables(std::move(other.tables)), current(other.current.exchange(nullptr)),
+          elementsCount(std::exchange(other.elementsCount, 0)) {
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>&
+CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::operator=(CuckooHashTable&& other) noexcept {
+    if (this != &other) {
+        tables = std::move(other.tables);
+        current.store(other.current.exchange(nullptr), std::memory_order_release);
+        elementsCount = std::exchange(other.elementsCount, 0);
+    }
+    return *this;
+}
+
+/*endregion*/
+
+/*region Public Constant Methods */
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+bool CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::contains(const Key& key) const {
+    return lookup(key, nullptr);
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+int CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::size() const {
+    return elementsCount;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+int CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::capacity() const {
+    return static_cast<int>(current.load(std::memory_order_acquire)->buckets.size()) * SLOTS;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+double CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::loadFactor() const {
+    return static_cast<double>(elementsCount) / capacity();
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+Value CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::get(const Key& key) const {
+    Value value{};
+    if (!lookup(key, &value))
+        throw std::runtime_error("key doesn't exist");
+    return value;
+}
+
+/* endregion */
+
+/*region Public Non-Constant Methods */
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+void CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::insert(Key key, Value value) {
+    auto lock = lockWriters();
+
+    Table& table = *tables.back();
+    auto hash = hashOf(key);
+    auto tag = tagOf(hash);
+    std::size_t first = hash & table.mask;
+    std::size_t second = alternateBucket(first, tag, table.mask);
+
+    // key already exists, update its value
+    for (std::size_t bucketIndex : {first, second}) {
+        Instrumentation::onVisit();
+        Bucket& bucket = table.buckets[bucketIndex];
+        int slot = findSlot(bucket, tag, key);
+        if (slot < 0) continue;
+
+        beginWrite(table, bucketIndex, bucketIndex);
+        bucket.values[slot] = std::move(value);
+        endWrite(table, bucketIndex, bucketIndex);
+        return;
+    }
+
+    while (!insertNew(*tables.back(), hash, std::move(key), std::move(value)))
+        grow();
+    elementsCount++;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+Value& CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::operator[](const Key& key) {
+    auto lock = lockWriters();
+
+    Value* value = findValue(key);
+    if (!value)
+        throw std::runtime_error("key doesn't exist");
+    return *value;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+void CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::remove(const Key& key) {
+    auto lock = lockWriters();
+
+    Table& table = *tables.back();
+    auto hash = hashOf(key);
+    auto tag = tagOf(hash);
+    std::size_t first = hash & table.mask;
+    std::size_t second = alternateBucket(first, tag, table.mask);
+
+    for (std::size_t bucketIndex : {first, second}) {
+        Instrumentation::onVisit();
+        Bucket& bucket = table.buckets[bucketIndex];
+        int slot = findSlot(bucket, tag, key);
+        if (slot < 0) continue;
+
+        beginWrite(table, bucketIndex, bucketIndex);
+        bucket.tags[slot] = 0;
+        bucket.keys[slot] = Key{};
+        bucket.values[slot] = Value{};
+        endWrite(table, bucketIndex, bucketIndex);
+
+        elementsCount--;
+        return;
+    }
+}
+
+/* endregion */
+
+/* region Private Static Methods */
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+std::size_t CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::bucketsFor(int size) {
+    // Keeps the expected load under 90%, where inserts rarely need long paths
+    std::size_t needed = static_cast<std::size_t>(std::max(size, 1)) * 10 / 9 / SLOTS + 1;
+    std::size_t buckets = 2;
+    while (buckets < needed) buckets *= 2;
+    return buckets;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+int CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::findSlot(const Bucket& bucket, std::uint8_t tag,
+                                                                             const Key& key) {
+    for (std::uint32_t matches = matchTags(bucket, tag); matches; matches &= matches - 1) {
+        int slot = lowestBit(matches);
+        Instrumentation::onCompare();
+        if (bucket.keys[slot] == key) return slot;
+    }
+    return -1;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+int CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::freeSlot(const Bucket& bucket) {
+    std::uint32_t matches = matchTags(bucket, 0);
+    return matches ? lowestBit(matches) : -1;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+std::uint32_t CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::matchTags(const Bucket& bucket,
+                                                                                       std::uint8_t tag) {
+    // Compiles to flag setting comparisons, without branches to mispredict
+    std::uint32_t matches = 0;
+    for (int slot = 0; slot < SLOTS; ++slot)
+        matches |= static_cast<std::uint32_t>(bucket.tags[slot] == tag) << slot;
+    return matches;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+int CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::lowestBit(std::uint32_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(bits);
+#else
+    int bit = 0;
+    while (!(bits & (1u << bit))) bit++;
+    return bit;
+#endif
+}
+
+/* endregion */
+
+/* region Private Methods */
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+std::unique_lock<std::mutex> CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::lockWriters() {
+    if constexpr (OptimisticReads) return std::unique_lock<std::mutex>(writeMutex);
+    else return std::unique_lock<std::mutex>();
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+void CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::beginWrite(Table& table, std::size_t first,
+                                                                                std::size_t second) {
+    if constexpr (OptimisticReads) {
+        // Writers are serialized, so the counters only need to be published, not incremented atomically
+        auto mask = table.versions.size() - 1;
+        auto& firstVersion = table.versions[first & mask];
+        auto& secondVersion = table.versions[second & mask];
+        firstVersion.store(firstVersion.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (&secondVersion != &firstVersion)
+            secondVersion.store(secondVersion.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+void CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::endWrite(Table& table, std::size_t first,
+                                                                              std::size_t second) {
+    if constexpr (OptimisticReads) {
+        auto mask = table.versions.size() - 1;
+        auto& firstVersion = table.versions[first & mask];
+        auto& secondVersion = table.versions[second & mask];
+        firstVersion.store(firstVersion.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        if (&secondVersion != &firstVersion)
+            secondVersion.store(secondVersion.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+void CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::place(Table& table, std::size_t bucketIndex, int slot,
+                                                                          std::uint8_t tag, Key&& key, Value&& value) {
+    Bucket& bucket = table.buckets[bucketIndex];
+    beginWrite(table, bucketIndex, bucketIndex);
+    bucket.keys[slot] = std::move(key);
+    bucket.values[slot] = std::move(value);
+    bucket.tags[slot] = tag;
+    endWrite(table, bucketIndex, bucketIndex);
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+std::pair<std::size_t, int>
+CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::makeRoom(Table& table, std::size_t first,
+                                                                       std::size_t second) {
+    // Breadth first, so the path found is the shortest one: fewer moves, and fewer readers retrying
+    std::vector<PathNode> nodes{{first, -1, -1, 0}, {second, -1, -1, 0}};
+
+    for (std::size_t index = 0; index < nodes.size(); ++index) {
+        PathNode node = nodes[index];
+        const Bucket& bucket = table.buckets[node.bucket];
+        Instrumentation::onVisit();
+
+        for (int slot = 0; slot < SLOTS; ++slot) {
+            std::size_t target = alternateBucket(node.bucket, bucket.tags[slot], table.mask);
+            int targetSlot = freeSlot(table.buckets[target]);
+
+            if (targetSlot >= 0) {
+                // Moves the elements along the path, from its free end back to one of the key's buckets
+                std::size_t freeBucket = target;
+                int free = targetSlot;
+                int from = slot;
+                for (int pathIndex = static_cast<int>(index); pathIndex >= 0; pathIndex = nodes[pathIndex].parent) {
+                    const PathNode& step = nodes[pathIndex];
+                    Bucket& source = table.buckets[step.bucket];
+
+                    beginWrite(table, step.bucket, freeBucket);
+                    Bucket& destination = table.buckets[freeBucket];
+                    destination.keys[free] = std::move(source.keys[from]);
+                    destination.values[free] = std::move(source.values[from]);
+                    destination.tags[free] = source.tags[from];
+                    source.tags[from] = 0;
+                    endWrite(table, step.bucket, freeBucket);
+
+                    freeBucket = step.bucket;
+                    free = from;
+                    from = step.parentSlot;
+                }
+                return {freeBucket, free};
+            }
+
+            if (node.depth + 1 >= MAX_PATH_LENGTH) continue;
+
+            // A bucket already on the path would be moved out of while being moved into
+            bool onPath = false;
+            for (int ancestor = static_cast<int>(index); ancestor >= 0; ancestor = nodes[ancestor].parent)
+                onPath |= nodes[ancestor].bucket == target;
+            if (!onPath)
+                nodes.push_back({target, static_cast<int>(index), slot, node.depth + 1});
+        }
+    }
+    return {0, -1};
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+bool CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::insertNew(Table& table, std::uint64_t hash,
+                                                                              Key&& key, Value&& value) {
+    auto tag = tagOf(hash);
+    std::size_t first = hash & table.mask;
+    std::size_t second = alternateBucket(first, tag, table.mask);
+
+    for (std::size_t bucket : {first, second}) {
+        int slot = freeSlot(table.buckets[bucket]);
+        if (slot >= 0) {
+            place(table, bucket, slot, tag, std::move(key), std::move(value));
+            return true;
+        }
+    }
+
+    auto [bucket, slot] = makeRoom(table, first, second);
+    if (slot < 0) return false;
+
+    place(table, bucket, slot, tag, std::move(key), std::move(value));
+    return true;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+void CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::grow() {
+    Instrumentation::onRehash();
+
+    const Table& old = *tables.back();
+    for (std::size_t bucketsCount = old.buckets.size() * 2; ; bucketsCount *= 2) {
+        // The old buckets stay untouched until the new ones are complete, so a failed attempt loses nothing
+        auto table = std::make_unique<Table>(bucketsCount);
+        bool complete = true;
+        for (const Bucket& bucket : old.buckets) {
+            for (int slot = 0; slot < SLOTS && complete; ++slot) {
+                if (bucket.tags[slot] == 0) continue;
+                Key key = bucket.keys[slot];
+                Value value = bucket.values[slot];
+                complete = insertNew(*table, hashOf(key), std::move(key), std::move(value));
+            }
+            if (!complete) break;
+        }
+        if (!complete) continue;
+
+        if constexpr (!OptimisticReads) tables.clear();
+        tables.push_back(std::move(table));
+        current.store(tables.back().get(), std::memory_order_release);
+        return;
+    }
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+bool CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::lookup(const Key& key, Value* value) const {
+    auto hash = hashOf(key);
+    auto tag = tagOf(hash);
+
+    while (true) {
+        const Table* table = current.load(std::memory_order_acquire);
+        std::size_t first = hash & table->mask;
+        std::size_t second = alternateBucket(first, tag, table->mask);
+
+        std::uint32_t firstVersion = 0, secondVersion = 0;
+        if constexpr (OptimisticReads) {
+            auto mask = table->versions.size() - 1;
+            firstVersion = table->versions[first & mask].load(std::memory_order_acquire);
+            secondVersion = table->versions[second & mask].load(std::memory_order_acquire);
+            if ((firstVersion | secondVersion) & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+        }
+
+        // Both buckets' tags are matched before comparing keys, so the only branch is the (usually single)
+        // candidate slot loop, and the two buckets are fetched from memory in parallel
+        const Bucket& firstBucket = table->buckets[first];
+        const Bucket& secondBucket = table->buckets[second];
+        Instrumentation::onVisit();
+        Instrumentation::onVisit();
+        std::uint32_t candidates = matchTags(firstBucket, tag) | matchTags(secondBucket, tag) << SLOTS;
+
+        bool found = false;
+        Value copy{};
+        for (; candidates; candidates &= candidates - 1) {
+            int candidate = lowestBit(candidates);
+            const Bucket& bucket = candidate < SLOTS ? firstBucket : secondBucket;
+            int slot = candidate % SLOTS;
+            Instrumentation::onCompare();
+            if (!(bucket.keys[slot] == key)) continue;
+
+            found = true;
+            if (value) copy = bucket.values[slot];
+            break;
+        }
+
+        if constexpr (OptimisticReads) {
+            // Retries if a writer changed the buckets, or moved to new ones, while they were read
+            std::atomic_thread_fence(std::memory_order_acquire);
+            auto mask = table->versions.size() - 1;
+            if (table->versions[first & mask].load(std::memory_order_relaxed) != firstVersion
+                || table->versions[second & mask].load(std::memory_order_relaxed) != secondVersion
+                || current.load(std::memory_order_relaxed) != table)
+                continue;
+        }
+
+        if (found && value) *value = std::move(copy);
+        return found;
+    }
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool OptimisticReads>
+Value* CuckooHashTable<Key, Value, Instrumentation, OptimisticReads>::findValue(const Key& key) {
+    Table& table = *tables.back();
+    auto hash = hashOf(key);
+    auto tag = tagOf(hash);
+    std::size_t first = hash & table.mask;
+
+    for (std::size_t bucketIndex : {first, alternateBucket(first, tag, table.mask)}) {
+        Instrumentation::onVisit();
+        Bucket& bucket = table.buckets[bucketIndex];
+        int slot = findSlot(bucket, tag, key);
+        if (slot >= 0) return &bucket.values[slot];
+    }
+    return nullptr;
+}
+
+/* endregion */
+
+#endif //DSA_CUCKOOHASHTABLE_H
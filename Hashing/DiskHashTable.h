@@ -0,0 +1,651 @@
+/**
+ * @file DiskHashTable.h
+ * @brief Declaration and implementation of the DiskHashTable class, a hash index stored in a file
+ * with extendible hashing.
+ *
+ * The file is an array of fixed-size pages. Page 0 is a header, every other page is a bucket holding
+ * packed (key, value) records, or a range of pages storing the directory. The directory, kept in
+ * memory, maps the globalDepth low bits of a hash to the bucket page holding the keys with these bits.
+ * A bucket with a local depth lower than the global depth is shared by several directory entries.
+ *
+ * Growth is incremental: a full bucket is split on its own, moving the records whose next hash bit is
+ * set to a new page (two page writes), and only the directory entries of this bucket change. When the
+ * bucket's depth is already the global depth, the directory doubles first, in memory, without any I/O.
+ * Past MAX_GLOBAL_DEPTH bits, full buckets get overflow pages instead (only reached with huge files or
+ * many equal hashes). Buckets are never merged and the file never shrinks.
+ *
+ * Pages are accessed through a BufferPool (see Common/BufferPool.h): a lookup costs at most one page
+ * read, none if the bucket is cached, and an insert one read plus the eventual write-back of the page.
+ * stats() reports the page reads and writes, so the I/Os of an operation can be measured.
+ *
+ * Keys and values are stored as raw bytes, they must be trivially copyable, and keys are hashed with
+ * std::hash, which must give the same hashes each time the file is opened (it does for the integers).
+ * The pages and the directory are written back by flush() and the destructor: the file is only
+ * consistent after them, there is no recovery from a crash. The table is not thread-safe.
+ *
+ * Usage example:
+ * --------------
+ * DiskHashTable<std::uint64_t, std::uint64_t> index("orders.index");
+ * index.insert(42, 1000);
+ * std::uint64_t offset;
+ * if (index.find(42, offset)) use(offset);
+ * index.flush();
+ *
+ * @note This class relies on POSIX file I/O (open, pread, pwrite).
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_DISKHASHTABLE_H
+#define DSA_DISKHASHTABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SeededHash.h"
+#include "../Common/BufferPool.h"
+
+/**
+ * @brief Counters of a disk hash table's operations and I/Os.
+ */
+struct DiskHashStats {
+    std::uint64_t lookups = 0;
+    std::uint64_t inserts = 0;
+    std::uint64_t removals = 0;
+    std::uint64_t pageReads = 0;
+    std::uint64_t pageWrites = 0;
+    std::uint64_t splits = 0;
+    std::uint64_t directoryDoublings = 0;
+    std::uint64_t overflowPages = 0;
+
+    [[nodiscard]] std::uint64_t pageIOs() const { return pageReads + pageWrites; }
+};
+
+template<typename Key, typename Value>
+class DiskHashTable {
+    static_assert(std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value>,
+                  "DiskHashTable stores keys and values as raw bytes, they must be trivially copyable");
+    static_assert(std::is_default_constructible_v<Key> && std::is_default_constructible_v<Value>,
+                  "DiskHashTable needs default constructible keys and values to read them back");
+
+public:
+    /*region Big Five & Other Constructors*/
+
+    /**
+     * @brief Opens the index stored in a file, creating an empty one if the file doesn't exist or is empty.
+     *
+     * @param path The file.
+     * @param poolPages Pages cached in memory, at least 2.
+     * @param pageSize Size of the pages of a new file, an existing file keeps its own.
+     * @throws std::runtime_error If the file can't be opened or isn't an index of these key and value types.
+     * @throws std::invalid_argument If the pool or the page size are too small.
+     */
+    explicit DiskHashTable(const std::string& path, std::size_t poolPages = 64, std::uint32_t pageSize = 4096);
+
+    /**
+     * @brief Flushes the table and closes the file.
+     */
+    ~DiskHashTable();
+
+    DiskHashTable(const DiskHashTable& other) = delete;
+    DiskHashTable& operator=(const DiskHashTable& other) = delete;
+
+    /*endregion*/
+
+    /*region Constant Methods */
+
+    /**
+     * @brief Looks up a key, copying its value.
+     * @return true if the key is present.
+     * @throws std::runtime_error If a page can't be read, or its bucket header is corrupt.
+     */
+    bool find(const Key& key, Value& value) const;
+
+    /**
+     * @return copy of the value associated with the key.
+     * @throws std::runtime_error If the key is not present.
+     */
+    Value get(const Key& key) const;
+
+    bool contains(const Key& key) const;
+
+    [[nodiscard]] std::uint64_t size() const;
+
+    [[nodiscard]] bool empty() const;
+
+    /**
+     * @return number of hash bits indexing the directory, which has 2^globalDepth entries.
+     */
+    [[nodiscard]] std::uint32_t globalDepth() const;
+
+    /**
+     * @return number of pages of the file, header and directory included.
+     */
+    [[nodiscard]] std::uint32_t pagesCount() const;
+
+    [[nodiscard]] DiskHashStats stats() const;
+
+    /*endregion*/
+
+    /*region Non-Constant Methods */
+
+    /**
+     * @brief Adds the key, or replaces its value if it is present.
+     * @throws std::runtime_error If a page can't be read or written, or its bucket header is corrupt.
+     */
+    void insert(const Key& key, const Value& value);
+
+    /**
+     * @return true if the key was present and removed.
+     * @throws std::runtime_error If a page can't be read, or its bucket header is corrupt.
+     */
+    bool remove(const Key& key);
+
+    /**
+     * @brief Writes the modified pages, the directory and the header, then syncs the file.
+     * @throws std::runtime_error If the file can't be written.
+     */
+    void flush();
+
+    /*endregion*/
+
+    /**
+     * @brief Beyond this depth (a directory of 2^24 entries, 64 MB) full buckets get overflow pages.
+     */
+    static constexpr std::uint32_t MAX_GLOBAL_DEPTH = 24;
+
+private:
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t pageSize;
+        std::uint32_t keySize;
+        std::uint32_t valueSize;
+        std::uint32_t globalDepth;
+        std::uint32_t pagesCount;
+        std::uint32_t directoryPage;    // First page of the directory, 0 before the first flush
+        std::uint32_t directoryPages;   // Pages reserved for the directory, from directoryPage
+        std::uint32_t reserved;
+        std::uint64_t size;
+    };
+
+    struct BucketHeader {
+        std::uint32_t localDepth;
+        std::uint32_t count;
+        std::uint32_t overflow;         // Next page of the bucket, NO_PAGE if none
+        std::uint32_t reserved;
+    };
+
+    static constexpr char MAGIC[8] = {'D', 'S', 'A', 'H', 'A', 'S', 'H', '1'};
+    static constexpr std::uint32_t NO_PAGE = 0;   // Page 0 is the header, it can't be a bucket
+    static constexpr std::size_t RECORD_SIZE = sizeof(Key) + sizeof(Value);
+
+    std::string path;
+    int fd;
+    std::uint32_t pageSize;
+    std::uint32_t recordsPerPage;
+    std::unique_ptr<BufferPool> pool;
+    std::vector<std::uint32_t> directory;
+    std::uint32_t depth = 0;
+    std::uint32_t pages = 0;
+    std::uint32_t directoryPage = 0;
+    std::uint32_t directoryPages = 0;
+    std::uint64_t count = 0;
+    bool directoryDirty = false;
+    mutable DiskHashStats counters;
+
+    /**
+     * @brief Initializes an empty file: the header page and one bucket of depth 0.
+     */
+    void create();
+
+    /**
+     * @brief Reads the header and the directory of an existing file.
+     */
+    void load(std::uint64_t fileSize);
+
+    [[noreturn]] void fail(const std::string& message);
+
+    static std::uint64_t hashOf(const Key& key);
+
+    [[nodiscard]] std::uint32_t bucketOf(std::uint64_t hash) const;
+
+    static BucketHeader headerOf(const char* page);
+
+    /**
+     * @brief Reads the header of a bucket page, checking it against the file: a corrupt count would read
+     * past the page, and a corrupt overflow page past the file or around a cycle. Overflow pages are
+     * allocated after the page they extend, so a valid chain only goes forward.
+     * @throws std::runtime_error If the header can't belong to the page.
+     */
+    BucketHeader bucketHeader(const char* page, std::uint32_t pageNumber) const;
+
+    static void setHeader(char* page, const BucketHeader& header);
+
+    static char* record(char* page, std::uint32_t index);
+
+    static Key keyAt(const char* page, std::uint32_t index);
+
+    static Value valueAt(const char* page, std::uint32_t index);
+
+    static void write(char* page, std::uint32_t index, const Key& key, const Value& value);
+
+    std::uint32_t allocatePage();
+
+    /**
+     * @brief Splits the bucket of a directory entry, doubling the directory first if needed.
+     */
+    void split(std::uint32_t entry);
+
+    void writeDirectory();
+
+    void writeHeader();
+};
+
+/*region Big Five & Other Constructors */
+
+template<typename Key, typename Value>
+DiskHashTable<Key, Value>::DiskHashTable(const std::string& path, std::size_t poolPages, std::uint32_t pageSize)
+        : path(path), pageSize(pageSize) {
+    if (poolPages < 2) throw std::invalid_argument("A disk hash table needs a pool of at least 2 pages.");
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) throw std::runtime_error("Couldn't open hash index " + path);
+
+    struct stat status{};
+    if (::fstat(fd, &status) != 0) fail("Couldn't open hash index " + path);
+
+    if (status.st_size == 0) {
+        if (pageSize < sizeof(FileHeader) || pageSize < sizeof(BucketHeader) + 2 * RECORD_SIZE) {
+            ::close(fd);
+            throw std::invalid_argument("The page size can't hold two records.");
+        }
+    } else {
+        load(static_cast<std::uint64_t>(status.st_size));
+    }
+
+    recordsPerPage = static_cast<std::uint32_t>((this->pageSize - sizeof(BucketHeader)) / RECORD_SIZE);
+    pool = std::make_unique<BufferPool>(fd, this->pageSize, poolPages);
+    if (status.st_size == 0) create();
+}
+
+template<typename Key, typename Value>
+DiskHashTable<Key, Value>::~DiskHashTable() {
+    try {
+        flush();
+    } catch (const std::exception&) {
+        // A destructor can't report the failure, call flush() beforehand to handle it
+    }
+    pool.reset();
+    ::close(fd);
+}
+
+/*endregion*/
+
+/*region Public Constant Methods */
+
+template<typename Key, typename Value>
+bool DiskHashTable<Key, Value>::find(const Key& key, Value& value) const {
+    counters.lookups++;
+    std::uint32_t page = directory[bucketOf(hashOf(key))];
+    while (page != NO_PAGE) {
+        BufferPool::Page handle = pool->fetch(page);
+        const char* data = handle.data();
+        BucketHeader header = bucketHeader(data, page);
+        for (std::uint32_t i = 0; i < header.count; ++i) {
+            if (keyAt(data, i) == key) {
+                value = valueAt(data, i);
+                return true;
+            }
+        }
+        page = header.overflow;
+    }
+    return false;
+}
+
+template<typename Key, typename Value>
+Value DiskHashTable<Key, Value>::get(const Key& key) const {
+    Value value;
+    if (!find(key, value)) throw std::runtime_error("key doesn't exist");
+    return value;
+}
+
+template<typename Key, typename Value>
+bool DiskHashTable<Key, Value>::contains(const Key& key) const {
+    Value value;
+    return find(key, value);
+}
+
+template<typename Key, typename Value>
+std::uint64_t DiskHashTable<Key, Value>::size() const {
+    return count;
+}
+
+template<typename Key, typename Value>
+bool DiskHashTable<Key, Value>::empty() const {
+    return count == 0;
+}
+
+template<typename Key, typename Value>
+std::uint32_t DiskHashTable<Key, Value>::globalDepth() const {
+    return depth;
+}
+
+template<typename Key, typename Value>
+std::uint32_t DiskHashTable<Key, Value>::pagesCount() const {
+    return pages;
+}
+
+template<typename Key, typename Value>
+DiskHashStats DiskHashTable<Key, Value>::stats() const {
+    DiskHashStats stats = counters;
+    stats.pageReads += pool->reads();
+    stats.pageWrites += pool->writes();
+    return stats;
+}
+
+/*endregion*/
+
+/*region Public Non-Constant Methods */
+
+template<typename Key, typename Value>
+void DiskHashTable<Key, Value>::insert(const Key& key, const Value& value) {
+    counters.inserts++;
+    std::uint64_t hash = hashOf(key);
+    while (true) {
+        std::uint32_t entry = bucketOf(hash);
+        std::uint32_t page = directory[entry];
+        std::uint32_t withRoom = NO_PAGE;
+        std::uint32_t last = page;
+        std::uint32_t localDepth = 0;
+
+        // Replace the value if the key is present, noting the first page with room otherwise
+        for (bool first = true; page != NO_PAGE; first = false) {
+            BufferPool::Page handle = pool->fetch(page);
+            char* data = handle.data();
+            BucketHeader header = bucketHeader(data, page);
+            if (first) localDepth = header.localDepth;
+            for (std::uint32_t i = 0; i < header.count; ++i) {
+                if (keyAt(data, i) == key) {
+                    write(data, i, key, value);
+                    handle.markDirty();
+                    return;
+                }
+            }
+            if (withRoom == NO_PAGE && header.count < recordsPerPage) withRoom = page;
+            last = page;
+            page = header.overflow;
+        }
+
+        if (withRoom != NO_PAGE) {
+            BufferPool::Page handle = pool->fetch(withRoom);
+            BucketHeader header = bucketHeader(handle.data(), withRoom);
+            write(handle.data(), header.count++, key, value);
+            setHeader(handle.data(), header);
+            handle.markDirty();
+            count++;
+            return;
+        }
+
+        if (localDepth < MAX_GLOBAL_DEPTH) {
+            // The records may all stay on one side, the loop splits again then
+            split(entry);
+            continue;
+        }
+
+        // Deepest bucket: chain an overflow page
+        std::uint32_t overflow = allocatePage();
+        BufferPool::Page previous = pool->fetch(last);
+        BufferPool::Page added = pool->create(overflow);
+        BucketHeader header = bucketHeader(previous.data(), last);
+        header.overflow = overflow;
+        setHeader(previous.data(), header);
+        previous.markDirty();
+
+        write(added.data(), 0, key, value);
+        setHeader(added.data(), {localDepth, 1, NO_PAGE, 0});
+        counters.overflowPages++;
+        count++;
+        return;
+    }
+}
+
+template<typename Key, typename Value>
+bool DiskHashTable<Key, Value>::remove(const Key& key) {
+    counters.removals++;
+    std::uint32_t page = directory[bucketOf(hashOf(key))];
+    while (page != NO_PAGE) {
+        BufferPool::Page handle = pool->fetch(page);
+        char* data = handle.data();
+        BucketHeader header = bucketHeader(data, page);
+        for (std::uint32_t i = 0; i < header.count; ++i) {
+            if (keyAt(data, i) == key) {
+                // The page's last record fills the hole
+                header.count--;
+                if (i != header.count) std::memcpy(record(data, i), record(data, header.count), RECORD_SIZE);
+                setHeader(data, header);
+                handle.markDirty();
+                count--;
+                return true;
+            }
+        }
+        page = header.overflow;
+    }
+    return false;
+}
+
+template<typename Key, typename Value>
+void DiskHashTable<Key, Value>::flush() {
+    pool->flush();
+    if (directoryDirty) writeDirectory();
+    writeHeader();
+    if (::fsync(fd) != 0) throw std::runtime_error("Couldn't sync hash index " + path);
+}
+
+/*endregion*/
+
+/*region Private Methods */
+
+template<typename Key, typename Value>
+void DiskHashTable<Key, Value>::create() {
+    pages = 2;
+    depth = 0;
+    directory.assign(1, 1);
+    directoryDirty = true;
+    BufferPool::Page bucket = pool->create(1);
+    setHeader(bucket.data(), {0, 0, NO_PAGE, 0});
+}
+
+template<typename Key, typename Value>
+void DiskHashTable<Key, Value>::load(std::uint64_t fileSize) {
+    FileHeader header{};
+    if (::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.keySize != sizeof(Key) || header.valueSize != sizeof(Value) ||
+        header.pageSize < sizeof(FileHeader) || header.pageSize < sizeof(BucketHeader) + 2 * RECORD_SIZE ||
+        header.globalDepth > MAX_GLOBAL_DEPTH || header.directoryPage == 0 ||
+        static_cast<std::uint64_t>(header.directoryPage) + header.directoryPages > header.pagesCount ||
+        static_cast<std::uint64_t>(header.directoryPages) * header.pageSize < (std::uint64_t{4} << header.globalDepth) ||
+        fileSize < static_cast<std::uint64_t>(header.pagesCount) * header.pageSize)
+        fail("Invalid hash index " + path);
+
+    pageSize = header.pageSize;
+    depth = header.globalDepth;
+    pages = header.pagesCount;
+    directoryPage = header.directoryPage;
+    directoryPages = header.directoryPages;
+    count = header.size;
+
+    directory.resize(std::size_t{1} << depth);
+    auto bytes = static_cast<ssize_t>(directory.size() * sizeof(std::uint32_t));
+    if (::pread(fd, directory.data(), bytes, static_cast<off_t>(directoryPage) * pageSize) != bytes)
+        fail("Invalid hash index " + path);
+    counters.pageReads += (bytes + pageSize - 1) / pageSize;
+
+    for (std::uint32_t page : directory)
+        if (page == NO_PAGE || page >= pages) fail("Invalid hash index " + path);
+}
+
+template<typename Key, typename Value>
+void DiskHashTable<Key, Value>::fail(const std::string& message) {
+    ::close(fd);
+    throw std::runtime_error(message);
+}
+
+template<typename Key, typename Value>
+std::uint64_t DiskHashTable<Key, Value>::hashOf(const Key& key) {
+    return seededHash(static_cast<std::uint64_t>(std::hash<Key>{}(key)), 0);
+}
+
+template<typename Key, typename Value>
+std::uint32_t DiskHashTable<Key, Value>::bucketOf(std::uint64_t hash) const {
+    return static_cast<std::uint32_t>(hash & ((std::uint64_t{1} << depth) - 1));
+}
+
+template<typename Key, typename Value>
+typename DiskHashTable<Key, Value>::BucketHeader DiskHashTable<Key, Value>::headerOf(const char* page) {
+    BucketHeader header;
+    std::memcpy(&header, page, sizeof(header));
+    return header;
+}
+
+template<typename Key, typename Value>
+typename DiskHashTable<Key, Value>::BucketHeader DiskHashTable<Key, Value>::bucketHeader(const char* page,
+                                                                                         std::uint32_t pageNumber) const {
+    BucketHeader header = headerOf(page);
+    if (header.count > recordsPerPage || header.localDepth > depth ||
+        (header.overflow != NO_PAGE && (header.overflow <= pageNumber || header.overflow >= pages)))
+        throw std::runtime_error("Invalid hash index " + path);
+    return header;
+}
+
+template<typename Key, typename Value>
+void DiskHashTable<Key, Value>::setHeader(char* page, const BucketHeader& header) {
+    std::memcpy(page, &header, sizeof(header));
+}
+
+template<typename Key, typename Value>
+char* DiskHashTable<Key, Value>::record(char* page, std::uint32_t index) {
+    return page + sizeof(BucketHeader) + index * RECORD_SIZE;
+}
+
+template<typename Key, typename Value>
+Key DiskHashTable<Key, Value>::keyAt(const char* page, std::uint32_t index) {
+    Key key;
+    std::memcpy(&key, page + sizeof(BucketHeader) + index * RECORD_SIZE, sizeof(Key));
+    return key;
+}
+
+template<typename Key, typename Value>
+Value DiskHashTable<Key, Value>::valueAt(const char* page, std::uint32_t index) {
+    Value value;
+    std::memcpy(&value, page + sizeof(BucketHeader) + index * RECORD_SIZE + sizeof(Key), sizeof(Value));
+    return value;
+}
+
+template<typename Key, typename Value>
+void DiskHashTable<Key, Value>::write(char* page, std::uint32_t index, const Key& key, const Value& value) {
+    std::memcpy(record(page, index), &key, sizeof(Key));
+    std::memcpy(record(page, index) + sizeof(Key), &value, sizeof(Value));
+}
+
+template<typename Key, typename Value>
+std::uint32_t DiskHashTable<Key, Value>::allocatePage() {
+    if (pages == std::numeric_limits<std::uint32_t>::max()) throw std::runtime_error("Hash index " + path + " is full");
+    return pages++;
+}
+
+template<typename Key, typename Value>
+void DiskHashTable<Key, Value>::split(std::uint32_t entry) {
+    std::uint32_t oldPage = directory[entry];
+    BufferPool::Page old = pool->fetch(oldPage);
+    BucketHeader header = bucketHeader(old.data(), oldPage);
+
+    if (header.localDepth == depth) {
+        std::size_t half = directory.size();
+        directory.resize(2 * half);
+        auto middle = directory.begin() + static_cast<std::ptrdiff_t>(half);
+        std::copy(directory.begin(), middle, middle);
+        depth++;
+        counters.directoryDoublings++;
+    }
+
+    std::uint32_t newPage = allocatePage();
+    BufferPool::Page added = pool->create(newPage);
+    std::uint64_t bit = std::uint64_t{1} << header.localDepth;
+
+    // Records with the new bit set move to the new page, the others are compacted in place
+    std::uint32_t kept = 0, moved = 0;
+    for (std::uint32_t i = 0; i < header.count; ++i) {
+        char* source = record(old.data(), i);
+        if (hashOf(keyAt(old.data(), i)) & bit) std::memcpy(record(added.data(), moved++), source, RECORD_SIZE);
+        else if (kept++ != i) std::memcpy(record(old.data(), kept - 1), source, RECORD_SIZE);
+    }
+
+    header.localDepth++;
+    header.count = kept;
+    setHeader(old.data(), header);
+    setHeader(added.data(), {header.localDepth, moved, NO_PAGE, 0});
+    old.markDirty();
+
+    // The bucket's entries are the ones matching its localDepth low bits, half of them now get the new page
+    for (std::size_t i = entry & (bit - 1); i < directory.size(); i += bit)
+        if (i & bit) directory[i] = newPage;
+    directoryDirty = true;
+    counters.splits++;
+}
+
+template<typename Key, typename Value>
+void DiskHashTable<Key, Value>::writeDirectory() {
+    std::size_t bytes = directory.size() * sizeof(std::uint32_t);
+    auto needed = static_cast<std::uint32_t>((bytes + pageSize - 1) / pageSize);
+    if (needed > directoryPages) {
+        // The directory only grows by doubling, the abandoned range is smaller than the new one
+        directoryPage = pages;
+        pages += needed;
+        directoryPages = needed;
+    }
+
+    std::vector<char> buffer(static_cast<std::size_t>(needed) * pageSize, 0);
+    std::memcpy(buffer.data(), directory.data(), bytes);
+    if (::pwrite(fd, buffer.data(), buffer.size(), static_cast<off_t>(directoryPage) * pageSize)
+        != static_cast<ssize_t>(buffer.size()))
+        throw std::runtime_error("Couldn't write the directory of hash index " + path);
+    counters.pageWrites += needed;
+    directoryDirty = false;
+}
+
+template<typename Key, typename Value>
+void DiskHashTable<Key, Value>::writeHeader() {
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.pageSize = pageSize;
+    header.keySize = sizeof(Key);
+    header.valueSize = sizeof(Value);
+    header.globalDepth = depth;
+    header.pagesCount = pages;
+    header.directoryPage = directoryPage;
+    header.directoryPages = directoryPages;
+    header.size = count;
+
+    std::vector<char> buffer(pageSize, 0);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    if (::pwrite(fd, buffer.data(), pageSize, 0) != static_cast<ssize_t>(pageSize))
+        throw std::runtime_error("Couldn't write the header of hash index " + path);
+    counters.pageWrites++;
+}
+
+/*endregion*/
+
+#endif //DSA_DISKHASHTABLE_H
@@ -5,14 +5,42 @@
  * hash table data structure. A hash table is used to store key-value pairs, allowing
  * efficient retrieval, insertion, and deletion of elements based on their unique keys.
  *
- * The implementation uses a vector of linked lists to handle collisions. When multiple
+ * The implementation uses an array of linked lists to handle collisions. When multiple
  * elements are hashed to the same index, they are stored in a linked List at that index.
+ * The list heads are kept in pages of PAGE_SIZE buckets, whose pointers the table reaches directly:
+ * a lookup loads the page of its bucket (the page pointers being few, they stay cached), the head,
+ * then walks the nodes.
  * The implementation uses a rehashing technique to keep most operations as close
  * as possible to time complexity of O(1).
  *
  * This HashTable class supports key-value pairs with generic types.
  * The hashing function used for the keys is the default std::hash function.
  *
+ * The Instrumentation policy (see Common/Instrumentation.h) is notified of node allocations,
+ * node visits, key comparisons and rehashes. The default NoInstrumentation compiles to nothing.
+ *
+ * Nodes are allocated from a std::pmr::memory_resource given at construction (the default resource
+ * otherwise). Copies use the default resource, moves carry the nodes along with their resource.
+ *
+ * enableFilter() adds a BlockedBloomFilter of the keys, checked before walking a bucket: most lookups
+ * of absent keys then cost one cache access instead of a walk through cold nodes. The filter is updated
+ * by insert(), rebuilt by rehash(), and rebuilt after many remove() calls, whose keys it can't forget.
+ *
+ * setCopyOnWrite(true) makes copies O(1): the copy shares the directory of pages and the pages
+ * (reference counted), and the first write to a shared page duplicates the heads and nodes of that
+ * page only. Shared pages are never modified,
+ * so a copy can be handed to another thread; the memory resource must then be thread-safe, since
+ * the nodes of a page are freed by whichever table releases it last.
+ *
+ * extract() unlinks a node into an owning NodeHandle, which insert() links into another table (sharing
+ * the memory resource), and merge() moves every node of another table: entries move between tables
+ * without allocating nodes nor copying keys and values.
+ *
+ * With Expiring set, every node carries a TimerHook (see Common/TimingWheel.h) and insert(key, value, ttl)
+ * gives the entry a time to live. The nodes are scheduled in a hierarchical timing wheel, so expire()
+ * and the inserts with a time to live free the expired nodes in time proportional to their number,
+ * without scanning the table. An expired key is missing for lookups even before its node is freed.
+ *
  * @note This implementation does not support duplicate keys. If the same key is inserted
  * multiple times, only the last inserted value will be stored in the hash table
  *
@@ -23,11 +51,27 @@
 #ifndef DSA_HASHTABLE_H
 #define DSA_HASHTABLE_H
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-template<typename Key,typename Value>
+#include "BlockedBloomFilter.h"
+#include "../Common/Instrumentation.h"
+#include "../Common/MemoryResource.h"
+#include "../Common/TimingWheel.h"
+
+template<typename Key,typename Value,typename Instrumentation = NoInstrumentation,bool Expiring = false>
 class HashTable {
+    struct Node;
+
 public:
+    class NodeHandle;
 
     /*region Big Five & Other Constructors*/
 
@@ -51,6 +95,14 @@ public:
 
     explicit HashTable(int size);
 
+    /**
+     * @brief Constructs an empty hash table allocating its nodes from the given memory resource.
+     *
+     * @param resource The memory resource used for node allocations. It must outlive the table.
+     * @param size Initial number of buckets.
+     */
+    explicit HashTable(std::pmr::memory_resource* resource, int size = 257);
+
     /*endregion*/
 
     /*region Constant Methods */
@@ -66,10 +118,20 @@ public:
 
 
     /**
-     * @return elements count
+     * @return elements count, including the expired keys whose nodes aren't freed yet
      * */
     [[nodiscard]] int size() const;
 
+    /**
+     * @return number of buckets, a key going to bucket std::hash(key) % bucketsCount()
+     * */
+    [[nodiscard]] int bucketsCount() const;
+
+    /**
+     * @return the memory resource the table's nodes are allocated from
+     * */
+    [[nodiscard]] std::pmr::memory_resource* getMemoryResource() const;
+
     /**
      * @brief Retrieves the value associated with the given key.
      *
@@ -80,6 +142,14 @@ public:
      */
     Value get(Key key) const;
 
+    /**
+     * @brief Looks a key up without copying its value, nor throwing if it is missing.
+     *
+     * @param key The key to search for.
+     * @return pointer to the value associated with the key, nullptr if the key isn't in the hash table.
+     */
+    const Value* find(const Key& key) const;
+
     // endregion
 
     /* region Non-Constant Methods */
@@ -94,6 +164,56 @@ public:
      */
     void insert(Key key,Value value);
 
+    /**
+     * @brief Inserts a key-value pair that expires after the given time to live.
+     *
+     * Inserting the key again replaces its time to live, or makes it permanent if none is given.
+     * The nodes of the keys expired by now are freed too.
+     * Only the tables with Expiring set support it.
+     *
+     * @param key The key of the element to be inserted.
+     * @param value The value associated with the key.
+     * @param ttl Time after which the key is missing from the table.
+     */
+    void insert(Key key, Value value, std::chrono::milliseconds ttl);
+
+    /**
+     * @brief Frees the nodes of the keys expired by now, in time proportional to their number.
+     *
+     * Does nothing if Expiring isn't set.
+     */
+    void expire();
+
+    /**
+     * @brief Links the node of a handle into the hash table, without allocating nor copying.
+     *
+     * If the key already exists in the hash table, nothing changes and the node stays in the handle.
+     *
+     * @param node The handle, extracted from a table using the same memory resource.
+     * @return true if the node was inserted (the handle is then empty), false otherwise.
+     * @throws std::invalid_argument If the node comes from another memory resource.
+     */
+    bool insert(NodeHandle&& node);
+
+    /**
+     * @brief Unlinks the node of a key from the hash table, without deallocating it.
+     *
+     * @param key The key of the node to extract.
+     * @return a handle owning the node, empty if the key isn't in the hash table.
+     */
+    NodeHandle extract(const Key& key);
+
+    /**
+     * @brief Moves the nodes of another table whose keys aren't in this one, without allocating nor copying.
+     *
+     * The nodes whose keys exist in this table stay in the other one.
+     * Pages the other table shares with copy-on-write copies are duplicated first.
+     *
+     * @param other The table to take the nodes from, using the same memory resource.
+     * @throws std::invalid_argument If the other table uses another memory resource.
+     */
+    void merge(HashTable& other);
+
     /**
      * @brief Retrieves a reference to value associated with the given key.
      *
@@ -115,18 +235,52 @@ public:
     void remove(const Key& key);
     void remove(Key && key);
 
+    /**
+     * @brief Keeps a Bloom filter of the keys, so most lookups of absent keys return without walking a bucket.
+     *
+     * @param bitsPerKey Bits of filter per bucket, 10 lets about 1% of the absent keys through.
+     */
+    void enableFilter(int bitsPerKey = 10);
+
+    /**
+     * @brief Drops the Bloom filter, if any.
+     */
+    void disableFilter();
+
+    /**
+     * @brief Makes copies of the table share its buckets, until either side writes to them.
+     *
+     * A copy then takes O(1), and the first write to a shared page of buckets duplicates that page
+     * and its nodes only. Copies are copy-on-write too, and allocate from this table's memory resource.
+     *
+     * @param enabled Whether copies share the buckets (true) or clone them all (false, the default).
+     * @throws std::logic_error If enabled with Expiring set, the nodes' timers can't be shared.
+     */
+    void setCopyOnWrite(bool enabled);
+
      // endregion
 
 private:
     /* forward declaration of data structures used as bucket */
     struct List;
-    struct Node;
+    struct Page;
+    struct Directory;
+
+    struct NoTimer {};                                  // Node base of the tables without expiry
+    using NodeBase = std::conditional_t<Expiring, TimerHook, NoTimer>;
 
     /* Private members */
+    static constexpr int PAGE_SIZE = 1024;              // Buckets per page, the unit duplicated by copy-on-write
     int capacity = 257;                                 // Default tableSize of the hash table
     int tableSize = 0;                                  // Current tableSize of the hash table
-    std::vector<List>* table = new std::vector<List>;   // Vector of linked lists (buckets) for hashing
+    Directory* directory = nullptr;                     // Pages of linked lists (buckets) for hashing
+    Page** pages = nullptr;                             // The directory's pages, read by lookups without loading it
     const int LOAD_FACTOR = 1;
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource();   // Source of the nodes memory
+    std::shared_ptr<BlockedBloomFilter> filter;         // Filter of the keys' hashes, null unless enabled
+    int removedSinceRebuild = 0;                        // Removed keys the filter still reports
+    bool copyOnWrite = false;                           // Whether copies share the pages instead of cloning them
+    std::unique_ptr<TimingWheel> wheel;                 // Expiry of the nodes, created by the first time to live
 
     /* Private Constant Methods */
 
@@ -162,11 +316,42 @@ private:
     Node * findNode(const Key &key) const;
 
     /**
-     * @brief Creates a deep copy of the table vector.
+     * @return the bucket of the given index, which mustn't be modified if it is shared (see isShared()).
+     */
+    List& bucket(std::size_t index) const;
+
+    /**
+     * @return true if the bucket of the given index is shared with a copy-on-write copy.
+     */
+    [[nodiscard]] bool isShared(std::size_t index) const;
+
+    /**
+     * @brief Creates a deep copy of the directory and its pages.
      *
-     * @return Pointer to a new table vector with a deep copy of the linked lists.
+     * @param targetResource The memory resource the copied nodes are allocated from.
+     * @return Pointer to a new directory, referenced once, with a deep copy of the linked lists.
      */
-    std::vector<HashTable<Key, Value>::List> * cloneTable() const;
+    Directory* cloneDirectory(std::pmr::memory_resource* targetResource) const;
+
+    /**
+     * @return a new directory of empty pages, each referenced once, for the given number of buckets.
+     */
+    static Directory* createDirectory(int bucketsCount);
+
+    /**
+     * @return true if the object of the reference count is referenced by another table too.
+     */
+    static bool isShared(const std::atomic<int>& references);
+
+    /**
+     * @return the current time, in milliseconds of the steady clock.
+     */
+    static std::uint64_t currentTick();
+
+    /**
+     * @return true if the node has a time to live and it is over.
+     */
+    static bool isExpired(const Node* node);
 
     /**
     * @brief Checks if a resize is needed based on the load factor.
@@ -177,11 +362,85 @@ private:
 
     /* Private Non-Constant Methods */
 
+    /**
+     * @brief Drops the table's reference to its directory, deleting the directory (and the pages only it
+     * references) if it was the last one.
+     */
+    void releaseTable();
+
+    /**
+     * @brief Drops a reference to a directory, deleting it and releasing its pages if it was the last one.
+     */
+    void releaseDirectory(Directory* shared);
+
+    /**
+     * @brief Drops a reference to a page, deleting the page and the nodes of its buckets if it was the last one.
+     */
+    void releasePage(Page* page);
+
+    /**
+     * @brief Returns the bucket of the given index, duplicating the directory, then the heads and nodes of
+     * the bucket's page, first if they are shared.
+     */
+    List& writableBucket(std::size_t index);
+
+    /**
+     * @brief Returns the filter, duplicating it first if it is shared.
+     */
+    BlockedBloomFilter& writableFilter();
+
+    /**
+     * @brief Links a node with a key absent from the table to the front of its bucket.
+     */
+    void linkNode(Node* node);
+
+    /**
+     * @brief Accounts for a key leaving the table, rebuilding the filter when it reports too many removed keys.
+     */
+    void onKeyRemoved();
+
+    /**
+     * @brief Inserts or updates a key-value pair.
+     *
+     * @return The node of the key.
+     */
+    Node* insertNode(Key key, Value value);
+
+    /**
+     * @return the node of the key, nullptr if the key is missing. A node found expired is freed.
+     */
+    Node* findLiveNode(const Key& key);
+
+    /**
+     * @brief Frees a node unlinked from its bucket, cancelling its expiry.
+     */
+    void freeNode(Node* node);
+
+    /**
+     * @brief Frees the nodes of the keys expired by the given tick.
+     */
+    void expireUntil(std::uint64_t now);
+
+    /**
+     * @brief Schedules the expiry of the node in the timing wheel, creating the wheel if needed.
+     */
+    void scheduleExpiry(Node* node, std::uint64_t expiry);
+
+    /**
+     * @brief Schedules the expiry of every node with a time to live, in a new timing wheel.
+     */
+    void scheduleAll();
+
     /**
      * @brief Performs rehashing to resize the hash table.
      */
     void rehash();
 
+    /**
+     * @brief Rebuilds the filter from the keys in the table, sized for its capacity.
+     */
+    void rebuildFilter();
+
 };
 
 /*region HashTable Bucket (custom linked List) */
@@ -195,8 +454,8 @@ private:
  * @tparam Key The type of the key.
  * @tparam Value The type of the value.
  */
-template <typename Key,typename Value>
-struct HashTable<Key,Value>::Node {
+template <typename Key,typename Value,typename Instrumentation,bool Expiring>
+struct HashTable<Key,Value,Instrumentation,Expiring>::Node : NodeBase {
     Key key;
     Value value;
     Node* next = nullptr;
@@ -208,14 +467,6 @@ struct HashTable<Key,Value>::Node {
      * @param val The value associated with the key.
      */
     Node(const Key& key, Value val) : key(key), value(val), next(nullptr) {}
-
-    Node(const Node& other){
-        key = other.key;
-        value = other.value;
-        if(other.next != nullptr)
-            next = new Node(*other.next);
-        else next = nullptr;
-    }
 };
 
 /**
@@ -224,11 +475,14 @@ struct HashTable<Key,Value>::Node {
  * This struct represents a linked list that serves as a bucket in the HashTable.
  * It contains methods for inserting, finding, and removing nodes from the list.
  *
+ * A List doesn't own its nodes: copying it only copies the head pointer, and the HashTable
+ * explicitly clones or clears its lists with the memory resource their nodes come from.
+ *
  * @tparam Key The type of the key.
  * @tparam Value The type of the value.
  */
-template <typename Key,typename Value>
-struct HashTable<Key,Value>:: List{
+template <typename Key,typename Value,typename Instrumentation,bool Expiring>
+struct HashTable<Key,Value,Instrumentation,Expiring>:: List{
     Node* head = nullptr;
 
     /**
@@ -237,31 +491,22 @@ struct HashTable<Key,Value>:: List{
     List() = default;
 
     /**
-     * @brief Copy constructor for the List struct.
-     *
-     * Initializes a new list by copying nodes from another list.
+     * @brief Creates a deep copy of the list.
      *
-     * @param other The list to be copied.
+     * @param resource The memory resource the copied nodes are allocated from.
+     * @return A new list holding copies of this list's nodes, in the same order.
      */
-    List(const List& other){
-
-        if( other.head){
-            // Call copy constructor of Node class which
-            // performs a deep copy of the other's head node
-            Node* node = new Node(*other.head);
-            head = node;
+    List clone(std::pmr::memory_resource* resource) const {
+        List copy;
+        Node** tail = &copy.head;
+
+        for (Node* node = head; node; node = node->next) {
+            Instrumentation::onAllocate(sizeof(Node));
+            *tail = newNode<Node>(resource, node->key, node->value);
+            if constexpr (Expiring) (*tail)->expiry = node->expiry;
+            tail = &(*tail)->next;
         }
-        else head = nullptr;
-
-    }
-
-    /**
-     * @brief Destructor for the List struct.
-     *
-     * Clears the linked list by deleting all nodes.
-     */
-    ~List(){
-        clear();
+        return copy;
     }
 
     /**
@@ -275,40 +520,15 @@ struct HashTable<Key,Value>:: List{
      */
     Node * findNode(const Key& key){
         Node* node = head;
-        while(node && node->key != key){
+        while(node){
+            Instrumentation::onVisit();
+            Instrumentation::onCompare();
+            if(node->key == key) break;
             node = node->next;
         }
         return node;
     };
 
-    /**
-     * @brief Finds the previous node before a given key in the linked List.
-     *
-     * This method searches the linked List for the node that comes immediately before
-     * the specified key and returns a pointer to that node. If the key is not present
-     * in the linked List, the function returns nullptr.
-     *
-     * @param key The key to search for in the linked List.
-     * @return A pointer to the node that comes before the given key,
-     *         or nullptr if the key is not found.
-     */
-    Node* findPrev(const Key& key){
-        Node* prev = nullptr;   /**< Pointer to the previous node before the key. */
-        Node* current = head;   /**< Pointer to the current node being inspected. */
-
-        while (current && current->key != key) {
-            prev = current;
-            current = current->next;
-        }
-
-        // Key not found
-        if (!current) {
-            return nullptr;
-        }
-
-        return prev;
-    }
-
     /**
      * @brief Inserts a new node with the given key and value into the linked List.
      *
@@ -317,13 +537,17 @@ struct HashTable<Key,Value>:: List{
      *
      * @param key The key of the new node to be inserted.
      * @param value The value associated with the new node.
+     * @param resource The memory resource to allocate the new node from.
+     *
+     * @return The node of the key, and true if it was added, false if an existing node was updated.
      */
-    void insert(Key key, Value value){
+    std::pair<Node*, bool> insert(Key key, Value value, std::pmr::memory_resource* resource){
 
         // linked List is empty
         if(!head){
-            head = new Node(key,value);
-            return;
+            Instrumentation::onAllocate(sizeof(Node));
+            head = newNode<Node>(resource, key, value);
+            return {head, true};
         }
 
         // key already exists in the linked lists
@@ -331,64 +555,52 @@ struct HashTable<Key,Value>:: List{
         Node* node = findNode(key);
         if(node){
             node->value = value;
-            return;
+            return {node, false};
         }
 
         // key not found
         // insert the node to the linked List start
-        node = new Node(key,value);
+        Instrumentation::onAllocate(sizeof(Node));
+        node = newNode<Node>(resource, key, value);
         node->next = head;
         head = node;
-
+        return {node, true};
     }
 
-
     /**
-     * @brief Removes a node with the given key from the linked List.
-     *
-     * If the key is not found, the function does nothing.
+     * @brief Unlinks the node with the given key from the linked List, without deleting it.
      *
-     * @param key The key of the node to be removed.
-     *
-     * @return true if key found and removed, fasle otherwise.
+     * @param key The key of the node to be unlinked.
+     * @return The unlinked node, or nullptr if the key is not found.
      */
-    bool remove(const Key& key){
-
-        // List is empty. Node doesn't exist
-        if(!head) return false;
-
-        // Node to be deleted is the list head
-        if( head->key == key){
-            auto newHead = head->next;
-            delete head;
-            head = newHead;
-            return true;
-        }
-
-        Node* prev = findPrev(key);
-
-        // If key exists, remove it
-        if(prev && prev->next)
-        {
-            auto node = prev->next;
-            prev->next = node->next;
-
-            delete node;
-            return true;
+    Node* unlink(const Key& key){
+        Node** link = &head;
+        while (*link) {
+            Instrumentation::onVisit();
+            Instrumentation::onCompare();
+            if ((*link)->key == key) {
+                Node* node = *link;
+                *link = node->next;
+                node->next = nullptr;
+                return node;
+            }
+            link = &(*link)->next;
         }
-        // If key doesn't exist, do nothing
-        return false;
+        return nullptr;
     }
 
+
     /**
      * @brief Clears the linked List by deleting all nodes.
+     *
+     * @param resource The memory resource the nodes were allocated from.
      */
-    void clear(){
-        auto& node = head;
+    void clear(std::pmr::memory_resource* resource){
+        Node* node = head;
         while (node) {
             Node* next = node->next;
-            delete node;
-            node = nullptr;
+            Instrumentation::onDeallocate(sizeof(Node));
+            deleteNode(resource, node);
             node = next;
         }
         head = nullptr;
@@ -396,117 +608,341 @@ struct HashTable<Key,Value>:: List{
 
 };
 
+/**
+ * @brief Definition of the Page struct, the heads of PAGE_SIZE consecutive buckets, owning their nodes.
+ *
+ * Copy-on-write copies share pages: a page referenced by several directories is never modified, a
+ * table writing to one of its buckets duplicates the heads and nodes of the page into a page of its own.
+ */
+template <typename Key,typename Value,typename Instrumentation,bool Expiring>
+struct HashTable<Key,Value,Instrumentation,Expiring>::Page {
+    std::atomic<int> references{1};     // Directories referencing the page
+    List heads[PAGE_SIZE];
+};
+
+/**
+ * @brief Definition of the Directory struct, the pages of the HashTable in bucket order.
+ *
+ * A copy-on-write copy shares the whole directory, which the first write duplicates (the pages it
+ * references gaining a reference each) before duplicating the page written to.
+ */
+template <typename Key,typename Value,typename Instrumentation,bool Expiring>
+struct HashTable<Key,Value,Instrumentation,Expiring>::Directory {
+    std::atomic<int> references{1};     // Tables sharing the directory
+    std::vector<Page*> pages;
+};
+
+/**
+ * @brief Definition of the NodeHandle class, owning a node extracted from a HashTable.
+ *
+ * The handle gives access to the node's key and value, and deletes the node when destroyed
+ * unless it was inserted into a table in between. Handles are movable only.
+ */
+template <typename Key,typename Value,typename Instrumentation,bool Expiring>
+class HashTable<Key,Value,Instrumentation,Expiring>::NodeHandle {
+public:
+    NodeHandle() = default;
+
+    NodeHandle(NodeHandle&& other) noexcept
+            : node(std::exchange(other.node, nullptr)), resource(other.resource) {}
+
+    NodeHandle& operator=(NodeHandle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            node = std::exchange(other.node, nullptr);
+            resource = other.resource;
+        }
+        return *this;
+    }
+
+    ~NodeHandle() { reset(); }
+
+    /**
+     * @return true if the handle owns no node.
+     */
+    [[nodiscard]] bool empty() const { return node == nullptr; }
+
+    explicit operator bool() const { return node != nullptr; }
+
+    /**
+     * @return the key of the node, which may be changed before inserting it into a table.
+     */
+    Key& key() const { return node->key; }
+
+    Value& value() const { return node->value; }
+
+private:
+    friend class HashTable;
+
+    Node* node = nullptr;
+    std::pmr::memory_resource* resource = nullptr;  // The resource the node was allocated from
+
+    NodeHandle(Node* node, std::pmr::memory_resource* resource) : node(node), resource(resource) {}
+
+    void reset() {
+        if (!node) return;
+        Instrumentation::onDeallocate(sizeof(Node));
+        deleteNode(resource, node);
+        node = nullptr;
+    }
+};
+
 /*endregion */
 
 /*region Big five & other constructors */
 
-template<typename Key, typename Value>
-HashTable<Key, Value>::HashTable() {
-    for (int i = 0; i < capacity; ++i) {
-        List list;
-        table->push_back(list);
-    }
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+HashTable<Key, Value, Instrumentation, Expiring>::HashTable() {
+    directory = createDirectory(capacity);
+    pages = directory->pages.data();
 }
 
-template<typename Key, typename Value>
-HashTable<Key, Value>::~HashTable() {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+HashTable<Key, Value, Instrumentation, Expiring>::~HashTable() {
 // Release resources owned by 'this'
-    delete table;
+    releaseTable();
 }
 
-template<typename Key, typename Value>
-HashTable<Key, Value>::HashTable(const HashTable &other) {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+HashTable<Key, Value, Instrumentation, Expiring>::HashTable(const HashTable &other) {
     tableSize = other.tableSize;
     capacity = other.capacity;
-    table = other.cloneTable();
+    copyOnWrite = other.copyOnWrite;
+    removedSinceRebuild = other.removedSinceRebuild;
+
+    if (copyOnWrite) {
+        // Share the directory, the first write will duplicate it and the page written to
+        resource = other.resource;
+        directory = other.directory;
+        directory->references.fetch_add(1, std::memory_order_relaxed);
+        filter = other.filter;
+    } else {
+        directory = other.cloneDirectory(resource);
+        if (other.filter) filter = std::make_shared<BlockedBloomFilter>(*other.filter);
+    }
+    pages = directory->pages.data();
+    if constexpr (Expiring) scheduleAll();
 }
 
-template<typename Key, typename Value>
-HashTable<Key, Value>::HashTable(HashTable &&other) noexcept : tableSize(other.tableSize), table(std::move(other.table))  {
-    other.tableSize = 0;
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+HashTable<Key, Value, Instrumentation, Expiring>::HashTable(HashTable &&other) noexcept
+        : capacity(other.capacity), tableSize(std::exchange(other.tableSize, 0)),
+          directory(std::exchange(other.directory, nullptr)), pages(std::exchange(other.pages, nullptr)),
+          resource(other.resource),
+          filter(std::move(other.filter)),
+          removedSinceRebuild(other.removedSinceRebuild), copyOnWrite(other.copyOnWrite), wheel(std::move(other.wheel)) {
 }
 
 // copy assignment operator
-template<typename Key, typename Value>
-HashTable<Key,Value> &HashTable<Key, Value>::operator=(const HashTable &other) {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+HashTable<Key,Value,Instrumentation,Expiring> &HashTable<Key, Value, Instrumentation, Expiring>::operator=(const HashTable &other) {
     if(this!= &other) {
+        // Clone first, so 'this' is left untouched if copying throws
+        Directory* directoryCopy = other.directory;
+        std::shared_ptr<BlockedBloomFilter> filterCopy = other.filter;
+        if (other.copyOnWrite) {
+            directoryCopy->references.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            directoryCopy = other.cloneDirectory(resource);
+            if (other.filter) filterCopy = std::make_shared<BlockedBloomFilter>(*other.filter);
+        }
+        releaseTable();
+
         tableSize = other.tableSize;
-        table = other.cloneTable();
-        return *this;
+        capacity = other.capacity;
+        directory = directoryCopy;
+        pages = directory->pages.data();
+        filter = std::move(filterCopy);
+        removedSinceRebuild = other.removedSinceRebuild;
+        copyOnWrite = other.copyOnWrite;
+        if (copyOnWrite) resource = other.resource;
+        if constexpr (Expiring) scheduleAll();
     }
+    return *this;
 }
 
-template<typename Key, typename Value>
-HashTable<Key,Value> &HashTable<Key, Value>::operator=(HashTable &&other) noexcept {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+HashTable<Key,Value,Instrumentation,Expiring> &HashTable<Key, Value, Instrumentation, Expiring>::operator=(HashTable &&other) noexcept {
     if (this != &other) {
         // Release resources owned by 'this'
-        for (Node* node : table) {
-            while (node) {
-                Node* next = node->next;
-                delete node;
-                node = next;
-            }
-        }
-        table->clear();
-
-        // Transfer ownership of the linked List nodes from 'other' to 'this'
-        tableSize = other.tableSize;
-        table = std::move(other.table);
-
+        releaseTable();
+
+        // Transfer ownership of the linked List nodes (and the resource they come from) from 'other' to 'this'
+        tableSize = std::exchange(other.tableSize, 0);
+        capacity = other.capacity;
+        directory = std::exchange(other.directory, nullptr);
+        pages = std::exchange(other.pages, nullptr);
+        resource = other.resource;
+        filter = std::move(other.filter);
+        removedSinceRebuild = other.removedSinceRebuild;
+        copyOnWrite = other.copyOnWrite;
+        wheel = std::move(other.wheel);
     }
     return *this;
 }
 
 
-template<typename Key, typename Value>
-HashTable<Key, Value>::HashTable(int size) :capacity(size){
-    for (int i = 0; i < capacity; ++i) {
-        auto list = new List();
-        table->push_back(list);
-    }
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+HashTable<Key, Value, Instrumentation, Expiring>::HashTable(int size) :capacity(size){
+    directory = createDirectory(capacity);
+    pages = directory->pages.data();
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+HashTable<Key, Value, Instrumentation, Expiring>::HashTable(std::pmr::memory_resource *resource, int size)
+        : capacity(size), resource(resource) {
+    directory = createDirectory(capacity);
+    pages = directory->pages.data();
 }
 /*endregion*/
 
 /*region Public Non-Constant Methods */
 
-template<typename Key, typename Value>
-Value &HashTable<Key, Value>::operator[](const Key &key) {
-    auto node = findNode(key);
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+Value &HashTable<Key, Value, Instrumentation, Expiring>::operator[](const Key &key) {
+    auto bucketIndex = hashFunction(key) % capacity;
+    auto node = bucket(bucketIndex).findNode(key);
 
-    if (node)
-        return node->value;
-    else {
+    if (!node || isExpired(node)) {
         throw std::runtime_error("key doesn't exist");
     }
+
+    // The value can be modified through the reference, so it can't stay in a shared page
+    if (isShared(bucketIndex)) node = writableBucket(bucketIndex).findNode(key);
+    return node->value;
 }
 
-template<typename Key, typename Value>
-void HashTable<Key, Value>::insert( Key key, Value value) {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::insert( Key key, Value value) {
+    Node* node = insertNode(key, value);
 
-    // locate the bucket to insert in
-    size_t bucketIndex = hashFunction(key) % capacity;
-    auto& list = (*table)[bucketIndex];
+    // An existing key inserted without a time to live becomes permanent
+    if constexpr (Expiring) {
+        if (wheel) wheel->cancel(node);
+        node->expiry = TimerHook::NEVER;
+    }
+}
 
-    list.insert(key,value);
-    tableSize++;
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::insert(Key key, Value value, std::chrono::milliseconds ttl) {
+    static_assert(Expiring, "Only the hash tables with Expiring set support a time to live.");
 
-    // if
-    if(needResize()) {
-        rehash();
+    Node* node = insertNode(key, value);
+    auto now = currentTick();
+    auto ticks = std::max<std::chrono::milliseconds::rep>(ttl.count(), 0);
+    scheduleExpiry(node, now + static_cast<std::uint64_t>(ticks));
+
+    // Free the expired nodes as the table is written, rather than scanning it later
+    expireUntil(now);
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::expire() {
+    expireUntil(currentTick());
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::expireUntil(std::uint64_t now) {
+    if constexpr (Expiring) {
+        if (!wheel) return;
+        wheel->advance(now, [this](TimerHook* hook) {
+            auto node = static_cast<Node*>(hook);
+            writableBucket(hashFunction(node->key) % capacity).unlink(node->key);
+            freeNode(node);
+        });
     }
 }
 
-template<typename Key, typename Value>
-void HashTable<Key, Value>::remove(const Key &key) {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::remove(const Key &key) {
     auto bucketIndex = hashFunction(key) % capacity;
 
-    bool removed = (*table)[bucketIndex].remove(key);
+    // Don't duplicate a shared page for a key it doesn't hold
+    if (isShared(bucketIndex) && !bucket(bucketIndex).findNode(key)) return;
+
+    Node* node = writableBucket(bucketIndex).unlink(key);
+    if (node) freeNode(node);
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+bool HashTable<Key, Value, Instrumentation, Expiring>::insert(NodeHandle &&node) {
+    if (node.empty()) return false;
+    if (node.resource != resource)
+        throw std::invalid_argument("The node was allocated from another memory resource.");
+
+    if (findLiveNode(node.key())) return false;
+
+    linkNode(std::exchange(node.node, nullptr));
+    return true;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+typename HashTable<Key, Value, Instrumentation, Expiring>::NodeHandle HashTable<Key, Value, Instrumentation, Expiring>::extract(const Key &key) {
+    // Don't duplicate a shared page for a key it doesn't hold
+    if (!findNode(key)) return NodeHandle();
+
+    Node* node = writableBucket(hashFunction(key) % capacity).unlink(key);
+    tableSize--;
+    onKeyRemoved();
+
+    // The node keeps its expiry, to be scheduled again by the table it's inserted into
+    if constexpr (Expiring) {
+        if (wheel) wheel->cancel(node);
+    }
+    return NodeHandle(node, resource);
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::merge(HashTable &other) {
+    if (this == &other) return;
+    if (other.resource != resource)
+        throw std::invalid_argument("Can't merge tables using different memory resources.");
+
+    for (int index = 0; index < other.capacity; ++index) {
+        if (!other.bucket(index).head) continue;
+
+        // Each node is unlinked from the other table, unless its key is in this one
+        Node** link = &other.writableBucket(index).head;
+        while (*link) {
+            Node* node = *link;
+            if (findLiveNode(node->key)) {
+                link = &node->next;
+                continue;
+            }
+
+            *link = node->next;
+            other.tableSize--;
+            if constexpr (Expiring) {
+                if (other.wheel) other.wheel->cancel(node);
+            }
+            linkNode(node);
+        }
+    }
+
+    // The other table's filter reports the moved keys until rebuilt
+    if (other.filter) other.rebuildFilter();
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::enableFilter(int bitsPerKey) {
+    filter = std::make_shared<BlockedBloomFilter>(0, bitsPerKey);
+    rebuildFilter();
+}
 
-    if(removed) tableSize--;
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::disableFilter() {
+    filter.reset();
 }
 
-template<typename Key, typename Value>
-void HashTable<Key, Value>::remove(Key && key) {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::setCopyOnWrite(bool enabled) {
+    if (Expiring && enabled)
+        throw std::logic_error("The nodes of a hash table with expiring keys can't be shared.");
+    copyOnWrite = enabled;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::remove(Key && key) {
     remove(key);
 }
 
@@ -514,34 +950,57 @@ void HashTable<Key, Value>::remove(Key && key) {
 
 /* region Private Constant Methods */
 
-template<typename Key, typename Value>
-std::vector<typename HashTable<Key, Value>::List> * HashTable<Key, Value>::cloneTable() const {
-    // Create a new vector to hold the cloned lists
-    auto tableClone = new std::vector<List>();
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+typename HashTable<Key, Value, Instrumentation, Expiring>::Directory *
+HashTable<Key, Value, Instrumentation, Expiring>::cloneDirectory(std::pmr::memory_resource* targetResource) const {
+    // Create a new directory of pages holding a deep copy of every list
+    auto directoryClone = createDirectory(capacity);
+    for (int i = 0; i < capacity; ++i) {
+        directoryClone->pages[i / PAGE_SIZE]->heads[i % PAGE_SIZE] = bucket(i).clone(targetResource);
+    }
+    return directoryClone;
+}
 
-    // Iterate over the original table vector
-    for (auto& list : *table) {
-        // Use the List copy constructor to create a deep copy of the current list
-        List listClone(list);
-        tableClone->push_back(listClone);
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+typename HashTable<Key, Value, Instrumentation, Expiring>::Directory *
+HashTable<Key, Value, Instrumentation, Expiring>::createDirectory(int bucketsCount) {
+    auto newDirectory = new Directory;
+    int pagesCount = (bucketsCount + PAGE_SIZE - 1) / PAGE_SIZE;
+    for (int i = 0; i < pagesCount; ++i) {
+        newDirectory->pages.push_back(new Page);
     }
+    return newDirectory;
+}
 
-    // Return the cloned vector of lists
-    return tableClone;
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+typename HashTable<Key, Value, Instrumentation, Expiring>::List &
+HashTable<Key, Value, Instrumentation, Expiring>::bucket(std::size_t index) const {
+    return pages[index / PAGE_SIZE]->heads[index % PAGE_SIZE];
 }
 
-template<typename Key, typename Value>
-bool HashTable<Key, Value>::contains(const Key &key) const {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+bool HashTable<Key, Value, Instrumentation, Expiring>::isShared(std::size_t index) const {
+    return isShared(directory->references) || isShared(pages[index / PAGE_SIZE]->references);
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+bool HashTable<Key, Value, Instrumentation, Expiring>::isShared(const std::atomic<int> &references) {
+    // Acquire, so a write following a "not shared" answer happens after the reads of the tables that dropped theirs
+    return references.load(std::memory_order_acquire) != 1;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+bool HashTable<Key, Value, Instrumentation, Expiring>::contains(const Key &key) const {
     return findNode(key) != nullptr;
 }
 
-template<typename Key, typename Value>
-bool HashTable<Key, Value>::contains(Key &&key) const {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+bool HashTable<Key, Value, Instrumentation, Expiring>::contains(Key &&key) const {
     return findNode(std::move(key)) != nullptr;
 }
 
-template<typename Key, typename Value>
-std::size_t HashTable<Key, Value>::hashFunction(const Key& key) const {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+std::size_t HashTable<Key, Value, Instrumentation, Expiring>::hashFunction(const Key& key) const {
     // Use std::hash to generate the hash code of the key
     std::hash<Key> hashFunc;
     size_t hashCode = hashFunc(key);
@@ -549,20 +1008,40 @@ std::size_t HashTable<Key, Value>::hashFunction(const Key& key) const {
     return hashCode;
 }
 
-template<typename Key, typename Value>
-typename HashTable<Key, Value>::Node * HashTable<Key, Value>::findNode(const Key &key) const {
-    int index = hashFunction(key) % capacity;
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+typename HashTable<Key, Value, Instrumentation, Expiring>::Node * HashTable<Key, Value, Instrumentation, Expiring>::findNode(const Key &key) const {
+    size_t hashCode = hashFunction(key);
+    if (filter && !filter->mayContain(hashCode)) return nullptr;
+
+    int index = hashCode % capacity;
 
-    return (*table)[index].findNode(key);
+    Node* node = bucket(index).findNode(key);
+    return node && !isExpired(node) ? node : nullptr;
 }
 
-template<typename Key, typename Value>
-int HashTable<Key, Value>::size() const {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+int HashTable<Key, Value, Instrumentation, Expiring>::size() const {
     return tableSize;
 }
 
-template<typename Key, typename Value>
-Value HashTable<Key, Value>::get(Key key) const {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+int HashTable<Key, Value, Instrumentation, Expiring>::bucketsCount() const {
+    return capacity;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+std::pmr::memory_resource *HashTable<Key, Value, Instrumentation, Expiring>::getMemoryResource() const {
+    return resource;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+const Value *HashTable<Key, Value, Instrumentation, Expiring>::find(const Key &key) const {
+    auto node = findNode(key);
+    return node ? &node->value : nullptr;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+Value HashTable<Key, Value, Instrumentation, Expiring>::get(Key key) const {
     auto node = findNode(key);
 
     if (node)
@@ -576,8 +1055,8 @@ Value HashTable<Key, Value>::get(Key key) const {
 
 /*region Private Non-Constant methods */
 
-template<typename Key, typename Value>
-void HashTable<Key, Value>::rehash() {
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::rehash() {
     /*
      * new table tableSize = next prime greater than double initial tableSize
      * create a new HashTable with the new table tableSize
@@ -585,44 +1064,224 @@ void HashTable<Key, Value>::rehash() {
      * use copy assignment operator to update the hashtable
      * */
 
+    Instrumentation::onRehash();
+
     int newCapacity = nextPrime(capacity *2);
+    auto newDirectory = createDirectory(newCapacity);
+
+    // Keys are unique, so each node is relinked to the front of its new bucket
+    // without searching it, nor reallocating the node.
+    // The nodes of shared pages belong to other tables too, they are copied instead.
+    for (int index = 0; index < capacity; ++index) {
+        bool pageShared = isShared(index);
+        Node* node = bucket(index).head;
+
+        while(node){
+            auto newIndex = hashFunction(node->key) % newCapacity;
+            List& newBucket = newDirectory->pages[newIndex / PAGE_SIZE]->heads[newIndex % PAGE_SIZE];
+
+            auto next = node->next;
+            Node* moved = node;
+            if (pageShared) {
+                Instrumentation::onAllocate(sizeof(Node));
+                moved = newNode<Node>(resource, node->key, node->value);
+            }
+            moved->next = newBucket.head;
+            newBucket.head = moved;
+            node = next;
+        }
+
+        // The relinked nodes now belong to the new pages
+        if (!pageShared) bucket(index).head = nullptr;
+    }
+
+    releaseTable();
     capacity = newCapacity;
+    directory = newDirectory;
+    pages = directory->pages.data();
+
+    if (filter) rebuildFilter();
+}
 
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::rebuildFilter() {
+    // Sized for the capacity, the most keys the table holds before its next rehash
+    filter = std::make_shared<BlockedBloomFilter>(capacity, filter->getBitsPerKey());
+    for (int index = 0; index < capacity; ++index)
+        for (Node* node = bucket(index).head; node; node = node->next)
+            filter->insert(hashFunction(node->key));
+    removedSinceRebuild = 0;
+}
 
-    auto newTable = new std::vector<List> (newCapacity);
-    for (int i = 0; i < newCapacity; ++i) {
-        (*newTable)[i] = List();
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+typename HashTable<Key, Value, Instrumentation, Expiring>::List &
+HashTable<Key, Value, Instrumentation, Expiring>::writableBucket(std::size_t index) {
+    if (isShared(directory->references)) {
+        // A directory of this table's own, its pages gaining a reference before the shared one loses its own
+        auto directoryCopy = new Directory;
+        directoryCopy->pages = directory->pages;
+        for (Page* page: directoryCopy->pages) page->references.fetch_add(1, std::memory_order_relaxed);
+        releaseDirectory(directory);
+        directory = directoryCopy;
+        pages = directory->pages.data();
     }
 
-    for (List& list: *table) {
-        Node* node = list.head;
+    Page*& page = pages[index / PAGE_SIZE];
+    if (isShared(page->references)) {
+        // Copy the page's lists before dropping the reference, which may free the shared nodes
+        auto pageCopy = new Page;
+        for (int i = 0; i < PAGE_SIZE; ++i) {
+            pageCopy->heads[i] = page->heads[i].clone(resource);
+        }
+        releasePage(page);
+        page = pageCopy;
+    }
+    return page->heads[index % PAGE_SIZE];
+}
 
-        while(node){
-            auto newIndex = hashFunction(node->key) % newCapacity;
-            List& bucket = (*newTable)[newIndex];
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::linkNode(Node *node) {
+    size_t hashCode = hashFunction(node->key);
+    List& list = writableBucket(hashCode % capacity);
+    node->next = list.head;
+    list.head = node;
 
-            (*newTable)[newIndex].insert(node->key,node->value);
+    tableSize++;
+    if (filter) writableFilter().insert(hashCode);
+    if constexpr (Expiring) {
+        if (node->expiry != TimerHook::NEVER) scheduleExpiry(node, node->expiry);
+    }
+    if (needResize()) rehash();
+}
 
-            auto next = node->next;
-            delete node;
-            node = next;
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+typename HashTable<Key, Value, Instrumentation, Expiring>::Node *
+HashTable<Key, Value, Instrumentation, Expiring>::insertNode(Key key, Value value) {
+
+    // locate the bucket to insert in
+    size_t hashCode = hashFunction(key);
+    size_t bucketIndex = hashCode % capacity;
+    auto& list = writableBucket(bucketIndex);
+
+    auto [node, inserted] = list.insert(key,value,resource);
+    if (!inserted) return node;
+    tableSize++;
+    if (filter) writableFilter().insert(hashCode);
+
+    // Rehashing relinks the nodes, the node stays valid
+    if(needResize()) {
+        rehash();
+    }
+    return node;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+typename HashTable<Key, Value, Instrumentation, Expiring>::Node *
+HashTable<Key, Value, Instrumentation, Expiring>::findLiveNode(const Key &key) {
+    size_t hashCode = hashFunction(key);
+    if (filter && !filter->mayContain(hashCode)) return nullptr;
+
+    Node* node = bucket(hashCode % capacity).findNode(key);
+    if (node && isExpired(node)) {
+        writableBucket(hashCode % capacity).unlink(key);
+        freeNode(node);
+        return nullptr;
+    }
+    return node;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::freeNode(Node *node) {
+    if constexpr (Expiring) {
+        if (wheel) wheel->cancel(node);
+    }
+    Instrumentation::onDeallocate(sizeof(Node));
+    deleteNode(resource, node);
+    tableSize--;
+    onKeyRemoved();
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::scheduleExpiry(Node *node, std::uint64_t expiry) {
+    if (!wheel) wheel = std::make_unique<TimingWheel>(currentTick());
+    wheel->cancel(node);
+    wheel->schedule(node, expiry);
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::scheduleAll() {
+    wheel.reset();
+    for (int index = 0; index < capacity; ++index)
+        for (Node* node = bucket(index).head; node; node = node->next)
+            if (node->expiry != TimerHook::NEVER) scheduleExpiry(node, node->expiry);
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+std::uint64_t HashTable<Key, Value, Instrumentation, Expiring>::currentTick() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+bool HashTable<Key, Value, Instrumentation, Expiring>::isExpired(const Node *node) {
+    if constexpr (Expiring) return node->expiry != TimerHook::NEVER && node->expiry <= currentTick();
+    else return false;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::onKeyRemoved() {
+    // The filter keeps reporting removed keys, rebuild it before they make it useless
+    if (filter && ++removedSinceRebuild > capacity / 4) rebuildFilter();
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+BlockedBloomFilter &HashTable<Key, Value, Instrumentation, Expiring>::writableFilter() {
+    if (filter.use_count() > 1) filter = std::make_shared<BlockedBloomFilter>(*filter);
+    // Orders the writes after the reads of the tables that shared the filter
+    else std::atomic_thread_fence(std::memory_order_acquire);
+    return *filter;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::releaseTable() {
+    if(!directory) return;
+
+    releaseDirectory(directory);
+    directory = nullptr;
+    pages = nullptr;
+}
+
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::releaseDirectory(Directory *shared) {
+    if (shared->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        for (Page* page: shared->pages) {
+            releasePage(page);
         }
+        delete shared;
     }
+}
 
-    table = newTable;
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+void HashTable<Key, Value, Instrumentation, Expiring>::releasePage(Page *page) {
+    if (page->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        for (List& list: page->heads) {
+            list.clear(resource);
+        }
+        delete page;
+    }
 }
 
 /*endregion*/
 
 /* region Static Private Methods */
 
-template<typename Key,typename Value>
-bool HashTable<Key,Value>::needResize() const {
+template<typename Key,typename Value,typename Instrumentation,bool Expiring>
+bool HashTable<Key,Value,Instrumentation,Expiring>::needResize() const {
     return float(tableSize) / capacity >= 1;
 }
 
-template<typename Key, typename Value>
-int HashTable<Key,Value>::isPrime(int n){
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+int HashTable<Key,Value,Instrumentation,Expiring>::isPrime(int n){
     if (n <= 1) {
         return false;
     }
@@ -644,8 +1303,8 @@ int HashTable<Key,Value>::isPrime(int n){
     return true;
 };
 
-template<typename Key, typename Value>
-int HashTable<Key,Value>::nextPrime(int n){
+template<typename Key, typename Value, typename Instrumentation, bool Expiring>
+int HashTable<Key,Value,Instrumentation,Expiring>::nextPrime(int n){
     if (n <= 1) {
         return 2;
     }
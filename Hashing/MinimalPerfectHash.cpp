@@ -0,0 +1,219 @@
+/**
+ * @file MinimalPerfectHash.cpp
+ * @brief Implementation of the MinimalPerfectHash class.
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include "MinimalPerfectHash.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+#include "SeededHash.h"
+#include "../Common/TaskScheduler.h"
+
+namespace {
+    const char MAGIC[8] = {'D', 'S', 'A', 'M', 'P', 'H', 'F', '1'};
+
+    // Keys handled by a task while building
+    const std::size_t CHUNK_SIZE = 1 << 14;
+
+    int popCount(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#else
+        int count = 0;
+        for (; word; word &= word - 1) count++;
+        return count;
+#endif
+    }
+
+    template<typename T>
+    void write(std::ostream& stream, const T& value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template<typename T>
+    T read(std::istream& stream) {
+        T value{};
+        if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+            throw std::runtime_error("Invalid minimal perfect hash.");
+        return value;
+    }
+
+    /**
+     * @brief Calls body(chunk, begin, end) for consecutive chunks of [0, count), in parallel if a scheduler is given.
+     */
+    template<typename Body>
+    void forEachChunk(std::size_t count, TaskScheduler* scheduler, Body body) {
+        std::size_t chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        auto runChunk = [&](std::size_t chunk) {
+            body(chunk, chunk * CHUNK_SIZE, std::min(count, (chunk + 1) * CHUNK_SIZE));
+        };
+
+        if (scheduler && chunks > 1) scheduler->parallelFor<std::size_t>(0, chunks, runChunk, 1);
+        else for (std::size_t chunk = 0; chunk < chunks; ++chunk) runChunk(chunk);
+    }
+}
+
+/* region Constructors */
+
+MinimalPerfectHash::MinimalPerfectHash(const std::vector<std::uint64_t>& fingerprints, TaskScheduler* scheduler)
+        : keysCount(fingerprints.size()) {
+    std::vector<std::uint64_t> keys = fingerprints;
+    levelOffsets.push_back(0);
+
+    for (int level = 0; !keys.empty(); ++level) {
+        // Equal fingerprints collide at every level
+        if (level == MAX_LEVELS)
+            throw std::invalid_argument("Duplicate keys, can't build a minimal perfect hash function.");
+
+        std::uint64_t levelSize = (keys.size() + 63) / 64 * 64;
+        std::size_t wordsCount = levelSize / 64;
+
+        // Mark the positions reached by at least one key, and those reached by more than one
+        std::vector<std::atomic<std::uint64_t>> reached(wordsCount);
+        std::vector<std::atomic<std::uint64_t>> collided(wordsCount);
+        forEachChunk(keys.size(), scheduler, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                auto bit = position(keys[i], level, levelSize);
+                auto mask = std::uint64_t(1) << (bit % 64);
+                if (reached[bit / 64].fetch_or(mask, std::memory_order_relaxed) & mask)
+                    collided[bit / 64].fetch_or(mask, std::memory_order_relaxed);
+            }
+        });
+
+        // Keep the positions of the keys placed at this level
+        std::size_t levelStart = bits.size();
+        bits.resize(levelStart + wordsCount);
+        for (std::size_t word = 0; word < wordsCount; ++word)
+            bits[levelStart + word] = reached[word].load(std::memory_order_relaxed) & ~collided[word].load(std::memory_order_relaxed);
+        levelOffsets.push_back(levelOffsets.back() + levelSize);
+
+        // The keys that collided go on to the next level
+        std::vector<std::vector<std::uint64_t>> remaining((keys.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+        forEachChunk(keys.size(), scheduler, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                auto bit = position(keys[i], level, levelSize);
+                if (collided[bit / 64].load(std::memory_order_relaxed) & (std::uint64_t(1) << (bit % 64)))
+                    remaining[chunk].push_back(keys[i]);
+            }
+        });
+
+        keys.clear();
+        for (const auto& chunkKeys : remaining)
+            keys.insert(keys.end(), chunkKeys.begin(), chunkKeys.end());
+    }
+
+    computeRanks();
+}
+
+/* endregion */
+
+/* region Public Methods */
+
+std::uint64_t MinimalPerfectHash::index(std::uint64_t fingerprint) const {
+    int levelsCount = static_cast<int>(levelOffsets.size()) - 1;
+    for (int level = 0; level < levelsCount; ++level) {
+        auto bit = levelOffsets[level] + position(fingerprint, level, levelOffsets[level + 1] - levelOffsets[level]);
+        if (bits[bit / 64] & (std::uint64_t(1) << (bit % 64)))
+            return rank(bit);
+    }
+    return NOT_FOUND;
+}
+
+std::uint64_t MinimalPerfectHash::size() const {
+    return keysCount;
+}
+
+double MinimalPerfectHash::bitsPerKey() const {
+    if (keysCount == 0) return 0;
+    auto words = bits.size() + blockRanks.size() + levelOffsets.size();
+    return static_cast<double>(words * 64) / keysCount;
+}
+
+void MinimalPerfectHash::save(std::ostream &stream) const {
+    stream.write(MAGIC, sizeof(MAGIC));
+    write<std::uint64_t>(stream, keysCount);
+    write<std::uint64_t>(stream, levelOffsets.size());
+    for (auto offset : levelOffsets) write(stream, offset);
+    for (auto word : bits) write(stream, word);
+}
+
+MinimalPerfectHash MinimalPerfectHash::load(std::istream &stream) {
+    char magic[sizeof(MAGIC)] = {};
+    if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::runtime_error("Invalid minimal perfect hash.");
+
+    MinimalPerfectHash hash;
+    hash.keysCount = read<std::uint64_t>(stream);
+
+    auto offsetsCount = read<std::uint64_t>(stream);
+    if (offsetsCount == 0 || offsetsCount > MAX_LEVELS + 1) throw std::runtime_error("Invalid minimal perfect hash.");
+    for (std::uint64_t i = 0; i < offsetsCount; ++i) {
+        auto offset = read<std::uint64_t>(stream);
+        bool increasing = hash.levelOffsets.empty() ? offset == 0 : offset > hash.levelOffsets.back();
+        if (!increasing || offset % 64 != 0) throw std::runtime_error("Invalid minimal perfect hash.");
+        hash.levelOffsets.push_back(offset);
+    }
+
+    // Read word by word, so a corrupted offset fails at the end of the stream instead of allocating
+    for (std::uint64_t i = 0; i < hash.levelOffsets.back() / 64; ++i)
+        hash.bits.push_back(read<std::uint64_t>(stream));
+
+    hash.computeRanks();
+    if (hash.rank(hash.levelOffsets.back()) != hash.keysCount) throw std::runtime_error("Invalid minimal perfect hash.");
+
+    return hash;
+}
+
+/* endregion */
+
+/* region Private Methods */
+
+std::uint64_t MinimalPerfectHash::position(std::uint64_t fingerprint, int level, std::uint64_t levelSize) {
+    auto hash = seededHash(fingerprint, static_cast<std::uint64_t>(level));
+
+    // Maps the hash to [0, levelSize) with a multiplication instead of a division
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 Product;
+    return static_cast<std::uint64_t>((static_cast<Product>(hash) * levelSize) >> 64);
+#else
+    // High half of the 128 bit product from 32 bit halves, so saved files don't depend on the compiler
+    std::uint64_t hashLow = hash & 0xFFFFFFFF, hashHigh = hash >> 32;
+    std::uint64_t sizeLow = levelSize & 0xFFFFFFFF, sizeHigh = levelSize >> 32;
+    std::uint64_t low = hashLow * sizeLow, middle = hashHigh * sizeLow, other = hashLow * sizeHigh;
+    std::uint64_t carry = ((low >> 32) + (middle & 0xFFFFFFFF) + (other & 0xFFFFFFFF)) >> 32;
+    return hashHigh * sizeHigh + (middle >> 32) + (other >> 32) + carry;
+#endif
+}
+
+std::uint64_t MinimalPerfectHash::rank(std::uint64_t bit) const {
+    const std::uint64_t wordsPerBlock = BLOCK_BITS / 64;
+
+    std::uint64_t word = bit / 64;
+    std::uint64_t count = blockRanks[bit / BLOCK_BITS];
+    for (std::uint64_t i = bit / BLOCK_BITS * wordsPerBlock; i < word; ++i)
+        count += popCount(bits[i]);
+
+    if (bit % 64) count += popCount(bits[word] << (64 - bit % 64));
+    return count;
+}
+
+void MinimalPerfectHash::computeRanks() {
+    const std::size_t wordsPerBlock = BLOCK_BITS / 64;
+
+    // One more block than needed, so the rank of the bit past the end can be computed
+    blockRanks.assign(bits.size() / wordsPerBlock + 1, 0);
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i < bits.size(); ++i) {
+        if (i % wordsPerBlock == 0) blockRanks[i / wordsPerBlock] = count;
+        count += popCount(bits[i]);
+    }
+    if (bits.size() % wordsPerBlock == 0) blockRanks.back() = count;
+}
+
+/* endregion */
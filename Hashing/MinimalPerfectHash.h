@@ -0,0 +1,95 @@
+/**
+ * @file MinimalPerfectHash.h
+ * @brief Declaration of the MinimalPerfectHash class, a minimal perfect hash function of a fixed key set.
+ *
+ * Built from n distinct keys, a MinimalPerfectHash maps each of them to a distinct index in [0, n),
+ * using about 3 bits per key whatever the keys' size. It follows BBHash ("fast and scalable minimal
+ * perfect hashing for massive key sets"):
+ *  - Level 0 is a bit array of n bits. Every key is hashed to a position; the bits of positions
+ *    reached by exactly one key are set, and the keys that collided go on to the next level.
+ *  - Each level is a bit array as large as the number of keys reaching it, hashed with another seed,
+ *    until no key is left (about 37% of the keys collide at each level).
+ *  - The index of a key is the rank (number of set bits before it) of the first set bit it hashes to.
+ * A lookup hashes the key level after level (1.6 levels on average) and ranks the bit in O(1)
+ * with a count of the set bits stored every 512 bits.
+ *
+ * Keys are given as 64 bit fingerprints (see PerfectHashTable.h), so the class is independent of the key type.
+ * Keys outside the set get an arbitrary index or NOT_FOUND; callers that may look them up must
+ * compare the key stored at the index.
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_MINIMALPERFECTHASH_H
+#define DSA_MINIMALPERFECTHASH_H
+
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+class TaskScheduler;
+
+class MinimalPerfectHash {
+public:
+    static constexpr std::uint64_t NOT_FOUND = std::numeric_limits<std::uint64_t>::max();
+
+    MinimalPerfectHash() = default;
+
+    /**
+     * @brief Builds the hash function of the given keys.
+     *
+     * @param fingerprints 64 bit fingerprints of the keys, all distinct.
+     * @param scheduler If not null, the levels are built in parallel on it.
+     * @throws std::invalid_argument If two fingerprints are equal.
+     */
+    explicit MinimalPerfectHash(const std::vector<std::uint64_t>& fingerprints, TaskScheduler* scheduler = nullptr);
+
+    /**
+     * @return the index in [0, size()) of a key of the set, NOT_FOUND or any index for other keys.
+     */
+    [[nodiscard]] std::uint64_t index(std::uint64_t fingerprint) const;
+
+    /**
+     * @return number of keys.
+     */
+    [[nodiscard]] std::uint64_t size() const;
+
+    /**
+     * @return memory used by the hash function, in bits per key.
+     */
+    [[nodiscard]] double bitsPerKey() const;
+
+    /**
+     * @brief Writes the hash function to a binary stream.
+     */
+    void save(std::ostream& stream) const;
+
+    /**
+     * @brief Reads a hash function written by save().
+     * @throws std::runtime_error If the stream doesn't hold a valid hash function.
+     */
+    static MinimalPerfectHash load(std::istream& stream);
+
+private:
+    // Bits of a rank block, the set bits before each block are counted in blockRanks
+    static const int BLOCK_BITS = 512;
+    static const int MAX_LEVELS = 64;
+
+    std::uint64_t keysCount = 0;
+    std::vector<std::uint64_t> levelOffsets; // first bit of each level in bits, and the total as last element
+    std::vector<std::uint64_t> bits;         // the levels' bit arrays, one after the other
+    std::vector<std::uint64_t> blockRanks;
+
+    static std::uint64_t position(std::uint64_t fingerprint, int level, std::uint64_t levelSize);
+
+    /**
+     * @return number of set bits before the given bit.
+     */
+    [[nodiscard]] std::uint64_t rank(std::uint64_t bit) const;
+
+    void computeRanks();
+};
+
+#endif //DSA_MINIMALPERFECTHASH_H
@@ -0,0 +1,266 @@
+/**
+ * @file PerfectHashTable.h
+ * @brief Immutable hash table of a fixed key set, indexed by a minimal perfect hash function.
+ *
+ * When the keys are known up front but only at run time (a dictionary file, the symbols of a
+ * loaded module, ...) and too many for a StaticHashTable, a PerfectHashTable replaces a HashTable:
+ * the entries are stored in an array permuted by a MinimalPerfectHash, so a lookup is
+ * one hash of the key, one or two bit probes and a single key comparison, with no chain to follow
+ * and no memory beyond the entries and about 3 bits per key.
+ *
+ * The hash function indexes 64 bit fingerprints of the keys. Distinct keys sharing a fingerprint
+ * (keys whose std::hash collide, or a 64 bit collision of strings) can't all be indexed: the first
+ * one is, the others are kept in a small array sorted by fingerprint, searched only when the indexed
+ * entry isn't the key looked up. Finding the keys of a shared fingerprint compares them pairwise, so
+ * the build is quadratic in the size of the largest such group, as HashTable is with colliding hashes.
+ *
+ * The table is built once from all its entries (in parallel when given a TaskScheduler), and can be
+ * saved and loaded when the keys and values are std::string or trivially copyable.
+ *
+ * Usage example:
+ * --------------
+ * auto table = PerfectHashTable<std::string, int>::build({{"one", 1}, {"two", 2}, {"three", 3}});
+ * table.get("two"); // 2
+ * table.contains("four"); // false
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_PERFECTHASHTABLE_H
+#define DSA_PERFECTHASHTABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "MinimalPerfectHash.h"
+#include "SeededHash.h"
+
+template<typename Key, typename Value>
+class PerfectHashTable {
+public:
+    PerfectHashTable() = default;
+
+    /**
+     * @brief Builds the table of the given entries.
+     *
+     * @param entries The key-value pairs.
+     * @param scheduler If not null, the hash function is built in parallel on it.
+     * @throws std::invalid_argument If a key appears twice (equal keys, not only equal fingerprints).
+     */
+    static PerfectHashTable build(std::vector<std::pair<Key, Value>> entries, TaskScheduler* scheduler = nullptr);
+
+    /**
+     * @return the value of the key, nullptr if the key isn't in the table.
+     */
+    const Value* find(const Key& key) const;
+
+    [[nodiscard]] bool contains(const Key& key) const { return find(key) != nullptr; }
+
+    /**
+     * @return copy of the value of the key.
+     * @throws std::runtime_error If the key isn't in the table.
+     */
+    Value get(const Key& key) const;
+
+    [[nodiscard]] std::size_t size() const { return entries.size() + collisions.size(); }
+
+    /**
+     * @return memory used by the hash function, in bits per key (the entries excluded).
+     */
+    [[nodiscard]] double bitsPerKey() const { return hash.bitsPerKey(); }
+
+    /**
+     * @brief Writes the table to a binary stream.
+     */
+    void save(std::ostream& stream) const;
+
+    /**
+     * @brief Reads a table written by save().
+     * @throws std::runtime_error If the stream doesn't hold a valid table.
+     */
+    static PerfectHashTable load(std::istream& stream);
+
+private:
+    struct Collision {
+        std::uint64_t fingerprint;
+        std::pair<Key, Value> entry;
+    };
+
+    MinimalPerfectHash hash;
+    std::vector<std::pair<Key, Value>> entries; // entries[hash.index(key)].first == key, one cache miss per lookup
+    std::vector<Collision> collisions;          // Keys whose fingerprint is already indexed, sorted by fingerprint
+
+    static std::uint64_t fingerprint(const Key& key) {
+        if constexpr (std::is_convertible_v<const Key&, std::string_view>)
+            return seededHash(std::string_view(key), 0);
+        else if constexpr (std::is_integral_v<Key> || std::is_enum_v<Key>)
+            return seededHash(static_cast<std::uint64_t>(key), 0);
+        else
+            return seededHash(static_cast<std::uint64_t>(std::hash<Key>{}(key)), 0);
+    }
+
+    template<typename T>
+    static void write(std::ostream& stream, const T& value);
+
+    template<typename T>
+    static T read(std::istream& stream);
+};
+
+template<typename Key, typename Value>
+PerfectHashTable<Key, Value> PerfectHashTable<Key, Value>::build(std::vector<std::pair<Key, Value>> entries,
+                                                                 TaskScheduler* scheduler) {
+    std::vector<std::uint64_t> fingerprints;
+    fingerprints.reserve(entries.size());
+    for (const auto& entry : entries)
+        fingerprints.push_back(fingerprint(entry.first));
+
+    // Groups the entries by fingerprint, the first entry of each group is indexed by the hash function
+    std::vector<std::size_t> byFingerprint(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) byFingerprint[i] = i;
+    std::sort(byFingerprint.begin(), byFingerprint.end(), [&](std::size_t first, std::size_t second) {
+        return fingerprints[first] < fingerprints[second];
+    });
+
+    PerfectHashTable table;
+    std::vector<std::uint64_t> indexed;
+    std::vector<std::size_t> indexedEntries;
+    for (std::size_t begin = 0, end; begin < byFingerprint.size(); begin = end) {
+        std::uint64_t shared = fingerprints[byFingerprint[begin]];
+        for (end = begin + 1; end < byFingerprint.size() && fingerprints[byFingerprint[end]] == shared; ++end) {
+            for (std::size_t other = begin; other < end; ++other)
+                if (entries[byFingerprint[end]].first == entries[byFingerprint[other]].first)
+                    throw std::invalid_argument("Duplicate key in perfect hash table.");
+        }
+
+        indexed.push_back(shared);
+        indexedEntries.push_back(byFingerprint[begin]);
+        for (std::size_t i = begin + 1; i < end; ++i)
+            table.collisions.push_back({shared, std::move(entries[byFingerprint[i]])});
+    }
+
+    table.hash = MinimalPerfectHash(indexed, scheduler);
+
+    // Moves every indexed entry to its index, the indices being a permutation of [0, indexed count)
+    std::vector<std::size_t> order(indexed.size());
+    for (std::size_t i = 0; i < indexed.size(); ++i)
+        order[table.hash.index(indexed[i])] = indexedEntries[i];
+
+    table.entries.reserve(indexed.size());
+    for (std::size_t i : order)
+        table.entries.push_back(std::move(entries[i]));
+    return table;
+}
+
+template<typename Key, typename Value>
+const Value* PerfectHashTable<Key, Value>::find(const Key& key) const {
+    auto keyFingerprint = fingerprint(key);
+    auto index = hash.index(keyFingerprint);
+    if (index >= entries.size()) return nullptr;
+    if (entries[index].first == key) return &entries[index].second;
+    if (collisions.empty()) return nullptr;
+
+    auto collision = std::lower_bound(collisions.begin(), collisions.end(), keyFingerprint,
+                                      [](const Collision& item, std::uint64_t value) { return item.fingerprint < value; });
+    for (; collision != collisions.end() && collision->fingerprint == keyFingerprint; ++collision)
+        if (collision->entry.first == key) return &collision->entry.second;
+    return nullptr;
+}
+
+template<typename Key, typename Value>
+Value PerfectHashTable<Key, Value>::get(const Key& key) const {
+    const Value* value = find(key);
+    if (value == nullptr) throw std::runtime_error("key doesn't exist");
+    return *value;
+}
+
+template<typename Key, typename Value>
+void PerfectHashTable<Key, Value>::save(std::ostream& stream) const {
+    hash.save(stream);
+    for (const auto& entry : entries) {
+        write(stream, entry.first);
+        write(stream, entry.second);
+    }
+    write(stream, static_cast<std::uint64_t>(collisions.size()));
+    for (const auto& collision : collisions) {
+        write(stream, collision.entry.first);
+        write(stream, collision.entry.second);
+    }
+}
+
+template<typename Key, typename Value>
+PerfectHashTable<Key, Value> PerfectHashTable<Key, Value>::load(std::istream& stream) {
+    PerfectHashTable table;
+    table.hash = MinimalPerfectHash::load(stream);
+
+    table.entries.reserve(table.hash.size());
+    for (std::uint64_t i = 0; i < table.hash.size(); ++i) {
+        Key key = read<Key>(stream);
+        Value value = read<Value>(stream);
+        table.entries.emplace_back(std::move(key), std::move(value));
+        if (table.hash.index(fingerprint(table.entries.back().first)) != i)
+            throw std::runtime_error("Invalid perfect hash table.");
+    }
+
+    // Every collision shares its fingerprint with an indexed key, and they are saved in fingerprint order
+    auto collisionsCount = read<std::uint64_t>(stream);
+    for (std::uint64_t i = 0; i < collisionsCount; ++i) {
+        Key key = read<Key>(stream);
+        Value value = read<Value>(stream);
+        auto keyFingerprint = fingerprint(key);
+        auto index = table.hash.index(keyFingerprint);
+        if (index >= table.entries.size() || fingerprint(table.entries[index].first) != keyFingerprint ||
+            (!table.collisions.empty() && table.collisions.back().fingerprint > keyFingerprint))
+            throw std::runtime_error("Invalid perfect hash table.");
+        table.collisions.push_back({keyFingerprint, {std::move(key), std::move(value)}});
+    }
+    return table;
+}
+
+template<typename Key, typename Value>
+template<typename T>
+void PerfectHashTable<Key, Value>::write(std::ostream& stream, const T& value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        std::uint64_t length = value.size();
+        stream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        stream.write(value.data(), static_cast<std::streamsize>(length));
+    } else {
+        static_assert(std::is_trivially_copyable_v<T>, "Only std::string and trivially copyable types can be saved.");
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+template<typename Key, typename Value>
+template<typename T>
+T PerfectHashTable<Key, Value>::read(std::istream& stream) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        auto length = read<std::uint64_t>(stream);
+        std::string value;
+        // Grows the string as it is read, so a corrupted length fails instead of allocating
+        const std::uint64_t CHUNK = 4096;
+        for (std::uint64_t readCount = 0; readCount < length; ) {
+            auto count = std::min(CHUNK, length - readCount);
+            value.resize(readCount + count);
+            if (!stream.read(&value[readCount], static_cast<std::streamsize>(count)))
+                throw std::runtime_error("Invalid perfect hash table.");
+            readCount += count;
+        }
+        return value;
+    } else {
+        static_assert(std::is_trivially_copyable_v<T>, "Only std::string and trivially copyable types can be loaded.");
+        T value{};
+        if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+            throw std::runtime_error("Invalid perfect hash table.");
+        return value;
+    }
+}
+
+#endif //DSA_PERFECTHASHTABLE_H
@@ -0,0 +1,288 @@
+/**
+ * @file RadixHashJoin.h
+ * @brief Partitioned hash join of two row sets, with a HashTable built per partition.
+ *
+ * Joining by inserting the build side in one HashTable and looking every probe row up in it stops
+ * scaling once the table outgrows the caches: every probe is then a few cache misses. RadixHashJoin
+ * first splits both sides by the bits of their keys' hashes into partitions of about partitionSize
+ * build rows, so that matching rows land in matching partitions, then joins each pair of partitions
+ * on its own: the partition's table is built and probed while it sits in the L2 cache.
+ *
+ * Partitioning writes to one output area per partition, which becomes slow itself when there are
+ * more areas than TLB entries and cache lines to keep them in, so it is done in two passes on half
+ * of the bits each. The first pass splits the rows in parallel chunks (counting the partitions'
+ * sizes first, then copying), and the first-level partitions are then sub-partitioned and joined
+ * in parallel, when given a TaskScheduler.
+ *
+ * The partitions hold copies of the rows, so that building, probing and emitting matches all read
+ * the partition sequentially: narrow rows (a key and a payload, or a row index) join fastest.
+ *
+ * Usage example:
+ * --------------
+ * RadixHashJoin join(&TaskScheduler::shared());
+ * std::atomic<long> revenue{0};
+ * join.join(customers, orders,
+ *           [](const Customer& customer) { return customer.id; },
+ *           [](const Order& order) { return order.customerId; },
+ *           [&](const Customer& customer, const Order& order) { revenue += order.amount; });
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_RADIXHASHJOIN_H
+#define DSA_RADIXHASHJOIN_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "HashTable.h"
+#include "SeededHash.h"
+#include "../Common/TaskScheduler.h"
+
+class RadixHashJoin {
+public:
+    /**
+     * @param scheduler If not null, the rows are partitioned and the partitions joined in parallel on it.
+     * @param partitionSize Build rows per partition, so that a partition's table fits in the L2 cache.
+     */
+    explicit RadixHashJoin(TaskScheduler* scheduler = nullptr, std::size_t partitionSize = 4096)
+            : scheduler(scheduler), partitionSize(std::max<std::size_t>(partitionSize, 1)) {}
+
+    /**
+     * @brief Calls emit(buildRow, probeRow) for every pair of rows with equal keys.
+     *
+     * @param build The rows the tables are built from, preferably the smaller side.
+     * @param probe The rows looked up in the tables.
+     * @param buildKey Function returning the key of a build row.
+     * @param probeKey Function returning the key of a probe row, of the same type.
+     * @param emit Called for every match, concurrently from the scheduler's threads if one is given.
+     * @throws std::invalid_argument If the build side has 2^32 rows or more.
+     */
+    template<typename BuildRow, typename ProbeRow, typename BuildKey, typename ProbeKey, typename Emit>
+    void join(const std::vector<BuildRow>& build, const std::vector<ProbeRow>& probe,
+              BuildKey buildKey, ProbeKey probeKey, Emit emit) const;
+
+    /**
+     * @return number of partitions a build side of the given size is split into.
+     */
+    [[nodiscard]] std::size_t partitionsCount(std::size_t buildSize) const {
+        return std::size_t(1) << radixBits(buildSize);
+    }
+
+private:
+    static constexpr std::size_t CHUNK_SIZE = 1 << 16;    // Rows partitioned by a task of the first pass
+    static constexpr int MAX_BITS = 24;                   // Of the 32 bits of hash, 12 per pass at most
+    static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+    TaskScheduler* scheduler;
+    std::size_t partitionSize;
+
+    /**
+     * @return number of hash bits selecting the partition of a row.
+     */
+    [[nodiscard]] int radixBits(std::size_t buildSize) const {
+        int bits = 0;
+        while (bits < MAX_BITS && (partitionSize << bits) < buildSize) bits++;
+        return bits;
+    }
+
+    template<typename Key>
+    static std::uint32_t hashOf(const Key& key) {
+        // std::hash is often the identity, its high bits would put most integer keys in partition 0
+        return static_cast<std::uint32_t>(seededHash(static_cast<std::uint64_t>(std::hash<Key>{}(key)), 0) >> 32);
+    }
+
+    static std::size_t digit(std::uint32_t hash, int shift, int bits) {
+        return bits == 0 ? 0 : (hash >> shift) & ((std::uint32_t(1) << bits) - 1);
+    }
+
+    /**
+     * @brief Runs body(i) for every i of [0, count), in parallel if there is a scheduler.
+     */
+    template<typename Body>
+    void forEach(std::size_t count, Body body) const {
+        if (scheduler && count > 1) scheduler->parallelFor<std::size_t>(0, count, body, 1);
+        else for (std::size_t i = 0; i < count; ++i) body(i);
+    }
+
+    /**
+     * @brief Splits rows by the digit of their key's hash at the given shift (first pass).
+     *
+     * @param offsets Set to the start of each partition in the result, and its end last.
+     * @return copies of the rows, grouped by partition.
+     */
+    template<typename Row, typename KeyOf>
+    std::vector<Row> partition(const std::vector<Row>& rows, KeyOf& keyOf, int shift, int bits,
+                               std::vector<std::size_t>& offsets) const;
+
+    /**
+     * @brief Splits rows by the digit of their key's hash at the given shift (second pass).
+     */
+    template<typename Row, typename KeyOf>
+    static void partition(const Row* begin, const Row* end, KeyOf& keyOf, int shift, int bits,
+                          std::vector<Row>& partitioned, std::vector<std::size_t>& offsets);
+
+    /**
+     * @brief Joins a partition of each side, whose table fits in the cache.
+     */
+    template<typename BuildRow, typename ProbeRow, typename BuildKey, typename ProbeKey, typename Emit>
+    static void joinPartition(const BuildRow* buildBegin, const BuildRow* buildEnd,
+                              const ProbeRow* probeBegin, const ProbeRow* probeEnd,
+                              BuildKey& buildKey, ProbeKey& probeKey, Emit& emit,
+                              std::pmr::memory_resource* resource, std::vector<std::uint32_t>& next);
+};
+
+template<typename BuildRow, typename ProbeRow, typename BuildKey, typename ProbeKey, typename Emit>
+void RadixHashJoin::join(const std::vector<BuildRow>& build, const std::vector<ProbeRow>& probe,
+                         BuildKey buildKey, ProbeKey probeKey, Emit emit) const {
+    using Key = std::decay_t<std::invoke_result_t<BuildKey&, const BuildRow&>>;
+    static_assert(std::is_same_v<Key, std::decay_t<std::invoke_result_t<ProbeKey&, const ProbeRow&>>>,
+                  "Both sides of a join must have the same key type.");
+
+    if (build.size() >= NONE)
+        throw std::invalid_argument("The build side of the join has too many rows.");
+    if (build.empty() || probe.empty()) return;
+
+    // Half of the bits (rounded up) for the first pass, the other half for the second
+    int bits = radixBits(build.size());
+    int firstBits = (bits + 1) / 2;
+    int secondBits = bits - firstBits;
+
+    std::vector<std::size_t> buildOffsets, probeOffsets;
+    auto buildPartitioned = partition(build, buildKey, 32 - firstBits, firstBits, buildOffsets);
+    auto probePartitioned = partition(probe, probeKey, 32 - firstBits, firstBits, probeOffsets);
+
+    forEach(buildOffsets.size() - 1, [&](std::size_t first) {
+        const BuildRow* buildBegin = buildPartitioned.data() + buildOffsets[first];
+        const BuildRow* buildEnd = buildPartitioned.data() + buildOffsets[first + 1];
+        const ProbeRow* probeBegin = probePartitioned.data() + probeOffsets[first];
+        const ProbeRow* probeEnd = probePartitioned.data() + probeOffsets[first + 1];
+        if (buildBegin == buildEnd || probeBegin == probeEnd) return;
+
+        // The tables' nodes come from a buffer freed at once after each partition
+        std::pmr::monotonic_buffer_resource arena;
+        std::vector<std::uint32_t> next;
+
+        if (secondBits == 0) {
+            joinPartition(buildBegin, buildEnd, probeBegin, probeEnd, buildKey, probeKey, emit, &arena, next);
+            return;
+        }
+
+        std::vector<BuildRow> buildSecond;
+        std::vector<ProbeRow> probeSecond;
+        std::vector<std::size_t> buildSecondOffsets, probeSecondOffsets;
+        partition(buildBegin, buildEnd, buildKey, 32 - bits, secondBits, buildSecond, buildSecondOffsets);
+        partition(probeBegin, probeEnd, probeKey, 32 - bits, secondBits, probeSecond, probeSecondOffsets);
+
+        for (std::size_t second = 0; second + 1 < buildSecondOffsets.size(); ++second) {
+            joinPartition(buildSecond.data() + buildSecondOffsets[second],
+                          buildSecond.data() + buildSecondOffsets[second + 1],
+                          probeSecond.data() + probeSecondOffsets[second],
+                          probeSecond.data() + probeSecondOffsets[second + 1],
+                          buildKey, probeKey, emit, &arena, next);
+            arena.release();
+        }
+    });
+}
+
+template<typename Row, typename KeyOf>
+std::vector<Row> RadixHashJoin::partition(const std::vector<Row>& rows, KeyOf& keyOf, int shift, int bits,
+                                          std::vector<std::size_t>& offsets) const {
+    std::size_t fanout = std::size_t(1) << bits;
+    std::size_t chunks = (rows.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    // Count the rows of each partition in each chunk
+    std::vector<std::size_t> histograms(chunks * fanout);
+    forEach(chunks, [&](std::size_t chunk) {
+        std::size_t* histogram = &histograms[chunk * fanout];
+        std::size_t end = std::min(rows.size(), (chunk + 1) * CHUNK_SIZE);
+        for (std::size_t i = chunk * CHUNK_SIZE; i < end; ++i)
+            histogram[digit(hashOf(keyOf(rows[i])), shift, bits)]++;
+    });
+
+    // Turn the counts into the positions each chunk copies its rows of each partition to
+    offsets.assign(fanout + 1, 0);
+    std::size_t position = 0;
+    for (std::size_t part = 0; part < fanout; ++part) {
+        offsets[part] = position;
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            std::size_t count = histograms[chunk * fanout + part];
+            histograms[chunk * fanout + part] = position;
+            position += count;
+        }
+    }
+    offsets[fanout] = position;
+
+    std::vector<Row> partitioned(rows.size());
+    forEach(chunks, [&](std::size_t chunk) {
+        std::size_t* cursors = &histograms[chunk * fanout];
+        std::size_t end = std::min(rows.size(), (chunk + 1) * CHUNK_SIZE);
+        for (std::size_t i = chunk * CHUNK_SIZE; i < end; ++i)
+            partitioned[cursors[digit(hashOf(keyOf(rows[i])), shift, bits)]++] = rows[i];
+    });
+    return partitioned;
+}
+
+template<typename Row, typename KeyOf>
+void RadixHashJoin::partition(const Row* begin, const Row* end, KeyOf& keyOf, int shift, int bits,
+                              std::vector<Row>& partitioned, std::vector<std::size_t>& offsets) {
+    std::size_t fanout = std::size_t(1) << bits;
+    std::vector<std::uint16_t> digits;
+    std::vector<std::size_t> cursors(fanout);
+
+    // The digits are kept, not to hash every key twice
+    offsets.assign(fanout + 1, 0);
+    digits.reserve(static_cast<std::size_t>(end - begin));
+    for (const Row* row = begin; row != end; ++row) {
+        digits.push_back(static_cast<std::uint16_t>(digit(hashOf(keyOf(*row)), shift, bits)));
+        offsets[digits.back() + 1]++;
+    }
+    for (std::size_t part = 0; part < fanout; ++part)
+        offsets[part + 1] += offsets[part];
+
+    std::copy(offsets.begin(), offsets.end() - 1, cursors.begin());
+    partitioned.resize(static_cast<std::size_t>(end - begin));
+    for (std::size_t i = 0; i < digits.size(); ++i)
+        partitioned[cursors[digits[i]]++] = begin[i];
+}
+
+template<typename BuildRow, typename ProbeRow, typename BuildKey, typename ProbeKey, typename Emit>
+void RadixHashJoin::joinPartition(const BuildRow* buildBegin, const BuildRow* buildEnd,
+                                  const ProbeRow* probeBegin, const ProbeRow* probeEnd,
+                                  BuildKey& buildKey, ProbeKey& probeKey, Emit& emit,
+                                  std::pmr::memory_resource* resource, std::vector<std::uint32_t>& next) {
+    using Key = std::decay_t<std::invoke_result_t<BuildKey&, const BuildRow&>>;
+
+    auto buildCount = static_cast<std::uint32_t>(buildEnd - buildBegin);
+    if (buildCount == 0 || probeBegin == probeEnd) return;
+
+    // The table maps a key to its last build row, next[] chains the rows of duplicate keys.
+    // One more bucket than rows, so it is never rehashed
+    HashTable<Key, std::uint32_t> table(resource, static_cast<int>(buildCount + 1) | 1);
+    next.assign(buildCount, NONE);
+    for (std::uint32_t i = 0; i < buildCount; ++i) {
+        const Key& key = buildKey(buildBegin[i]);
+        if (const std::uint32_t* last = table.find(key)) {
+            next[i] = *last;
+            table[key] = i;
+        } else {
+            table.insert(key, i);
+        }
+    }
+
+    for (const ProbeRow* row = probeBegin; row != probeEnd; ++row) {
+        const std::uint32_t* last = table.find(probeKey(*row));
+        if (!last) continue;
+
+        for (std::uint32_t match = *last; match != NONE; match = next[match])
+            emit(buildBegin[match], *row);
+    }
+}
+
+#endif //DSA_RADIXHASHJOIN_H
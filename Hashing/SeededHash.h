@@ -0,0 +1,50 @@
+/**
+ * @file SeededHash.h
+ * @brief Families of string and integer hash functions selected by a seed, usable at compile time.
+ *
+ * Perfect hashing needs many independent hash functions of the same key, which std::hash
+ * can't provide (and isn't constexpr). seededHash() is FNV-1a started from a seed dependent
+ * basis, followed by a 64 bit finalizer so the low bits (used to index power of two tables)
+ * depend on every input byte.
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_SEEDEDHASH_H
+#define DSA_SEEDEDHASH_H
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Hashes a string with the hash function selected by seed.
+ */
+constexpr std::uint64_t seededHash(std::string_view key, std::uint64_t seed) {
+    std::uint64_t hash = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+    for (char ch : key) {
+        hash ^= static_cast<unsigned char>(ch);
+        hash *= 1099511628211ull;
+    }
+
+    // Finalizer of MurmurHash3
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * @brief Hashes a 64 bit value (an integer key or the hash of a key) with the hash function selected by seed.
+ */
+constexpr std::uint64_t seededHash(std::uint64_t value, std::uint64_t seed) {
+    std::uint64_t hash = value + 0x9E3779B97F4A7C15ull * (seed + 1);
+
+    // Finalizer of SplitMix64
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+    return hash ^ (hash >> 31);
+}
+
+#endif //DSA_SEEDEDHASH_H
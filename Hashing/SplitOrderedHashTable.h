@@ -0,0 +1,433 @@
+/**
+ * @file SplitOrderedHashTable.h
+ * @brief Declaration and implementation of the SplitOrderedHashTable class, a lock-free hash table
+ * growing without moving its nodes.
+ *
+ * Every node lives in a single lock-free linked list (Harris-Michael: a node is removed by marking the
+ * low bit of its next pointer, then unlinked by whichever thread walks past it). The list is sorted by
+ * the bit-reversed hash of the keys ("split order"), so the nodes of a bucket are contiguous in the list
+ * whatever the buckets count: with 2^k buckets, bucket b holds the hashes whose k low bits are b, which
+ * are exactly the nodes between the sentinel nodes of reverse(b) and of the next bucket in split order.
+ *
+ * The buckets are pointers to their sentinel node, a node without key inserted into the list. Doubling
+ * the buckets count is a single atomic update: the new buckets get their sentinel lazily, the first time
+ * they are used, by inserting it into the list starting from the parent bucket (b without its highest
+ * bit) and it simply splits the parent's nodes in two. No node is ever moved or rehashed.
+ * The buckets are segments of increasing size (1, 1, 2, 4, 8...) allocated on demand, so existing
+ * buckets never move either.
+ *
+ * insert(), remove(), contains(), find() and get() can be called concurrently from any number of threads
+ * and never block: a thread can only be delayed by other threads making progress. Removed nodes are
+ * retired through EpochReclamation (see Common/EpochReclamation.h) and deleted once no operation can
+ * still be reading them. Values are never modified in place, so lookups may copy them without locking:
+ * insert() doesn't replace the value of a key already present, remove the key first to change it.
+ *
+ * The Instrumentation policy (see Common/Instrumentation.h) is notified of node allocations, node
+ * visits, key comparisons and doublings.
+ *
+ * Usage example:
+ * --------------
+ * SplitOrderedHashTable<std::string, int> table;
+ * // from any thread
+ * table.insert("apple", 3);
+ * int value;
+ * if (table.find("apple", value)) use(value);
+ * table.remove("apple");
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_SPLITORDEREDHASHTABLE_H
+#define DSA_SPLITORDEREDHASHTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+#include "SeededHash.h"
+#include "../Common/EpochReclamation.h"
+#include "../Common/Instrumentation.h"
+
+template<typename Key, typename Value, typename Instrumentation = NoInstrumentation>
+class SplitOrderedHashTable {
+public:
+    /*region Big Five & Other Constructors*/
+
+    /**
+     * @param bucketsCount Initial buckets count, rounded up to a power of two.
+     */
+    explicit SplitOrderedHashTable(std::size_t bucketsCount = 16);
+
+    /**
+     * @brief Deletes every node. Must not be called while other threads use the table.
+     */
+    ~SplitOrderedHashTable();
+
+    SplitOrderedHashTable(const SplitOrderedHashTable& other) = delete;
+    SplitOrderedHashTable& operator=(const SplitOrderedHashTable& other) = delete;
+
+    /*endregion*/
+
+    /*region Constant Methods */
+
+    /**
+     * @brief Looks up a key, copying its value.
+     * @return true if the key is present.
+     */
+    bool find(const Key& key, Value& value) const;
+
+    /**
+     * @return copy of the value associated with the key.
+     * @throws std::runtime_error If the key is not present.
+     */
+    Value get(const Key& key) const;
+
+    bool contains(const Key& key) const;
+
+    /**
+     * @return entries count, only a snapshot when other threads modify the table.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] std::size_t bucketsCount() const;
+
+    /*endregion*/
+
+    /*region Non-Constant Methods */
+
+    /**
+     * @brief Adds the key, unless it is present already (its value is then left unchanged).
+     * @return true if the key was added.
+     */
+    bool insert(const Key& key, const Value& value);
+
+    /**
+     * @return true if the key was present and removed.
+     */
+    bool remove(const Key& key);
+
+    /*endregion*/
+
+private:
+    /**
+     * @brief Node of the list, a bucket sentinel when its order is even.
+     */
+    struct Link {
+        std::atomic<std::uintptr_t> next{0};  // Pointer to the next node, the low bit marks this node as removed
+        std::uint64_t order;                   // Bit-reversed hash, with the low bit set for the keys
+
+        explicit Link(std::uint64_t order) : order(order) {}
+    };
+
+    struct Entry : Link {
+        Key key;
+        Value value;
+
+        Entry(std::uint64_t order, const Key& key, const Value& value) : Link(order), key(key), value(value) {}
+    };
+
+    static constexpr std::uintptr_t REMOVED = 1;
+    static constexpr int SEGMENTS = 64;
+    static constexpr std::size_t LOAD_FACTOR = 1;   // Average nodes per bucket before doubling
+
+    Link head{0};  // Sentinel of bucket 0, the first node of the list
+    mutable std::atomic<std::atomic<Link*>*> segments[SEGMENTS] = {};  // Segment s holds buckets [2^(s-1), 2^s)
+    std::atomic<std::size_t> buckets;
+    std::atomic<std::size_t> count{0};
+
+    static std::uint64_t hashOf(const Key& key) {
+        return seededHash(static_cast<std::uint64_t>(std::hash<Key>{}(key)), 0);
+    }
+
+    static std::uint64_t reverseBits(std::uint64_t word);
+
+    static Link* pointerOf(std::uintptr_t word) { return reinterpret_cast<Link*>(word & ~REMOVED); }
+
+    static bool isEntry(const Link* link) { return link->order & 1; }
+
+    static void deleteLink(void* pointer);
+
+    /**
+     * @brief Walks a bucket for the key, skipping the removed nodes without unlinking them.
+     * @return the node of the key, or null.
+     */
+    const Entry* lookup(const Key& key) const;
+
+    /**
+     * @return the slot of a bucket, allocating its segment if needed.
+     */
+    std::atomic<Link*>& slotOf(std::size_t bucket) const;
+
+    /**
+     * @return the sentinel of a bucket, inserting it into the list if the bucket wasn't used yet.
+     */
+    Link* sentinelOf(std::size_t bucket) const;
+
+    /**
+     * @brief Finds the position of a node in the list, from a bucket sentinel, unlinking the removed nodes met.
+     *
+     * @param key The key of the node, null for a sentinel.
+     * @param prev Set to the next pointer pointing to current.
+     * @param current Set to the node found, or to the node it would be inserted before.
+     * @return true if the node is in the list.
+     */
+    static bool search(Link* start, std::uint64_t order, const Key* key, std::atomic<std::uintptr_t>*& prev, Link*& current);
+};
+
+/*region Big Five & Other Constructors */
+
+template<typename Key, typename Value, typename Instrumentation>
+SplitOrderedHashTable<Key, Value, Instrumentation>::SplitOrderedHashTable(std::size_t bucketsCount) {
+    std::size_t initial = 2;
+    while (initial < bucketsCount) initial *= 2;
+    buckets.store(initial, std::memory_order_relaxed);
+    slotOf(0).store(&head, std::memory_order_relaxed);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+SplitOrderedHashTable<Key, Value, Instrumentation>::~SplitOrderedHashTable() {
+    // Nodes marked but not unlinked are still in the list, the unlinked ones are owned by the reclamation
+    Link* link = pointerOf(head.next.load(std::memory_order_acquire));
+    while (link) {
+        Link* next = pointerOf(link->next.load(std::memory_order_relaxed));
+        deleteLink(link);
+        link = next;
+    }
+    for (auto& segment : segments) delete[] segment.load(std::memory_order_relaxed);
+}
+
+/*endregion*/
+
+/*region Public Constant Methods */
+
+template<typename Key, typename Value, typename Instrumentation>
+bool SplitOrderedHashTable<Key, Value, Instrumentation>::find(const Key& key, Value& value) const {
+    auto guard = EpochReclamation::shared().guard();
+    const Entry* entry = lookup(key);
+    if (!entry) return false;
+    value = entry->value;
+    return true;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+Value SplitOrderedHashTable<Key, Value, Instrumentation>::get(const Key& key) const {
+    auto guard = EpochReclamation::shared().guard();
+    const Entry* entry = lookup(key);
+    if (!entry) throw std::runtime_error("key doesn't exist");
+    return entry->value;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+bool SplitOrderedHashTable<Key, Value, Instrumentation>::contains(const Key& key) const {
+    auto guard = EpochReclamation::shared().guard();
+    return lookup(key) != nullptr;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+std::size_t SplitOrderedHashTable<Key, Value, Instrumentation>::size() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+std::size_t SplitOrderedHashTable<Key, Value, Instrumentation>::bucketsCount() const {
+    return buckets.load(std::memory_order_relaxed);
+}
+
+/*endregion*/
+
+/*region Public Non-Constant Methods */
+
+template<typename Key, typename Value, typename Instrumentation>
+bool SplitOrderedHashTable<Key, Value, Instrumentation>::insert(const Key& key, const Value& value) {
+    auto guard = EpochReclamation::shared().guard();
+    auto hash = hashOf(key);
+    auto bucketsCount = buckets.load(std::memory_order_acquire);
+    Link* start = sentinelOf(hash & (bucketsCount - 1));
+
+    auto* entry = new Entry(reverseBits(hash) | 1, key, value);
+    Instrumentation::onAllocate(sizeof(Entry));
+
+    std::atomic<std::uintptr_t>* prev;
+    Link* current;
+    while (true) {
+        if (search(start, entry->order, &key, prev, current)) {
+            // Never published, no other thread can have seen it
+            deleteLink(entry);
+            return false;
+        }
+        entry->next.store(reinterpret_cast<std::uintptr_t>(current), std::memory_order_relaxed);
+        auto expected = reinterpret_cast<std::uintptr_t>(current);
+        if (prev->compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(entry),
+                                          std::memory_order_release, std::memory_order_relaxed))
+            break;
+    }
+
+    // Doubling only publishes the new count, the new buckets are initialized by their first use
+    if (count.fetch_add(1, std::memory_order_relaxed) + 1 > bucketsCount * LOAD_FACTOR
+        && buckets.compare_exchange_strong(bucketsCount, bucketsCount * 2, std::memory_order_release, std::memory_order_relaxed))
+        Instrumentation::onRehash();
+    return true;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+bool SplitOrderedHashTable<Key, Value, Instrumentation>::remove(const Key& key) {
+    auto guard = EpochReclamation::shared().guard();
+    auto hash = hashOf(key);
+    Link* start = sentinelOf(hash & (buckets.load(std::memory_order_acquire) - 1));
+    auto order = reverseBits(hash) | 1;
+
+    std::atomic<std::uintptr_t>* prev;
+    Link* current;
+    while (true) {
+        if (!search(start, order, &key, prev, current)) return false;
+
+        // Marking the node removes it logically, the thread that marks it owns the removal
+        auto next = current->next.load(std::memory_order_acquire);
+        if (next & REMOVED) continue;
+        if (!current->next.compare_exchange_strong(next, next | REMOVED, std::memory_order_acq_rel, std::memory_order_relaxed))
+            continue;
+
+        auto expected = reinterpret_cast<std::uintptr_t>(current);
+        if (prev->compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_relaxed))
+            EpochReclamation::shared().retire(current, &deleteLink);
+        else
+            search(start, order, &key, prev, current);  // Unlinks (and retires) it, or another thread did
+        count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+}
+
+/*endregion*/
+
+/*region Private Methods */
+
+template<typename Key, typename Value, typename Instrumentation>
+std::uint64_t SplitOrderedHashTable<Key, Value, Instrumentation>::reverseBits(std::uint64_t word) {
+    word = (word >> 1 & 0x5555555555555555ull) | (word & 0x5555555555555555ull) << 1;
+    word = (word >> 2 & 0x3333333333333333ull) | (word & 0x3333333333333333ull) << 2;
+    word = (word >> 4 & 0x0F0F0F0F0F0F0F0Full) | (word & 0x0F0F0F0F0F0F0F0Full) << 4;
+    word = (word >> 8 & 0x00FF00FF00FF00FFull) | (word & 0x00FF00FF00FF00FFull) << 8;
+    word = (word >> 16 & 0x0000FFFF0000FFFFull) | (word & 0x0000FFFF0000FFFFull) << 16;
+    return word >> 32 | word << 32;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+void SplitOrderedHashTable<Key, Value, Instrumentation>::deleteLink(void* pointer) {
+    auto* link = static_cast<Link*>(pointer);
+    if (isEntry(link)) {
+        delete static_cast<Entry*>(link);
+        Instrumentation::onDeallocate(sizeof(Entry));
+    } else {
+        delete link;
+    }
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+const typename SplitOrderedHashTable<Key, Value, Instrumentation>::Entry*
+SplitOrderedHashTable<Key, Value, Instrumentation>::lookup(const Key& key) const {
+    auto hash = hashOf(key);
+    auto order = reverseBits(hash) | 1;
+    Link* link = sentinelOf(hash & (buckets.load(std::memory_order_acquire) - 1));
+
+    // Removed nodes are still readable under the guard, and their next pointer leads back into the list
+    while (link && link->order <= order) {
+        Instrumentation::onVisit();
+        auto next = link->next.load(std::memory_order_acquire);
+        if (link->order == order && !(next & REMOVED)) {
+            Instrumentation::onCompare();
+            if (static_cast<const Entry*>(link)->key == key) return static_cast<const Entry*>(link);
+        }
+        link = pointerOf(next);
+    }
+    return nullptr;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+std::atomic<typename SplitOrderedHashTable<Key, Value, Instrumentation>::Link*>&
+SplitOrderedHashTable<Key, Value, Instrumentation>::slotOf(std::size_t bucket) const {
+    int segment = 0;
+    while ((bucket >> segment) != 0) segment++;
+    std::size_t first = segment == 0 ? 0 : std::size_t(1) << (segment - 1);
+
+    auto* slots = segments[segment].load(std::memory_order_acquire);
+    if (!slots) {
+        auto* allocated = new std::atomic<Link*>[segment == 0 ? 1 : first]();
+        if (segments[segment].compare_exchange_strong(slots, allocated, std::memory_order_acq_rel, std::memory_order_acquire))
+            slots = allocated;
+        else
+            delete[] allocated;  // Another thread allocated it first, slots was set to its segment
+    }
+    return slots[bucket - first];
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+typename SplitOrderedHashTable<Key, Value, Instrumentation>::Link*
+SplitOrderedHashTable<Key, Value, Instrumentation>::sentinelOf(std::size_t bucket) const {
+    std::atomic<Link*>& slot = slotOf(bucket);
+    Link* sentinel = slot.load(std::memory_order_acquire);
+    if (sentinel) return sentinel;
+
+    // The parent bucket holds every node of this one, its sentinel is before them in the list
+    std::size_t parent = bucket;
+    for (std::size_t bit = 1; bit <= bucket; bit <<= 1)
+        if (bucket & bit) parent = bucket & ~bit;
+    Link* start = sentinelOf(parent);
+
+    auto* created = new Link(reverseBits(bucket));
+    std::atomic<std::uintptr_t>* prev;
+    Link* current;
+    while (true) {
+        // Another thread may have inserted the same sentinel meanwhile, it is then found
+        if (search(start, created->order, nullptr, prev, current)) {
+            delete created;
+            sentinel = current;
+            break;
+        }
+        created->next.store(reinterpret_cast<std::uintptr_t>(current), std::memory_order_relaxed);
+        auto expected = reinterpret_cast<std::uintptr_t>(current);
+        if (prev->compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(created),
+                                          std::memory_order_release, std::memory_order_relaxed)) {
+            sentinel = created;
+            break;
+        }
+    }
+    slot.store(sentinel, std::memory_order_release);
+    return sentinel;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+bool SplitOrderedHashTable<Key, Value, Instrumentation>::search(Link* start, std::uint64_t order, const Key* key,
+                                                               std::atomic<std::uintptr_t>*& prev, Link*& current) {
+retry:
+    prev = &start->next;
+    current = pointerOf(prev->load(std::memory_order_acquire));
+    while (current) {
+        Instrumentation::onVisit();
+        auto next = current->next.load(std::memory_order_acquire);
+        if (next & REMOVED) {
+            // Unlinking fails if prev changed or its node was removed too, the walk restarts then
+            auto expected = reinterpret_cast<std::uintptr_t>(current);
+            if (!prev->compare_exchange_strong(expected, next & ~REMOVED, std::memory_order_acq_rel, std::memory_order_relaxed))
+                goto retry;
+            EpochReclamation::shared().retire(current, &deleteLink);
+            current = pointerOf(next);
+            continue;
+        }
+
+        if (current->order > order) return false;
+        if (current->order == order) {
+            if (!key) return true;
+            Instrumentation::onCompare();
+            if (static_cast<Entry*>(current)->key == *key) return true;
+        }
+        prev = &current->next;
+        current = pointerOf(next);
+    }
+    return false;
+}
+
+/*endregion*/
+
+#endif //DSA_SPLITORDEREDHASHTABLE_H
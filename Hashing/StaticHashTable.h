@@ -0,0 +1,174 @@
+/**
+ * @file StaticHashTable.h
+ * @brief Immutable string keyed hash table built at compile time with a perfect hash function.
+ *
+ * For fixed tables (keywords, opcodes, ...) a StaticHashTable replaces building a HashTable at startup.
+ * Declared constexpr, the whole table is computed by the compiler and ends up in read only data:
+ * no startup cost, no allocation, and a lookup is two hashes and a single key comparison.
+ *
+ * The hash function is perfect (collision free) by construction, using "hash and displace":
+ * keys are grouped in buckets by a first hash, then, largest bucket first, each bucket gets the
+ * first seed whose hash places all of its keys in free slots. A lookup hashes the key to its
+ * bucket, then hashes it again with the bucket's seed to get its slot.
+ * The table has about twice as many slots as keys, which keeps the seed search short: a 1500 keys
+ * table builds in a couple of seconds within GCC's default constexpr evaluation limits.
+ *
+ * Usage example:
+ * --------------
+ * constexpr auto opcodes = makeStaticHashTable<int>({
+ *     {"add", 0x01}, {"sub", 0x02}, {"jmp", 0x10}
+ * });
+ * static_assert(opcodes.get("sub") == 0x02);
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_STATICHASHTABLE_H
+#define DSA_STATICHASHTABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "SeededHash.h"
+
+template<typename Value, std::size_t N>
+class StaticHashTable {
+public:
+    /**
+     * @brief Builds the table, meant to be evaluated at compile time.
+     * @param entries The key-value pairs.
+     * @throws std::invalid_argument If a key appears twice (a compile error when constexpr).
+     */
+    constexpr explicit StaticHashTable(const std::pair<std::string_view, Value> (&entries)[N]);
+
+    /**
+     * @return the value of the key, nullptr if the key isn't in the table.
+     */
+    constexpr const Value* find(std::string_view key) const;
+
+    [[nodiscard]] constexpr bool contains(std::string_view key) const { return find(key) != nullptr; }
+
+    /**
+     * @return copy of the value of the key.
+     * @throws std::runtime_error If the key isn't in the table.
+     */
+    constexpr Value get(std::string_view key) const;
+
+    [[nodiscard]] static constexpr std::size_t size() { return N; }
+
+private:
+    static constexpr std::size_t nextPowerOfTwo(std::size_t value) {
+        std::size_t power = 1;
+        while (power < value) power *= 2;
+        return power;
+    }
+
+    static constexpr std::size_t SLOTS = nextPowerOfTwo(2 * N);
+    static constexpr std::size_t BUCKETS = nextPowerOfTwo(N / 2 + 1);
+    // Seeds tried per bucket before giving up, far more than needed at this load factor
+    static constexpr std::uint32_t MAX_SEED = 1u << 20;
+
+    std::array<std::uint32_t, BUCKETS> seeds{};
+    std::array<std::string_view, SLOTS> keys{};
+    std::array<Value, SLOTS> values{};
+    std::array<bool, SLOTS> used{};
+
+    static constexpr std::size_t bucketOf(std::string_view key) {
+        return seededHash(key, 0) & (BUCKETS - 1);
+    }
+
+    static constexpr std::size_t slotOf(std::string_view key, std::uint32_t seed) {
+        return seededHash(key, seed) & (SLOTS - 1);
+    }
+};
+
+/**
+ * @brief Deduces the value type and size of a StaticHashTable, e.g. makeStaticHashTable<int>({{"a", 1}}).
+ */
+template<typename Value, std::size_t N>
+constexpr StaticHashTable<Value, N> makeStaticHashTable(const std::pair<std::string_view, Value> (&entries)[N]) {
+    return StaticHashTable<Value, N>(entries);
+}
+
+template<typename Value, std::size_t N>
+constexpr StaticHashTable<Value, N>::StaticHashTable(const std::pair<std::string_view, Value> (&entries)[N]) {
+    // Group the keys by bucket: members of bucket b are keyOrder[bucketStart[b]..bucketStart[b + 1])
+    std::array<std::size_t, BUCKETS + 1> bucketStart{};
+    for (std::size_t i = 0; i < N; ++i)
+        bucketStart[bucketOf(entries[i].first) + 1]++;
+    for (std::size_t b = 0; b < BUCKETS; ++b)
+        bucketStart[b + 1] += bucketStart[b];
+
+    std::array<std::size_t, N> keyOrder{};
+    std::array<std::size_t, BUCKETS> filled{};
+    for (std::size_t i = 0; i < N; ++i) {
+        auto bucket = bucketOf(entries[i].first);
+        keyOrder[bucketStart[bucket] + filled[bucket]++] = i;
+    }
+
+    std::size_t largestBucket = 0;
+    for (std::size_t b = 0; b < BUCKETS; ++b)
+        largestBucket = filled[b] > largestBucket ? filled[b] : largestBucket;
+
+    // Place the largest buckets first, they are the hardest to fit
+    std::array<std::size_t, N> bucketSlots{};
+    for (std::size_t bucketSize = largestBucket; bucketSize > 0; --bucketSize) {
+        for (std::size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            if (filled[bucket] != bucketSize) continue;
+
+            // Equal keys share their bucket, and no seed could separate them
+            for (std::size_t k = 0; k < filled[bucket]; ++k)
+                for (std::size_t previous = 0; previous < k; ++previous)
+                    if (entries[keyOrder[bucketStart[bucket] + k]].first == entries[keyOrder[bucketStart[bucket] + previous]].first)
+                        throw std::invalid_argument("Duplicate key in static hash table.");
+
+            // Find the first seed sending the bucket's keys to distinct free slots
+            for (std::uint32_t seed = 1;; ++seed) {
+                if (seed == MAX_SEED) throw std::logic_error("Couldn't find a perfect hash function.");
+
+                bool fits = true;
+                for (std::size_t k = 0; k < filled[bucket] && fits; ++k) {
+                    auto slot = slotOf(entries[keyOrder[bucketStart[bucket] + k]].first, seed);
+                    fits = !used[slot];
+                    for (std::size_t previous = 0; previous < k && fits; ++previous)
+                        fits = bucketSlots[previous] != slot;
+                    bucketSlots[k] = slot;
+                }
+                if (!fits) continue;
+
+                seeds[bucket] = seed;
+                for (std::size_t k = 0; k < filled[bucket]; ++k) {
+                    const auto& entry = entries[keyOrder[bucketStart[bucket] + k]];
+                    auto slot = bucketSlots[k];
+                    used[slot] = true;
+                    keys[slot] = entry.first;
+                    values[slot] = entry.second;
+                }
+                break;
+            }
+        }
+    }
+}
+
+template<typename Value, std::size_t N>
+constexpr const Value* StaticHashTable<Value, N>::find(std::string_view key) const {
+    auto seed = seeds[bucketOf(key)];
+    if (seed == 0) return nullptr; // empty bucket
+
+    auto slot = slotOf(key, seed);
+    if (!used[slot] || keys[slot] != key) return nullptr;
+    return &values[slot];
+}
+
+template<typename Value, std::size_t N>
+constexpr Value StaticHashTable<Value, N>::get(std::string_view key) const {
+    auto value = find(key);
+    if (!value) throw std::runtime_error("key doesn't exist");
+    return *value;
+}
+
+#endif //DSA_STATICHASHTABLE_H
@@ -20,6 +20,11 @@
  * demonstration of a binary max heap. Depending on your needs, you may want to
  * extend it to include additional functionality or error handling.
  *
+ * The Instrumentation policy (see Common/Instrumentation.h) is notified of the heap array
+ * (re)allocations, visited positions and comparisons. The default NoInstrumentation compiles to nothing.
+ *
+ * Items are ordered by the Compare policy (std::less by default); the item ordered last is at the top.
+ *
  * @author: Mahmoud Ashraf
  * @date 16/8/2023
  */
@@ -29,13 +34,21 @@
 
 
 
+#include <functional>
 #include <vector>
 #include <iostream>
 
-template<typename Comparable>
+#include "../Common/Instrumentation.h"
+
+template<typename Comparable, typename Compare = std::less<Comparable>, typename Instrumentation = NoInstrumentation>
 class BinaryMaxHeap {
 public:
     /*region Constructors */
+    BinaryMaxHeap() = default;
+    /**
+     * @brief Constructs an empty heap ordered by the given comparator.
+     * */
+    explicit BinaryMaxHeap(const Compare& compare);
     /*endregion*/
 
     /*region Constant Public Methods */
@@ -84,6 +97,7 @@ public:
 
 private:
     std::vector<Comparable> heap;
+    Compare compare;
 
     /*region Private Constant (and Static) Methods */
     static int getParentIndex(int itemIndex);
@@ -91,17 +105,12 @@ private:
     static int getLeftChildIndex(int parentIndex);
 
     Comparable parentValue(int itemIndex) const;
+
     /**
-     * @brief Checks whether a node at the given index needs to be moved down in the heap.
-     *
-     * This function determines whether the node at the specified index should be moved down
-     * in the binary max-heap to maintain the max-heap property.
-     *
-     * @tparam Comparable The type of elements stored in the heap. It should be a comparable type.
-     * @param itemIndex The index of the node to be checked.
-     * @return `true` if the node needs to be moved down, `false` otherwise.
+     * @brief Compares two items, reporting the comparison to the Instrumentation policy.
+     * @return `true` if first is greater than second, `false` otherwise.
      */
-    [[nodiscard]] bool needsBubbleDown(int itemIndex) const;
+    bool isGreater(const Comparable& first, const Comparable& second) const;
     /**
      * @brief Checks whether a node at the given index needs to be moved up in the heap.
      *
@@ -144,56 +153,71 @@ private:
 
 };
 
+/*region Constructors */
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+BinaryMaxHeap<Comparable, Compare, Instrumentation>::BinaryMaxHeap(const Compare& compare) : compare(compare) {
+}
+
+/*endregion*/
+
 /*region Public Constant Methods */
 
-template<typename Comparable>
-Comparable BinaryMaxHeap<Comparable>::getMax() const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+Comparable BinaryMaxHeap<Comparable, Compare, Instrumentation>::getMax() const {
     if(size() == 0) throw std::runtime_error("Heap is empty");
 
     return heap[0];
 }
 
-template<typename Comparable>
-int BinaryMaxHeap<Comparable>::size() const{
+template<typename Comparable, typename Compare, typename Instrumentation>
+int BinaryMaxHeap<Comparable, Compare, Instrumentation>::size() const{
     return heap.size();
 }
 
-template<typename Comparable>
-bool BinaryMaxHeap<Comparable>::isEmpty() const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool BinaryMaxHeap<Comparable, Compare, Instrumentation>::isEmpty() const {
     return size() == 0;
 }
 
 /*endregion*/
 
 /*region Public Non-Const Methods */
-template<typename Comparable>
-void BinaryMaxHeap<Comparable>::insert(const Comparable &item) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinaryMaxHeap<Comparable, Compare, Instrumentation>::insert(const Comparable &item) {
+    auto previousCapacity = heap.capacity();
     heap.push_back(item);
 
+    // Report the heap array growth as a new allocation replacing the old one
+    if(heap.capacity() != previousCapacity) {
+        Instrumentation::onAllocate(heap.capacity() * sizeof(Comparable));
+        if(previousCapacity) Instrumentation::onDeallocate(previousCapacity * sizeof(Comparable));
+    }
+
     // If needed, bubble up the recently added item until it doesn't
     // violate the heap property
     int itemIndex = heap.size() - 1;
     bubbleUp(itemIndex);
 }
 
-template<typename Comparable>
-void BinaryMaxHeap<Comparable>::insert(Comparable&& item) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinaryMaxHeap<Comparable, Compare, Instrumentation>::insert(Comparable&& item) {
     insert(item);
 }
 
-template<typename Comparable>
-void BinaryMaxHeap<Comparable>::removeMax() {
-    int lastItem = heap[size() - 1];
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinaryMaxHeap<Comparable, Compare, Instrumentation>::removeMax() {
+    Comparable lastItem = std::move(heap.back());
     heap.pop_back();
     if(!heap.empty()){
-        heap[0] = lastItem;
+        heap[0] = std::move(lastItem);
 
         bubbleDown(0);
     }
 }
 
-template<typename Comparable>
-Comparable BinaryMaxHeap<Comparable>::extractMax() {
+template<typename Comparable, typename Compare, typename Instrumentation>
+Comparable BinaryMaxHeap<Comparable, Compare, Instrumentation>::extractMax() {
     if(heap.empty()) throw std::out_of_range("Heap is empty.");
 
     Comparable max = heap[0];
@@ -204,57 +228,44 @@ Comparable BinaryMaxHeap<Comparable>::extractMax() {
 /*endregion*/
 
 /*region Private Constant (and Static) Methods */
-template<typename Comparable>
-int BinaryMaxHeap<Comparable>::getRightChildIndex(int parentIndex){
+template<typename Comparable, typename Compare, typename Instrumentation>
+int BinaryMaxHeap<Comparable, Compare, Instrumentation>::getRightChildIndex(int parentIndex){
     return parentIndex * 2 + 2;
 }
 
-template<typename Comparable>
-int BinaryMaxHeap<Comparable>::getLeftChildIndex(int parentIndex){
+template<typename Comparable, typename Compare, typename Instrumentation>
+int BinaryMaxHeap<Comparable, Compare, Instrumentation>::getLeftChildIndex(int parentIndex){
     return parentIndex * 2 + 1;
 }
-template<typename Comparable>
-int BinaryMaxHeap<Comparable>::getParentIndex(int itemIndex){
+template<typename Comparable, typename Compare, typename Instrumentation>
+int BinaryMaxHeap<Comparable, Compare, Instrumentation>::getParentIndex(int itemIndex){
     return (itemIndex - 1) / 2;
 }
 
-template<typename Comparable>
-Comparable BinaryMaxHeap<Comparable>::parentValue(int itemIndex) const{
+template<typename Comparable, typename Compare, typename Instrumentation>
+Comparable BinaryMaxHeap<Comparable, Compare, Instrumentation>::parentValue(int itemIndex) const{
     return heap[getParentIndex(itemIndex)];
 }
 
-template<typename Comparable>
-bool BinaryMaxHeap<Comparable>::needsBubbleDown(int itemIndex) const{
-    int rightChildIndex = getRightChildIndex(itemIndex);
-    // if right child exists and is larger, bubble down is needed
-    if( rightChildIndex < size() &&
-        heap[rightChildIndex] > heap[itemIndex] ){
-        return true;
-    };
-
-    // if left child exists and is larger, bubble down is needed
-    int leftChildIndex = getLeftChildIndex(itemIndex);
-    if( leftChildIndex < size() &&
-        heap[leftChildIndex] > heap[itemIndex] ){
-        return true;
-    };
-
-    // else no bubble down needed
-    return false;
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool BinaryMaxHeap<Comparable, Compare, Instrumentation>::isGreater(const Comparable &first, const Comparable &second) const {
+    Instrumentation::onCompare();
+    return compare(second, first);
 }
 
-template<typename Comparable>
-bool BinaryMaxHeap<Comparable>::needsBubbleUp(int itemIndex) const {
-    return itemIndex > 0 && heap[itemIndex] > parentValue(itemIndex);
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool BinaryMaxHeap<Comparable, Compare, Instrumentation>::needsBubbleUp(int itemIndex) const {
+    return itemIndex > 0 && isGreater(heap[itemIndex], heap[getParentIndex(itemIndex)]);
 }
 
 /*endregion*/
 
 /*region Private Non-Constant methods **/
 
-template<typename Comparable>
-void BinaryMaxHeap<Comparable>::bubbleUp(int itemIndex) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinaryMaxHeap<Comparable, Compare, Instrumentation>::bubbleUp(int itemIndex) {
     while(needsBubbleUp(itemIndex)){
+        Instrumentation::onVisit();
         int parentIndex = getParentIndex(itemIndex);
         if(parentIndex >= 0)
             std::swap(heap[parentIndex],heap[itemIndex]);
@@ -264,33 +275,24 @@ void BinaryMaxHeap<Comparable>::bubbleUp(int itemIndex) {
 }
 
 
-template<typename Comparable>
-void BinaryMaxHeap<Comparable>::bubbleDown(int index) {
-
-    while(needsBubbleDown(index)) {
-
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinaryMaxHeap<Comparable, Compare, Instrumentation>::bubbleDown(int index) {
+    while(true) {
         // get indexes of node's left and right children
-        int rightChildIndex = getRightChildIndex(index);
         int leftChildIndex = getLeftChildIndex(index);
+        int rightChildIndex = getRightChildIndex(index);
 
-        int indexToSwapWith;
-
-        // if node has two children,
-        // swap it with the larger
-        if (rightChildIndex < size() && leftChildIndex < size()) {
-            if (heap[rightChildIndex] >= heap[leftChildIndex])
-                indexToSwapWith = rightChildIndex;
-            else
-                indexToSwapWith = leftChildIndex;
-        }
-            // if only has a rightChild
-        else if (rightChildIndex < size())
+        // node has no children
+        if (leftChildIndex >= size()) return;
+
+        // pick the larger child, then bubble down only if it is larger than the node,
+        // which takes two comparisons per level
+        int indexToSwapWith = leftChildIndex;
+        if (rightChildIndex < size() && isGreater(heap[rightChildIndex], heap[leftChildIndex]))
             indexToSwapWith = rightChildIndex;
-            // if only has left Child
-        else if (leftChildIndex < size())
-            indexToSwapWith = leftChildIndex;
-            // node has no children
-        else return;
+
+        if (!isGreater(heap[indexToSwapWith], heap[index])) return;
+        Instrumentation::onVisit();
 
         std::swap(heap[indexToSwapWith], heap[index]);
         index = indexToSwapWith;
@@ -23,18 +23,31 @@
  * demonstration of a binary min heap. Depending on your needs, you may want to
  * extend it to include additional functionality or error handling.
  *
+ * The Instrumentation policy (see Common/Instrumentation.h) is notified of the heap array
+ * (re)allocations, visited positions and comparisons. The default NoInstrumentation compiles to nothing.
+ *
+ * Items are ordered by the Compare policy (std::less by default); the item ordered first is at the top.
+ *
  * GitHub Repository: https://github.com/Mahmoud-Ameen/Data-Structures-in-CPP
  */
 #ifndef DSA_MINHEAP_H
 #define DSA_MINHEAP_H
 
+#include <functional>
 #include <vector>
 #include <iostream>
 
-template<typename Comparable>
+#include "../Common/Instrumentation.h"
+
+template<typename Comparable, typename Compare = std::less<Comparable>, typename Instrumentation = NoInstrumentation>
 class BinaryMinHeap {
 public:
     /*region Constructors **/
+    BinaryMinHeap() = default;
+    /**
+     * @brief Constructs an empty heap ordered by the given comparator.
+     * */
+    explicit BinaryMinHeap(const Compare& compare);
     /*endregion*/
 
     /*region Constant Public Methods **/
@@ -83,6 +96,7 @@ public:
 
 private:
     std::vector<Comparable> heap;
+    Compare compare;
 
     /*region Private Constant (and Static) Methods */
     static int getParentIndex(int itemIndex);
@@ -90,17 +104,12 @@ private:
     static int getLeftChildIndex(int parentIndex);
 
     Comparable parentValue(int itemIndex) const;
+
     /**
-     * @brief Checks whether a node at the given index needs to be moved down in the heap.
-     *
-     * This function determines whether the node at the specified index should be moved down
-     * in the binary min-heap to maintain the min-heap property.
-     *
-     * @tparam Comparable The type of elements stored in the heap. It should be a comparable type.
-     * @param itemIndex The index of the node to be checked.
-     * @return `true` if the node needs to be moved down, `false` otherwise.
+     * @brief Compares two items, reporting the comparison to the Instrumentation policy.
+     * @return `true` if first is less than second, `false` otherwise.
      */
-    [[nodiscard]] bool needsBubbleDown(int itemIndex) const;
+    bool isLess(const Comparable& first, const Comparable& second) const;
     /**
      * @brief Checks whether a node at the given index needs to be moved up in the heap.
      *
@@ -143,56 +152,71 @@ private:
 
 };
 
+/*region Constructors */
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+BinaryMinHeap<Comparable, Compare, Instrumentation>::BinaryMinHeap(const Compare& compare) : compare(compare) {
+}
+
+/*endregion*/
+
 /*region Public Constant Methods */
 
-template<typename Comparable>
-Comparable BinaryMinHeap<Comparable>::getMin() const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+Comparable BinaryMinHeap<Comparable, Compare, Instrumentation>::getMin() const {
     if(size() == 0) throw std::runtime_error("Heap is empty");
 
     return heap[0];
 }
 
-template<typename Comparable>
-int BinaryMinHeap<Comparable>::size() const{
+template<typename Comparable, typename Compare, typename Instrumentation>
+int BinaryMinHeap<Comparable, Compare, Instrumentation>::size() const{
     return heap.size();
 }
 
-template<typename Comparable>
-bool BinaryMinHeap<Comparable>::isEmpty() const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool BinaryMinHeap<Comparable, Compare, Instrumentation>::isEmpty() const {
     return size() == 0;
 }
 
 /*endregion*/
 
 /*region Public Non-Const Methods */
-template<typename Comparable>
-void BinaryMinHeap<Comparable>::insert(const Comparable &item) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinaryMinHeap<Comparable, Compare, Instrumentation>::insert(const Comparable &item) {
+    auto previousCapacity = heap.capacity();
     heap.push_back(item);
 
+    // Report the heap array growth as a new allocation replacing the old one
+    if(heap.capacity() != previousCapacity) {
+        Instrumentation::onAllocate(heap.capacity() * sizeof(Comparable));
+        if(previousCapacity) Instrumentation::onDeallocate(previousCapacity * sizeof(Comparable));
+    }
+
     // If needed, bubble up the recently added item until it doesn't
     // violate the heap property
     int itemIndex = heap.size() - 1;
     bubbleUp(itemIndex);
 }
 
-template<typename Comparable>
-void BinaryMinHeap<Comparable>::insert(Comparable&& item) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinaryMinHeap<Comparable, Compare, Instrumentation>::insert(Comparable&& item) {
     insert(item);
 }
 
-template<typename Comparable>
-void BinaryMinHeap<Comparable>::removeMin() {
-    int lastItem = heap[size() - 1];
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinaryMinHeap<Comparable, Compare, Instrumentation>::removeMin() {
+    Comparable lastItem = std::move(heap.back());
     heap.pop_back();
     if(!heap.empty()){
-        heap[0] = lastItem;
+        heap[0] = std::move(lastItem);
 
         bubbleDown(0);
     }
 }
 
-template<typename Comparable>
-Comparable BinaryMinHeap<Comparable>::extractMin() {
+template<typename Comparable, typename Compare, typename Instrumentation>
+Comparable BinaryMinHeap<Comparable, Compare, Instrumentation>::extractMin() {
     if(heap.empty()) throw std::out_of_range("Heap is empty.");
 
     Comparable min = heap[0];
@@ -203,57 +227,44 @@ Comparable BinaryMinHeap<Comparable>::extractMin() {
 /*endregion*/
 
 /*region Private Constant (and Static) Methods */
-template<typename Comparable>
-int BinaryMinHeap<Comparable>::getRightChildIndex(int parentIndex){
+template<typename Comparable, typename Compare, typename Instrumentation>
+int BinaryMinHeap<Comparable, Compare, Instrumentation>::getRightChildIndex(int parentIndex){
     return parentIndex * 2 + 2;
 }
 
-template<typename Comparable>
-int BinaryMinHeap<Comparable>::getLeftChildIndex(int parentIndex){
+template<typename Comparable, typename Compare, typename Instrumentation>
+int BinaryMinHeap<Comparable, Compare, Instrumentation>::getLeftChildIndex(int parentIndex){
     return parentIndex * 2 + 1;
 }
-template<typename Comparable>
-int BinaryMinHeap<Comparable>::getParentIndex(int itemIndex){
+template<typename Comparable, typename Compare, typename Instrumentation>
+int BinaryMinHeap<Comparable, Compare, Instrumentation>::getParentIndex(int itemIndex){
     return (itemIndex - 1) / 2;
 }
 
-template<typename Comparable>
-Comparable BinaryMinHeap<Comparable>::parentValue(int itemIndex) const{
+template<typename Comparable, typename Compare, typename Instrumentation>
+Comparable BinaryMinHeap<Comparable, Compare, Instrumentation>::parentValue(int itemIndex) const{
     return heap[getParentIndex(itemIndex)];
 }
 
-template<typename Comparable>
-bool BinaryMinHeap<Comparable>::needsBubbleDown(int itemIndex) const{
-    int rightChildIndex = getRightChildIndex(itemIndex);
-    // if right child exists and is smaller, bubble down is needed
-    if( rightChildIndex < size() &&
-        heap[rightChildIndex] < heap[itemIndex] ){
-        return true;
-    };
-
-    // if left child exists and is smaller, bubble down is needed
-    int leftChildIndex = getLeftChildIndex(itemIndex);
-    if( leftChildIndex < size() &&
-        heap[leftChildIndex] < heap[itemIndex] ){
-        return true;
-    };
-
-    // else no bubble down needed
-    return false;
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool BinaryMinHeap<Comparable, Compare, Instrumentation>::isLess(const Comparable &first, const Comparable &second) const {
+    Instrumentation::onCompare();
+    return compare(first, second);
 }
 
-template<typename Comparable>
-bool BinaryMinHeap<Comparable>::needsBubbleUp(int itemIndex) const {
-    return itemIndex > 0 && heap[itemIndex] < parentValue(itemIndex);
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool BinaryMinHeap<Comparable, Compare, Instrumentation>::needsBubbleUp(int itemIndex) const {
+    return itemIndex > 0 && isLess(heap[itemIndex], heap[getParentIndex(itemIndex)]);
 }
 
 /*endregion*/
 
 /*region Private Non-Constant methods **/
 
-template<typename Comparable>
-void BinaryMinHeap<Comparable>::bubbleUp(int itemIndex) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinaryMinHeap<Comparable, Compare, Instrumentation>::bubbleUp(int itemIndex) {
     while(needsBubbleUp(itemIndex)){
+        Instrumentation::onVisit();
         int parentIndex = getParentIndex(itemIndex);
         if(parentIndex >= 0)
             std::swap(heap[parentIndex],heap[itemIndex]);
@@ -263,33 +274,24 @@ void BinaryMinHeap<Comparable>::bubbleUp(int itemIndex) {
 }
 
 
-template<typename Comparable>
-void BinaryMinHeap<Comparable>::bubbleDown(int index) {
-
-    while(needsBubbleDown(index)) {
-
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinaryMinHeap<Comparable, Compare, Instrumentation>::bubbleDown(int index) {
+    while(true) {
         // get indexes of node's left and right children
-        int rightChildIndex = getRightChildIndex(index);
         int leftChildIndex = getLeftChildIndex(index);
+        int rightChildIndex = getRightChildIndex(index);
 
-        int indexToSwapWith;
-
-        // if node has two children,
-        // swap it with the smaller
-        if (rightChildIndex < size() && leftChildIndex < size()) {
-            if (heap[rightChildIndex] <= heap[leftChildIndex])
-                indexToSwapWith = rightChildIndex;
-            else
-                indexToSwapWith = leftChildIndex;
-        }
-        // if only has a rightChild
-        else if (rightChildIndex < size())
-            indexToSwapWith = rightChildIndex;
-        // if only has left Child
-        else if (leftChildIndex < size())
-            indexToSwapWith = leftChildIndex;
         // node has no children
-        else return;
+        if (leftChildIndex >= size()) return;
+
+        // pick the smaller child, then bubble down only if it is smaller than the node,
+        // which takes two comparisons per level
+        int indexToSwapWith = leftChildIndex;
+        if (rightChildIndex < size() && isLess(heap[rightChildIndex], heap[leftChildIndex]))
+            indexToSwapWith = rightChildIndex;
+
+        if (!isLess(heap[indexToSwapWith], heap[index])) return;
+        Instrumentation::onVisit();
 
         std::swap(heap[indexToSwapWith], heap[index]);
         index = indexToSwapWith;
@@ -22,6 +22,14 @@
  * demonstration of a binomial min heap. Depending on your needs, you may want to
  * extend it to include additional functionality or error handling.
  *
+ * The Instrumentation policy (see Common/Instrumentation.h) is notified of node allocations,
+ * visited roots and comparisons. The default NoInstrumentation compiles to nothing.
+ *
+ * Items are ordered by the Compare policy (std::less by default); getMin() returns the item ordered first.
+ *
+ * Nodes are allocated from a std::pmr::memory_resource given at construction (the default resource
+ * otherwise). Copies use the default resource, moves carry the nodes along with their resource.
+ *
  * @author: Mahmoud Ashraf
  * @date 18/8/2023
  */
@@ -29,11 +37,17 @@
 #ifndef DSA_BINOMIALMINHEAP_H
 #define DSA_BINOMIALMINHEAP_H
 
+#include <functional>
+#include <memory_resource>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 #include <cmath>
 
-template<typename Comparable>
+#include "../Common/Instrumentation.h"
+#include "../Common/MemoryResource.h"
+
+template<typename Comparable, typename Compare = std::less<Comparable>, typename Instrumentation = NoInstrumentation>
 class BinomialMinHeap {
 public:
     /*region Big Five */
@@ -41,6 +55,12 @@ public:
     // Default constructor
     BinomialMinHeap() = default;
 
+    // Constructs an empty heap allocating its nodes from the given memory resource, which must outlive the heap
+    explicit BinomialMinHeap(std::pmr::memory_resource* resource);
+
+    // Constructs an empty heap ordered by the given comparator
+    explicit BinomialMinHeap(const Compare& compare, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
     // Copy constructor
     BinomialMinHeap(const BinomialMinHeap& other);
 
@@ -86,6 +106,11 @@ public:
      * */
     [[nodiscard]] int size() const;
 
+    /**
+     * @return the memory resource the heap's nodes are allocated from
+     * */
+    [[nodiscard]] std::pmr::memory_resource* getMemoryResource() const;
+
     /*endregion*/
 
     /* region Public non-constant methods*/
@@ -120,6 +145,7 @@ public:
      *
      * @param heap The binomial heap to be merged into the current heap. After merging,
      *             the merged heap will be empty.
+     * @throws std::invalid_argument If the heaps don't allocate from the same memory resource.
      */
     void merge(BinomialMinHeap& heap);
 
@@ -158,6 +184,9 @@ private:
      * */
     std::vector<BinomialTreeNode*> forest;
 
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+    Compare compare;
+
 
     /* region Private constant methods*/
 
@@ -259,8 +288,8 @@ private:
 /* region Internal struct BinomialTreeNode  */
 
 //
-template<typename Comparable>
-struct BinomialMinHeap<Comparable>::BinomialTreeNode{
+template<typename Comparable, typename Compare, typename Instrumentation>
+struct BinomialMinHeap<Comparable, Compare, Instrumentation>::BinomialTreeNode{
 public:
     Comparable data;
     BinomialTreeNode* leftChild;
@@ -281,9 +310,18 @@ public:
 
 /*region Big Five*/
 
+template<typename Comparable, typename Compare, typename Instrumentation>
+BinomialMinHeap<Comparable, Compare, Instrumentation>::BinomialMinHeap(std::pmr::memory_resource *resource) : resource(resource) {
+}
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+BinomialMinHeap<Comparable, Compare, Instrumentation>::BinomialMinHeap(const Compare& compare, std::pmr::memory_resource *resource)
+    : resource(resource), compare(compare) {
+}
+
 // Copy constructor
-template<typename Comparable>
-BinomialMinHeap<Comparable>::BinomialMinHeap(const BinomialMinHeap& other) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+BinomialMinHeap<Comparable, Compare, Instrumentation>::BinomialMinHeap(const BinomialMinHeap& other) : compare(other.compare) {
 
     // Perform deep copy of the other heap's state
 
@@ -298,9 +336,9 @@ BinomialMinHeap<Comparable>::BinomialMinHeap(const BinomialMinHeap& other) {
 }
 
 // Move constructor
-template<typename Comparable>
-BinomialMinHeap<Comparable>::BinomialMinHeap(BinomialMinHeap&& other) noexcept
-        : forest(std::move(other.forest)), mSize(other.mSize) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+BinomialMinHeap<Comparable, Compare, Instrumentation>::BinomialMinHeap(BinomialMinHeap&& other) noexcept
+        : mSize(other.mSize), forest(std::move(other.forest)), resource(other.resource), compare(other.compare) {
     // Reset other's state to leave it in a valid but unspecified state
 
     other.forest.clear();
@@ -308,8 +346,8 @@ BinomialMinHeap<Comparable>::BinomialMinHeap(BinomialMinHeap&& other) noexcept
 }
 
 // Copy assignment operator
-template<typename Comparable>
-BinomialMinHeap<Comparable>& BinomialMinHeap<Comparable>::operator=(const BinomialMinHeap& other) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+BinomialMinHeap<Comparable, Compare, Instrumentation>& BinomialMinHeap<Comparable, Compare, Instrumentation>::operator=(const BinomialMinHeap& other) {
     if (this != &other) {
         // Perform deep copy of the other heap's state
 
@@ -321,14 +359,15 @@ BinomialMinHeap<Comparable>& BinomialMinHeap<Comparable>::operator=(const Binomi
             forest.push_back(cloneTree(other.forest[order]));
         }
 
-        // Copy other heap's mSize
-        mSize = other.mSize;    }
+        // Copy other heap's mSize and ordering
+        mSize = other.mSize;
+        compare = other.compare;    }
     return *this;
 }
 
 // Move assignment operator
-template<typename Comparable>
-BinomialMinHeap<Comparable>& BinomialMinHeap<Comparable>::operator=(BinomialMinHeap&& other) noexcept {
+template<typename Comparable, typename Compare, typename Instrumentation>
+BinomialMinHeap<Comparable, Compare, Instrumentation>& BinomialMinHeap<Comparable, Compare, Instrumentation>::operator=(BinomialMinHeap&& other) noexcept {
     if (this != &other) {
         // Release current resources
         clearForest(forest);
@@ -336,6 +375,8 @@ BinomialMinHeap<Comparable>& BinomialMinHeap<Comparable>::operator=(BinomialMinH
         // Transfer ownership of resources from other to this
         forest = std::move(other.forest);
         mSize = other.mSize;
+        resource = other.resource;
+        compare = other.compare;
 
         // Reset other's state
         other.mSize = 0;
@@ -345,54 +386,67 @@ BinomialMinHeap<Comparable>& BinomialMinHeap<Comparable>::operator=(BinomialMinH
 }
 
 // Destructor
-template<typename Comparable>
-BinomialMinHeap<Comparable>::~BinomialMinHeap() {
+template<typename Comparable, typename Compare, typename Instrumentation>
+BinomialMinHeap<Comparable, Compare, Instrumentation>::~BinomialMinHeap() {
     clearForest(forest);
 }
 /*endregion*/
 
 /*region Public Const Methods*/
 
-template<typename Comparable>
-Comparable BinomialMinHeap<Comparable>::getMin() const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+Comparable BinomialMinHeap<Comparable, Compare, Instrumentation>::getMin() const {
     if (isEmpty()) throw std::underflow_error("Cannot find minimum element; Heap is empty!\n");
 
     auto index = minNodeIndex();
     return forest[index]->data;
 }
 
-template<typename Comparable>
-bool BinomialMinHeap<Comparable>::isEmpty() const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool BinomialMinHeap<Comparable, Compare, Instrumentation>::isEmpty() const {
     return mSize == 0;
 }
 
-template<typename Comparable>
-int BinomialMinHeap<Comparable>::size() const{
+template<typename Comparable, typename Compare, typename Instrumentation>
+int BinomialMinHeap<Comparable, Compare, Instrumentation>::size() const{
     return mSize;
 };
 
+template<typename Comparable, typename Compare, typename Instrumentation>
+std::pmr::memory_resource *BinomialMinHeap<Comparable, Compare, Instrumentation>::getMemoryResource() const {
+    return resource;
+}
+
 /*endregion*/
 
 /* region Public Non-Const Methods */
 
-template<typename Comparable>
-void BinomialMinHeap<Comparable>::insert(Comparable&& element){
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinomialMinHeap<Comparable, Compare, Instrumentation>::insert(Comparable&& element){
     insert(element);
 }
 
-template<typename Comparable>
-void BinomialMinHeap<Comparable>::insert(const Comparable &element) {
-    auto newTree = new BinomialTreeNode(element);
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinomialMinHeap<Comparable, Compare, Instrumentation>::insert(const Comparable &element) {
+    Instrumentation::onAllocate(sizeof(BinomialTreeNode));
+    auto newTree = newNode<BinomialTreeNode>(resource, element);
     insertTree(newTree);
 }
 
-template<typename Comparable>
-void BinomialMinHeap<Comparable>::merge(BinomialMinHeap &heap) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinomialMinHeap<Comparable, Compare, Instrumentation>::merge(BinomialMinHeap &heap) {
+    if(&heap == this) return;
+
+    // Merged trees are later freed with this heap's resource
+    if(*resource != *heap.resource)
+        throw std::invalid_argument("Cannot merge heaps allocating from different memory resources.");
+
     mergeForest(heap.forest);
+    heap.mSize = 0;
 }
 
-template<typename Comparable>
-void BinomialMinHeap<Comparable>::deleteMin() {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinomialMinHeap<Comparable, Compare, Instrumentation>::deleteMin() {
     // If heap is empty, throw underflow error
     if(mSize == 0) throw std::underflow_error("Cannot delete an element from an empty Heap.\n");
 
@@ -407,7 +461,8 @@ void BinomialMinHeap<Comparable>::deleteMin() {
     auto child = minRoot->leftChild;
 
     forest[minRoot->order] = nullptr;
-    delete minRoot;
+    Instrumentation::onDeallocate(sizeof(BinomialTreeNode));
+    deleteNode(resource, minRoot);
 
     // Create a forest from deleted Node's children and merge it with current forest
     while(child){
@@ -420,8 +475,8 @@ void BinomialMinHeap<Comparable>::deleteMin() {
 
 }
 
-template<typename Comparable>
-Comparable BinomialMinHeap<Comparable>::extractMin() {
+template<typename Comparable, typename Compare, typename Instrumentation>
+Comparable BinomialMinHeap<Comparable, Compare, Instrumentation>::extractMin() {
     if(isEmpty()) throw std::underflow_error("Heap is empty\n");
 
     // Get minimum element in heap before deleting it
@@ -432,16 +487,17 @@ Comparable BinomialMinHeap<Comparable>::extractMin() {
 }
 
 
-template<typename Comparable>
-typename BinomialMinHeap<Comparable>::BinomialTreeNode *
-BinomialMinHeap<Comparable>::combineTrees(BinomialMinHeap::BinomialTreeNode *first, BinomialMinHeap::BinomialTreeNode *second) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+typename BinomialMinHeap<Comparable, Compare, Instrumentation>::BinomialTreeNode *
+BinomialMinHeap<Comparable, Compare, Instrumentation>::combineTrees(BinomialMinHeap::BinomialTreeNode *first, BinomialMinHeap::BinomialTreeNode *second) {
     // Make sure no nullptr are passed to avoid runtime errors
     if(!first && !second) return nullptr;
     if(!first) return second;
     if(!second) return first;
 
     // make [second] be the tree with the larger root
-    if(first->data > second->data){
+    Instrumentation::onCompare();
+    if(compare(second->data, first->data)){
         std::swap(first,second);
     }
 
@@ -461,14 +517,18 @@ BinomialMinHeap<Comparable>::combineTrees(BinomialMinHeap::BinomialTreeNode *fir
 
 /*region Private Const Methods */
 
-template<typename Comparable>
-int BinomialMinHeap<Comparable>::minNodeIndex() const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+int BinomialMinHeap<Comparable, Compare, Instrumentation>::minNodeIndex() const {
     BinomialTreeNode* min = nullptr;
     int minIndex = -1;
 
     for (int i = 0; i < forest.size(); ++i) {
         auto node = forest[i];
-        if (node && (!min || node->data < min->data)) {
+        if (!node) continue;
+
+        Instrumentation::onVisit();
+        if(min) Instrumentation::onCompare();
+        if (!min || compare(node->data, min->data)) {
             min = node;
             minIndex = i;
         }
@@ -479,15 +539,16 @@ int BinomialMinHeap<Comparable>::minNodeIndex() const {
 }
 
 
-template<typename Comparable>
-typename BinomialMinHeap<Comparable>::BinomialTreeNode *
-BinomialMinHeap<Comparable>::cloneTree(const BinomialMinHeap::BinomialTreeNode *tree) const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+typename BinomialMinHeap<Comparable, Compare, Instrumentation>::BinomialTreeNode *
+BinomialMinHeap<Comparable, Compare, Instrumentation>::cloneTree(const BinomialMinHeap::BinomialTreeNode *tree) const {
     if (!tree) {
         return nullptr;
     }
 
     // Create a new node with the same data.
-    auto* newNode = new BinomialTreeNode(tree->data);
+    Instrumentation::onAllocate(sizeof(BinomialTreeNode));
+    auto* newNode = ::newNode<BinomialTreeNode>(resource, tree->data);
 
     // Recursively clone left child and siblings.
     newNode->leftChild = cloneTree(tree->leftChild);
@@ -501,8 +562,8 @@ BinomialMinHeap<Comparable>::cloneTree(const BinomialMinHeap::BinomialTreeNode *
 
 /*region Private non-const methods*/
 
-template<typename Comparable>
-void BinomialMinHeap<Comparable>::insertTree(BinomialMinHeap::BinomialTreeNode *treeNode) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinomialMinHeap<Comparable, Compare, Instrumentation>::insertTree(BinomialMinHeap::BinomialTreeNode *treeNode) {
     if(!treeNode) return;
 
     int treeOrder = treeNode->order;
@@ -528,8 +589,8 @@ void BinomialMinHeap<Comparable>::insertTree(BinomialMinHeap::BinomialTreeNode *
 }
 
 
-template<typename Comparable>
-void BinomialMinHeap<Comparable>::mergeForest(std::vector<BinomialTreeNode *> &otherForest) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinomialMinHeap<Comparable, Compare, Instrumentation>::mergeForest(std::vector<BinomialTreeNode *> &otherForest) {
 
     // Call insertTree method to insert each valid binomial tree in other to current forest
     int order = 0;
@@ -544,8 +605,8 @@ void BinomialMinHeap<Comparable>::mergeForest(std::vector<BinomialTreeNode *> &o
     }
 }
 
-template<typename Comparable>
-void BinomialMinHeap<Comparable>::makeEmpty(BinomialMinHeap::BinomialTreeNode *tree) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinomialMinHeap<Comparable, Compare, Instrumentation>::makeEmpty(BinomialMinHeap::BinomialTreeNode *tree) {
     if (!tree) {
         return;
     }
@@ -555,12 +616,13 @@ void BinomialMinHeap<Comparable>::makeEmpty(BinomialMinHeap::BinomialTreeNode *t
     makeEmpty(tree->nextSibling);
 
     // Deallocate memory for the current node.
-    delete tree;
+    Instrumentation::onDeallocate(sizeof(BinomialTreeNode));
+    deleteNode(resource, tree);
 }
 
 
-template<typename Comparable>
-void BinomialMinHeap<Comparable>::clearForest(std::vector<BinomialTreeNode *> &trees) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void BinomialMinHeap<Comparable, Compare, Instrumentation>::clearForest(std::vector<BinomialTreeNode *> &trees) {
     for (BinomialTreeNode* tree : trees) {
         makeEmpty(tree);
     }
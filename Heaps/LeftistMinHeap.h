@@ -5,9 +5,15 @@
 
 #include <algorithm>
 #include <iostream>
+#include <functional>
+#include <memory_resource>
 #include <stack>
+#include <stdexcept>
 
-template<typename Comparable>
+#include "../Common/Instrumentation.h"
+#include "../Common/MemoryResource.h"
+
+template<typename Comparable, typename Compare = std::less<Comparable>, typename Instrumentation = NoInstrumentation>
 class LeftistMinHeap {
 
 public:
@@ -16,6 +22,12 @@ public:
     // Default Constructor
     LeftistMinHeap() = default;
 
+    // Constructs an empty heap allocating its nodes from the given memory resource, which must outlive the heap
+    explicit LeftistMinHeap(std::pmr::memory_resource* resource);
+
+    // Constructs an empty heap ordered by the given comparator
+    explicit LeftistMinHeap(const Compare& compare, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
     // Copy Constructor
     LeftistMinHeap(const LeftistMinHeap& other);
 
@@ -45,6 +57,11 @@ public:
      * */
     [[nodiscard]] bool isEmpty() const;
 
+    /**
+     * @return the memory resource the heap's nodes are allocated from
+     * */
+    [[nodiscard]] std::pmr::memory_resource* getMemoryResource() const;
+
     /*endregion*/
 
     /*region Non-Constant Methods*/
@@ -61,6 +78,7 @@ public:
     /**
      * @brief merges two heaps together
      * @param rhs heap to be merged with this one
+     * @throws std::invalid_argument If the heaps don't allocate from the same memory resource.
      * */
     void merge(LeftistMinHeap& rhs);
 
@@ -83,6 +101,8 @@ private:
 
     Node* root = nullptr;
     int m_size = 0;
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+    Compare compare;
 
     /*region Private Non-Const Methods */
     Node* merge(Node* first,Node* second);
@@ -100,7 +120,8 @@ private:
         if (!node) {
             return nullptr;
         }
-        Node* new_node = new Node(node->value);
+        Instrumentation::onAllocate(sizeof(Node));
+        Node* new_node = newNode<Node>(resource, node->value);
         new_node->rank = node->rank;
         new_node->left = deepCopy(node->left);
         new_node->right = deepCopy(node->right);
@@ -112,8 +133,8 @@ private:
 };
 
 /*region Leftist Heap Node */
-template<typename Comparable>
-struct LeftistMinHeap<Comparable>::Node{
+template<typename Comparable, typename Compare, typename Instrumentation>
+struct LeftistMinHeap<Comparable, Compare, Instrumentation>::Node{
     Comparable value;
     int rank;
 
@@ -127,24 +148,34 @@ struct LeftistMinHeap<Comparable>::Node{
 
 /*region Big Five **/
 
-template<typename Comparable>
-LeftistMinHeap<Comparable>::~LeftistMinHeap() {
+template<typename Comparable, typename Compare, typename Instrumentation>
+LeftistMinHeap<Comparable, Compare, Instrumentation>::LeftistMinHeap(std::pmr::memory_resource *resource) : resource(resource) {
+}
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+LeftistMinHeap<Comparable, Compare, Instrumentation>::LeftistMinHeap(const Compare& compare, std::pmr::memory_resource *resource)
+    : resource(resource), compare(compare) {
+}
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+LeftistMinHeap<Comparable, Compare, Instrumentation>::~LeftistMinHeap() {
     clear(root);
     root = nullptr;
 }
 
-template<typename Comparable>
-LeftistMinHeap<Comparable>::LeftistMinHeap(const LeftistMinHeap<Comparable> &other) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+LeftistMinHeap<Comparable, Compare, Instrumentation>::LeftistMinHeap(const LeftistMinHeap<Comparable, Compare, Instrumentation> &other) : compare(other.compare) {
     root = deepCopy(other.root);
     m_size = other.m_size;
 }
 
-template<typename Comparable>
-LeftistMinHeap<Comparable>& LeftistMinHeap<Comparable>::operator=(const LeftistMinHeap& other){
+template<typename Comparable, typename Compare, typename Instrumentation>
+LeftistMinHeap<Comparable, Compare, Instrumentation>& LeftistMinHeap<Comparable, Compare, Instrumentation>::operator=(const LeftistMinHeap& other){
     if (this != &other) {
         clear(root);
         root = deepCopy(other.root);
         m_size = other.m_size;
+        compare = other.compare;
     }
     return *this;
 };
@@ -154,40 +185,50 @@ LeftistMinHeap<Comparable>& LeftistMinHeap<Comparable>::operator=(const LeftistM
 
 /*region Public Const Methods*/
 
-template<typename Comparable>
-bool LeftistMinHeap<Comparable>::isEmpty() const{
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool LeftistMinHeap<Comparable, Compare, Instrumentation>::isEmpty() const{
     return root == nullptr;
 }
 
-template<typename Comparable>
-Comparable LeftistMinHeap<Comparable>::getMin() const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+Comparable LeftistMinHeap<Comparable, Compare, Instrumentation>::getMin() const {
     if(isEmpty()) throw std::underflow_error("Heap is empty!\n");
     return root->value;
 }
 
-template<typename Comparable>
-int LeftistMinHeap<Comparable>::size() const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+int LeftistMinHeap<Comparable, Compare, Instrumentation>::size() const {
     return m_size;
 }
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+std::pmr::memory_resource *LeftistMinHeap<Comparable, Compare, Instrumentation>::getMemoryResource() const {
+    return resource;
+}
 /*endregion*/
 
 /*region Public Non-Const Methods */
 
-template<typename Comparable>
-void LeftistMinHeap<Comparable>::insert(const Comparable &item) {
-    root = merge(root, new Node{item} );
+template<typename Comparable, typename Compare, typename Instrumentation>
+void LeftistMinHeap<Comparable, Compare, Instrumentation>::insert(const Comparable &item) {
+    Instrumentation::onAllocate(sizeof(Node));
+    root = merge(root, newNode<Node>(resource, item) );
     m_size++;
 }
 
-template<typename Comparable>
-void LeftistMinHeap<Comparable>::insert(Comparable &&item) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void LeftistMinHeap<Comparable, Compare, Instrumentation>::insert(Comparable &&item) {
     insert(item);
 }
 
-template<typename Comparable>
-void LeftistMinHeap<Comparable>::merge(LeftistMinHeap &rhs) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void LeftistMinHeap<Comparable, Compare, Instrumentation>::merge(LeftistMinHeap &rhs) {
     if(&rhs == this) return;
 
+    // Merged nodes are later freed with this heap's resource
+    if(*resource != *rhs.resource)
+        throw std::invalid_argument("Cannot merge heaps allocating from different memory resources.");
+
     root = merge(root,rhs.root);
 
     m_size += rhs.m_size;
@@ -195,19 +236,20 @@ void LeftistMinHeap<Comparable>::merge(LeftistMinHeap &rhs) {
     rhs.root = nullptr;
 }
 
-template<typename Comparable>
-void LeftistMinHeap<Comparable>::removeMin() {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void LeftistMinHeap<Comparable, Compare, Instrumentation>::removeMin() {
     if(isEmpty()) throw std::runtime_error("Heap is empty. Cannot delete minimum element.");
 
     Node* initialRoot = root;
     root = merge(root->left,root->right);
-    delete initialRoot;
+    Instrumentation::onDeallocate(sizeof(Node));
+    deleteNode(resource, initialRoot);
 
     m_size--;
 }
 
-template<typename Comparable>
-Comparable LeftistMinHeap<Comparable>::extractMin() {
+template<typename Comparable, typename Compare, typename Instrumentation>
+Comparable LeftistMinHeap<Comparable, Compare, Instrumentation>::extractMin() {
     if(isEmpty()) throw std::runtime_error("Heap is empty. Cannot delete minimum element.");
 
     auto minVal = root->value;
@@ -220,13 +262,16 @@ Comparable LeftistMinHeap<Comparable>::extractMin() {
 
 /*region Private Non-Const Methods */
 
-template<typename Comparable>
-typename LeftistMinHeap<Comparable>::Node *LeftistMinHeap<Comparable>::merge(LeftistMinHeap::Node *first, LeftistMinHeap::Node *second) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+typename LeftistMinHeap<Comparable, Compare, Instrumentation>::Node *LeftistMinHeap<Comparable, Compare, Instrumentation>::merge(LeftistMinHeap::Node *first, LeftistMinHeap::Node *second) {
     if (first == nullptr) return second;
     if (second == nullptr) return first;
 
+    Instrumentation::onVisit();
+
     // make first the heap with smaller root
-    if (first->value > second->value)
+    Instrumentation::onCompare();
+    if (compare(second->value, first->value))
         std::swap(first, second);
 
     first->right = merge(first->right, second);
@@ -240,8 +285,8 @@ typename LeftistMinHeap<Comparable>::Node *LeftistMinHeap<Comparable>::merge(Lef
 }
 
 
-template<typename Comparable>
-void LeftistMinHeap<Comparable>::clear(LeftistMinHeap::Node *node) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void LeftistMinHeap<Comparable, Compare, Instrumentation>::clear(LeftistMinHeap::Node *node) {
     if (!node)
         return;
 
@@ -257,7 +302,8 @@ void LeftistMinHeap<Comparable>::clear(LeftistMinHeap::Node *node) {
         if (current->right)
             nodeStack.push(current->right);
 
-        delete current;
+        Instrumentation::onDeallocate(sizeof(Node));
+        deleteNode(resource, current);
     }
 }
 
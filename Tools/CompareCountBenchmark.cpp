@@ -0,0 +1,239 @@
+/**
+ * @file CompareCountBenchmark.cpp
+ * @brief Counts the key comparisons of the trees and heaps, checking that three-way comparison takes one per node.
+ *
+ * Usage:
+ *   CompareCountBenchmark [<keys>]
+ *
+ *   <keys>  Random string keys (20000 by default), 24 characters of which the first 18 are shared,
+ *           so every comparison reads past them, like expensive keys do.
+ *
+ * Trees: AVLTree and BinarySearchTree insert the keys, look up every key and as many absent ones,
+ * then remove half of the keys, instantiated twice:
+ *  - with CountingLess, a "less" predicate, which takes the two-comparison path of threeWayCompare()
+ *    (compare(a, b), then compare(b, a)), the cost of the former `value > node` / `value < node` code,
+ *  - with CountingThreeWay, a three-way comparator returning std::strong_ordering (C++20), which takes
+ *    one comparison per node.
+ * Heaps: BinaryMinHeap, BinomialMinHeap and LeftistMinHeap insert the keys and extract them all.
+ * BinaryMinHeap is checked against a copy of its former sift-down, which compared the right child, then
+ * the left one, with the node and then both children with each other: two comparisons per level when the
+ * right child is smaller than the node, three otherwise. The current one always takes two.
+ *
+ * Both the comparator calls and the comparisons reported to CountingInstrumentation are printed per
+ * operation, and the tool fails (exit code 1) if they disagree, if a three-way tree takes more than
+ * one comparison per visited node, or if the new paths take more comparisons than the old ones.
+ *
+ * Build (from the repository root), C++20 for the three-way comparator:
+ *   g++ -std=c++20 -O2 Tools/CompareCountBenchmark.cpp -o CompareCountBenchmark
+ * Under C++17 only the "less" paths are counted.
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Common/Instrumentation.h"
+#include "../Common/ThreeWayCompare.h"
+#include "../Heaps/BinaryMinHeap.h"
+#include "../Heaps/BinomialMinHeap.h"
+#include "../Heaps/LeftistMinHeap.h"
+#include "../Trees/AVLTree.h"
+#include "../Trees/BinarySearchTree.h"
+
+static std::uint64_t comparatorCalls = 0;
+static bool failed = false;
+
+/**
+ * @brief "Less" predicate counting its calls, threeWayCompare() needs two of them to tell greater from equal.
+ */
+struct CountingLess {
+    bool operator()(const std::string& first, const std::string& second) const {
+        comparatorCalls++;
+        return first < second;
+    }
+};
+
+#ifdef DSA_HAS_THREE_WAY_COMPARISON
+/**
+ * @brief Three-way comparator counting its calls.
+ */
+struct CountingThreeWay {
+    std::strong_ordering operator()(const std::string& first, const std::string& second) const {
+        comparatorCalls++;
+        return first.compare(second) <=> 0;
+    }
+};
+#endif
+
+static void check(bool condition, const std::string& message) {
+    if (condition) return;
+    std::cout << "FAILED: " << message << "\n";
+    failed = true;
+}
+
+/**
+ * @brief Runs an operation over every key, printing the comparisons per operation.
+ * @return comparisons counted by the comparator.
+ */
+template<typename Operation>
+static std::uint64_t count(const std::string& name, std::size_t operations, Operation operation) {
+    comparatorCalls = 0;
+    CountingInstrumentation::Scope scope;
+    operation();
+    InstrumentationCounters counted = scope.elapsed();
+
+    check(counted.comparisons == comparatorCalls, name + ": instrumentation and comparator counts differ");
+    std::cout << "  " << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << static_cast<double>(comparatorCalls) / operations << " comparisons per operation";
+    if (counted.nodeVisits > 0)
+        std::cout << ", " << std::setw(6) << static_cast<double>(comparatorCalls) / counted.nodeVisits << " per node visit";
+    std::cout << "\n";
+    return comparatorCalls;
+}
+
+struct TreeCounts {
+    std::uint64_t insert = 0, contains = 0, remove = 0;
+};
+
+template<typename Tree>
+static TreeCounts countTree(const std::string& name, const std::vector<std::string>& keys,
+                            const std::vector<std::string>& absent) {
+    Tree tree;
+    TreeCounts counts;
+    std::cout << name << "\n";
+    counts.insert = count("insert", keys.size(), [&] { for (const auto& key : keys) tree.insert(key); });
+    counts.contains = count("contains (half absent)", 2 * keys.size(), [&] {
+        std::size_t found = 0;
+        for (const auto& key : keys) found += tree.contains(key);
+        for (const auto& key : absent) found += tree.contains(key);
+        check(found == keys.size(), name + ": lookups found " + std::to_string(found) + " keys");
+    });
+    counts.remove = count("remove (half of the keys)", keys.size() / 2, [&] {
+        for (std::size_t i = 0; i < keys.size(); i += 2) tree.remove(keys[i]);
+    });
+    return counts;
+}
+
+#ifdef DSA_HAS_THREE_WAY_COMPARISON
+/**
+ * @brief Checks that a three-way tree takes at most one comparison per visited node, and fewer than the less path.
+ */
+template<typename Tree>
+static void checkThreeWay(const std::string& name, const std::vector<std::string>& keys,
+                          const std::vector<std::string>& absent, const TreeCounts& less) {
+    comparatorCalls = 0;
+    CountingInstrumentation::Scope scope;
+    TreeCounts threeWay = countTree<Tree>(name, keys, absent);
+    InstrumentationCounters counted = scope.elapsed();
+    check(counted.comparisons <= counted.nodeVisits, name + ": more than one comparison per visited node");
+    check(threeWay.insert < less.insert, name + ": three-way inserts don't take fewer comparisons");
+    check(threeWay.contains < less.contains, name + ": three-way lookups don't take fewer comparisons");
+    check(threeWay.remove < less.remove, name + ": three-way removals don't take fewer comparisons");
+}
+#endif
+
+/**
+ * @brief Former BinaryMinHeap sift-down: both children compared with the node, then with each other.
+ * @return comparisons taken to extract every key, after inserting them as BinaryMinHeap does.
+ */
+static std::uint64_t formerExtractAll(const std::vector<std::string>& keys) {
+    std::vector<std::string> heap;
+    for (const auto& key : keys) {
+        heap.push_back(key);
+        for (std::size_t index = heap.size() - 1; index > 0 && heap[index] < heap[(index - 1) / 2];) {
+            std::swap(heap[index], heap[(index - 1) / 2]);
+            index = (index - 1) / 2;
+        }
+    }
+
+    std::uint64_t comparisons = 0;
+    auto less = [&](const std::string& first, const std::string& second) {
+        comparisons++;
+        return first < second;
+    };
+    auto size = [&] { return static_cast<int>(heap.size()); };
+    auto needsBubbleDown = [&](int index) {
+        int left = 2 * index + 1, right = 2 * index + 2;
+        return (right < size() && less(heap[right], heap[index])) || (left < size() && less(heap[left], heap[index]));
+    };
+
+    while (!heap.empty()) {
+        heap[0] = std::move(heap.back());
+        heap.pop_back();
+        int index = 0;
+        while (needsBubbleDown(index)) {
+            int left = 2 * index + 1, right = 2 * index + 2;
+            int swapWith = right < size() && !less(heap[left], heap[right]) ? right : left;
+            std::swap(heap[swapWith], heap[index]);
+            index = swapWith;
+        }
+    }
+    return comparisons;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t keysCount = argc > 1 ? std::stoull(argv[1]) : 20000;
+
+    std::mt19937_64 random(42);
+    auto randomKey = [&] {
+        std::string key = "customer/region-0/";
+        while (key.size() < 24) key += static_cast<char>('a' + random() % 26);
+        return key;
+    };
+    std::vector<std::string> keys(keysCount), absent(keysCount);
+    for (auto& key : keys) key = randomKey();
+    for (auto& key : absent) key = randomKey() + "#";
+
+    // Trees
+    auto avlLess = countTree<AVLTree<std::string, CountingLess, CountingInstrumentation>>(
+            "AVLTree, less predicate", keys, absent);
+    auto bstLess = countTree<BinarySearchTree<std::string, CountingLess, CountingInstrumentation>>(
+            "BinarySearchTree, less predicate", keys, absent);
+#ifdef DSA_HAS_THREE_WAY_COMPARISON
+    checkThreeWay<AVLTree<std::string, CountingThreeWay, CountingInstrumentation>>(
+            "AVLTree, three-way comparator", keys, absent, avlLess);
+    checkThreeWay<BinarySearchTree<std::string, CountingThreeWay, CountingInstrumentation>>(
+            "BinarySearchTree, three-way comparator", keys, absent, bstLess);
+#else
+    (void) avlLess;
+    (void) bstLess;
+    std::cout << "(built without C++20, the three-way comparator isn't available)\n";
+#endif
+
+    // Heaps
+    std::cout << "BinaryMinHeap\n";
+    BinaryMinHeap<std::string, CountingLess, CountingInstrumentation> binary;
+    count("insert", keysCount, [&] { for (const auto& key : keys) binary.insert(key); });
+    std::uint64_t extract = count("extractMin", keysCount, [&] {
+        std::string previous;
+        while (!binary.isEmpty()) {
+            std::string min = binary.extractMin();
+            check(previous <= min, "BinaryMinHeap: keys extracted out of order");
+            previous = std::move(min);
+        }
+    });
+
+    std::uint64_t former = formerExtractAll(keys);
+    std::cout << "  " << std::left << std::setw(34) << "extractMin, former sift-down" << std::right
+              << std::setw(8) << static_cast<double>(former) / keysCount << " comparisons per operation\n";
+    check(extract <= former, "BinaryMinHeap: extractMin takes more comparisons than the former sift-down");
+
+    std::cout << "BinomialMinHeap\n";
+    BinomialMinHeap<std::string, CountingLess, CountingInstrumentation> binomial;
+    count("insert", keysCount, [&] { for (const auto& key : keys) binomial.insert(key); });
+    count("extractMin", keysCount, [&] { while (!binomial.isEmpty()) binomial.extractMin(); });
+
+    std::cout << "LeftistMinHeap\n";
+    LeftistMinHeap<std::string, CountingLess, CountingInstrumentation> leftist;
+    count("insert", keysCount, [&] { for (const auto& key : keys) leftist.insert(key); });
+    count("extractMin", keysCount, [&] { while (!leftist.isEmpty()) leftist.extractMin(); });
+
+    std::cout << (failed ? "FAILED\n" : "OK\n");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,499 @@
+/**
+ * @file ContainerBenchmark.cpp
+ * @brief Benchmarks every container against its STL counterpart, over key distributions, sizes and
+ * read/write mixes, writing the results as JSON.
+ *
+ * Usage:
+ *   ContainerBenchmark [--sizes <list>] [--operations <count>] [--mixes <list>] [--distributions <list>]
+ *                      [--output <file>]
+ *
+ *   --sizes          Keys in each container, comma separated (1000,10000,100000,1000000 by default).
+ *                    Sizes up to 100000000 work with enough memory and patience.
+ *   --operations     Operations timed per mix (1000000 by default).
+ *   --mixes          Percentages of reads, comma separated (100,90,50 by default).
+ *   --distributions  Among uniform, zipfian, sorted and adversarial (all of them by default).
+ *   --output         File the JSON is written to (standard output by default).
+ *
+ * Containers, grouped with their counterpart:
+ *   set:   AVLTree, BinarySearchTree, std::set, of 64 bit keys
+ *   map:   HashTable, CuckooHashTable, std::unordered_map, of 64 bit keys and values
+ *   heap:  BinaryMinHeap, BinomialMinHeap, LeftistMinHeap, std::priority_queue, of 64 bit keys
+ *   trie:  Trie, std::set<std::string>, of the keys' decimal strings
+ *
+ * Distributions:
+ *   uniform      Random keys, built in random order, operations pick keys uniformly.
+ *   zipfian      Same keys, operations pick them with Zipfian ranks (skew 0.99, see makeZipfianTrace()).
+ *   sorted       Keys 0..n-1 built in increasing order, operations walk them in order.
+ *   adversarial  Keys 0..n-1 built from both ends alternately, a zigzag chain for an unbalanced tree.
+ *                Operations alternate between both ends too. Each hash table gets keys colliding in
+ *                the table it is built in instead (see collidingKeys()): multiples of its bucket count
+ *                for HashTable and std::unordered_map, one chain holding every key, and keys whose
+ *                mixed hashes share their bucket bits for CuckooHashTable, which must grow past them.
+ *
+ * Each container is built once per distribution and size ("build" phase: ns per insert), then every
+ * mix runs on it. A read is contains() (getMin() for the heaps). A write removes the key and inserts it
+ * back (extracts the minimum and inserts the key for the heaps), so the size stays constant; it counts
+ * as one operation. BinarySearchTree is skipped for sorted and adversarial keys above 10000 keys, its
+ * operations being linear there, and so are the hash tables for adversarial keys (the result says so).
+ *
+ * The JSON is an object with the parameters and a "results" array, one result per line in a fixed
+ * order, so the outputs of two releases can be compared with diff:
+ *   {"group": "set", "container": "AVLTree", "distribution": "uniform", "size": 1000,
+ *    "phase": "mix", "readPercent": 90, "operations": 1000000, "nsPerOperation": 41.2}
+ * When the hardware counters open (see PerfCounters.h: Linux, perf_event_paranoid permitting), each
+ * timed result also has "cyclesPerOperation", "instructionsPerOperation", "cacheReferencesPerOperation",
+ * "cacheMissesPerOperation" and "branchMissesPerOperation", counted over the same region.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 Tools/ContainerBenchmark.cpp Tries/Trie.cpp -o ContainerBenchmark
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "../Common/PerfCounters.h"
+#include "../Common/WorkloadReplay.h"
+#include "../Hashing/CuckooHashTable.h"
+#include "../Hashing/HashTable.h"
+#include "../Heaps/BinaryMinHeap.h"
+#include "../Heaps/BinomialMinHeap.h"
+#include "../Heaps/LeftistMinHeap.h"
+#include "../Trees/AVLTree.h"
+#include "../Trees/BinarySearchTree.h"
+#include "../Tries/Trie.h"
+
+using Clock = std::chrono::steady_clock;
+
+static const std::size_t LINEAR_LIMIT = 10000;   // Keys above which linear time operations are skipped
+
+/*region Workloads */
+
+/**
+ * @brief Keys of a container in build order, and the indexes into them the operations use.
+ */
+struct Workload {
+    std::string distribution;
+    std::vector<std::uint64_t> keys;
+    std::vector<std::uint32_t> operations;   // Index in keys of each operation's key
+};
+
+static Workload makeWorkload(const std::string& distribution, std::size_t size, std::size_t operationsCount) {
+    Workload workload{distribution, std::vector<std::uint64_t>(size), std::vector<std::uint32_t>(operationsCount)};
+    std::mt19937_64 random(42);
+
+    if (distribution == "uniform" || distribution == "zipfian") {
+        std::unordered_map<std::uint64_t, bool> seen(size * 2);
+        for (auto& key : workload.keys) {
+            do key = random(); while (!seen.emplace(key, true).second);
+        }
+    } else if (distribution == "sorted") {
+        std::iota(workload.keys.begin(), workload.keys.end(), 0);
+    } else if (distribution == "adversarial") {
+        // Both ends alternately: 0, n-1, 1, n-2...
+        for (std::size_t i = 0; i < size; ++i) workload.keys[i] = i % 2 ? size - 1 - i / 2 : i / 2;
+    } else {
+        throw std::invalid_argument("Unknown distribution " + distribution);
+    }
+
+    if (distribution == "zipfian") {
+        // Rank r is the r-th key in build order, hot keys are spread over the whole key space
+        Trace trace = makeZipfianTrace(operationsCount, size, 0.99, 7);
+        for (std::size_t i = 0; i < operationsCount; ++i)
+            workload.operations[i] = static_cast<std::uint32_t>(std::stoull(trace[i].key.substr(3)));
+    } else {
+        for (std::size_t i = 0; i < operationsCount; ++i)
+            workload.operations[i] = static_cast<std::uint32_t>(distribution == "uniform" ? random() % size : i % size);
+    }
+    return workload;
+}
+
+/**
+ * @brief Inverse of the SplitMix64 finalizer of seededHash(value, 0), the value a mixed hash comes from.
+ */
+static std::uint64_t unmix(std::uint64_t hash) {
+    auto inverse = [](std::uint64_t odd) {
+        std::uint64_t result = odd;   // Newton's iteration, each step doubles the correct low bits
+        for (int i = 0; i < 5; ++i) result *= 2 - odd * result;
+        return result;
+    };
+    hash ^= hash >> 31 ^ hash >> 62;
+    hash *= inverse(0x94D049BB133111EBull);
+    hash ^= hash >> 27 ^ hash >> 54;
+    hash *= inverse(0xBF58476D1CE4E5B9ull);
+    hash ^= hash >> 30 ^ hash >> 60;
+    return hash - 0x9E3779B97F4A7C15ull;
+}
+
+/**
+ * @brief The adversarial keys of a hash table: keys of the same ranks colliding in the table they're built in.
+ *
+ * The chained tables index their buckets with std::hash (the identity) modulo the bucket count, which
+ * only depends on the number of keys inserted, so multiples of the final count all share bucket 0.
+ * CuckooHashTable mixes std::hash with seededHash() and masks the low bits: inverting the mix gives keys
+ * whose hashes have zero low bits, so they all have bucket 0 for their first bucket and at most 255
+ * second buckets, and the table grows until these bits of the larger mask tell them apart.
+ */
+static Workload collidingKeys(const std::string& container, const Workload& workload) {
+    std::size_t size = workload.keys.size();
+    if (workload.distribution != "adversarial" || size > LINEAR_LIMIT) return workload;   // measure() skips them
+
+    std::uint64_t bucketsCount;
+    if (container == "HashTable") {
+        HashTable<std::uint64_t, std::uint64_t> table;
+        for (std::uint64_t key = 0; key < size; ++key) table.insert(key, key);
+        bucketsCount = static_cast<std::uint64_t>(table.bucketsCount());
+    } else if (container == "std::unordered_map") {
+        std::unordered_map<std::uint64_t, std::uint64_t> table;
+        for (std::uint64_t key = 0; key < size; ++key) table.emplace(key, key);
+        bucketsCount = table.bucket_count();
+    } else {
+        CuckooHashTable<std::uint64_t, std::uint64_t> table;
+        for (std::uint64_t key = 0; key < size; ++key) table.insert(key, key);
+        bucketsCount = static_cast<std::uint64_t>(table.capacity()) / 4;   // 4 slots per bucket
+    }
+
+    Workload colliding = workload;
+    for (auto& key : colliding.keys) {
+        if (container == "CuckooHashTable") {
+            // Distinct hashes, as the multiplier is odd, with bucket bits all zero and spread tags
+            key = unmix(key * 0x9E3779B97F4A7C15ull * bucketsCount);
+        } else {
+            key *= bucketsCount;
+        }
+    }
+    return colliding;
+}
+
+/**
+ * @brief Whether each operation is a read, the same reads for every container of a mix.
+ */
+static std::vector<bool> makeReads(std::size_t operationsCount, int readPercent) {
+    std::mt19937_64 random(static_cast<std::uint64_t>(readPercent));
+    std::vector<bool> reads(operationsCount);
+    for (std::size_t i = 0; i < operationsCount; ++i) reads[i] = static_cast<int>(random() % 100) < readPercent;
+    return reads;
+}
+
+/*endregion*/
+
+/*region Adapters */
+
+template<typename Tree>
+struct SetAdapter {
+    Tree tree;
+    void insert(std::uint64_t key) { tree.insert(key); }
+    bool read(std::uint64_t key) { return tree.contains(key); }
+    void write(std::uint64_t key) { tree.remove(key); tree.insert(key); }
+};
+
+template<>
+struct SetAdapter<std::set<std::uint64_t>> {
+    std::set<std::uint64_t> tree;
+    void insert(std::uint64_t key) { tree.insert(key); }
+    bool read(std::uint64_t key) { return tree.count(key) != 0; }
+    void write(std::uint64_t key) { tree.erase(key); tree.insert(key); }
+};
+
+template<typename Table>
+struct MapAdapter {
+    Table table;
+    void insert(std::uint64_t key) { table.insert(key, key); }
+    bool read(std::uint64_t key) { return table.contains(key); }
+    void write(std::uint64_t key) { table.remove(key); table.insert(key, key); }
+};
+
+template<>
+struct MapAdapter<std::unordered_map<std::uint64_t, std::uint64_t>> {
+    std::unordered_map<std::uint64_t, std::uint64_t> table;
+    void insert(std::uint64_t key) { table.insert_or_assign(key, key); }
+    bool read(std::uint64_t key) { return table.count(key) != 0; }
+    void write(std::uint64_t key) { table.erase(key); table.insert_or_assign(key, key); }
+};
+
+template<typename Heap>
+struct HeapAdapter {
+    Heap heap;
+    void insert(std::uint64_t key) { heap.insert(key); }
+    bool read(std::uint64_t) { return heap.getMin() != 0; }
+    void write(std::uint64_t key) { heap.extractMin(); heap.insert(key); }
+};
+
+template<>
+struct HeapAdapter<std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<>>> {
+    std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<>> heap;
+    void insert(std::uint64_t key) { heap.push(key); }
+    bool read(std::uint64_t) { return heap.top() != 0; }
+    void write(std::uint64_t key) { heap.pop(); heap.push(key); }
+};
+
+/**
+ * @brief Trie and std::set<std::string> take the keys' decimal strings, converted before timing.
+ */
+template<typename Strings>
+struct TrieAdapter {
+    Strings strings;
+    const std::vector<std::string>* names = nullptr;
+    std::unordered_map<std::uint64_t, std::uint32_t>* nameOf = nullptr;
+
+    const std::string& name(std::uint64_t key) const { return (*names)[nameOf->at(key)]; }
+    void insert(std::uint64_t key) { strings.insert(name(key)); }
+    bool read(std::uint64_t key) { return contains(name(key)); }
+    void write(std::uint64_t key) { erase(name(key)); strings.insert(name(key)); }
+
+    bool contains(const std::string& word) const {
+        if constexpr (std::is_same_v<Strings, Trie>) return strings.contains(word);
+        else return strings.count(word) != 0;
+    }
+    void erase(const std::string& word) {
+        if constexpr (std::is_same_v<Strings, Trie>) strings.remove(word);
+        else strings.erase(word);
+    }
+};
+
+/*endregion*/
+
+/*region Measurement */
+
+struct Result {
+    std::string group;
+    std::string container;
+    std::string distribution;
+    std::size_t size;
+    std::string phase;
+    int readPercent;
+    std::size_t operations;
+    double nsPerOperation;
+    std::string skipped;
+    bool counted = false;             // Whether counters holds the hardware counts of the phase
+    PerfCounters::Values counters;
+};
+
+struct Options {
+    std::vector<std::size_t> sizes{1000, 10000, 100000, 1000000};
+    std::size_t operations = 1000000;
+    std::vector<int> mixes{100, 90, 50};
+    std::vector<std::string> distributions{"uniform", "zipfian", "sorted", "adversarial"};
+    std::string output;
+};
+
+static std::uint64_t sink = 0;   // Keeps the reads from being optimized away
+
+/**
+ * @brief Times body, counting its cycles, instructions, cache and branch misses when the counters open.
+ */
+template<typename Body>
+static void timePhase(Result& result, PerfCounters& perf, Body body) {
+    perf.reset();
+    auto start = Clock::now();
+    perf.start();
+    body();
+    perf.stop();
+    double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    result.nsPerOperation = elapsed / static_cast<double>(result.operations);
+    result.counted = perf.isAvailable();
+    result.counters = perf.read();
+}
+
+template<typename Adapter>
+static void measure(const std::string& group, const std::string& container, const Workload& workload,
+                    const Options& options, std::vector<Result>& results, const std::function<void(Adapter&)>& setup = {}) {
+    std::size_t size = workload.keys.size();
+    Result base{group, container, workload.distribution, size, "build", 0, size, 0, "", false, {}};
+
+    bool degenerate = workload.distribution == "sorted" || workload.distribution == "adversarial";
+    if (container == "BinarySearchTree" && degenerate && size > LINEAR_LIMIT) base.skipped = "linear depth";
+    if (group == "map" && workload.distribution == "adversarial" && size > LINEAR_LIMIT)
+        base.skipped = container == "CuckooHashTable" ? "grows past the colliding keys" : "single chain";
+    if (!base.skipped.empty()) {
+        results.push_back(base);
+        for (int mix : options.mixes) {
+            Result skipped = base;
+            skipped.phase = "mix";
+            skipped.readPercent = mix;
+            skipped.operations = workload.operations.size();
+            results.push_back(skipped);
+        }
+        return;
+    }
+
+    Adapter adapter;
+    if (setup) setup(adapter);
+    PerfCounters perf;
+
+    timePhase(base, perf, [&] {
+        for (auto key : workload.keys) adapter.insert(key);
+    });
+    results.push_back(base);
+
+    for (int mix : options.mixes) {
+        std::vector<bool> reads = makeReads(workload.operations.size(), mix);
+        Result result = base;
+        result.phase = "mix";
+        result.readPercent = mix;
+        result.operations = workload.operations.size();
+        timePhase(result, perf, [&] {
+            for (std::size_t i = 0; i < workload.operations.size(); ++i) {
+                std::uint64_t key = workload.keys[workload.operations[i]];
+                if (reads[i]) sink += adapter.read(key);
+                else adapter.write(key);
+            }
+        });
+        results.push_back(result);
+    }
+    std::cerr << group << " " << container << " " << workload.distribution << " " << size << " done\n";
+}
+
+static void runAll(const Options& options, std::vector<Result>& results) {
+    for (const auto& distribution : options.distributions) {
+        for (std::size_t size : options.sizes) {
+            Workload workload = makeWorkload(distribution, size, options.operations);
+
+            measure<SetAdapter<AVLTree<std::uint64_t>>>("set", "AVLTree", workload, options, results);
+            measure<SetAdapter<BinarySearchTree<std::uint64_t>>>("set", "BinarySearchTree", workload, options, results);
+            measure<SetAdapter<std::set<std::uint64_t>>>("set", "std::set", workload, options, results);
+
+            measure<MapAdapter<HashTable<std::uint64_t, std::uint64_t>>>(
+                    "map", "HashTable", collidingKeys("HashTable", workload), options, results);
+            measure<MapAdapter<CuckooHashTable<std::uint64_t, std::uint64_t>>>(
+                    "map", "CuckooHashTable", collidingKeys("CuckooHashTable", workload), options, results);
+            measure<MapAdapter<std::unordered_map<std::uint64_t, std::uint64_t>>>(
+                    "map", "std::unordered_map", collidingKeys("std::unordered_map", workload), options, results);
+
+            measure<HeapAdapter<BinaryMinHeap<std::uint64_t>>>("heap", "BinaryMinHeap", workload, options, results);
+            measure<HeapAdapter<BinomialMinHeap<std::uint64_t>>>("heap", "BinomialMinHeap", workload, options, results);
+            measure<HeapAdapter<LeftistMinHeap<std::uint64_t>>>("heap", "LeftistMinHeap", workload, options, results);
+            measure<HeapAdapter<std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<>>>>(
+                    "heap", "std::priority_queue", workload, options, results);
+
+            std::vector<std::string> names(size);
+            std::unordered_map<std::uint64_t, std::uint32_t> nameOf(size * 2);
+            for (std::size_t i = 0; i < size; ++i) {
+                names[i] = std::to_string(workload.keys[i]);
+                nameOf[workload.keys[i]] = static_cast<std::uint32_t>(i);
+            }
+            auto strings = [&](auto& adapter) {
+                adapter.names = &names;
+                adapter.nameOf = &nameOf;
+            };
+            measure<TrieAdapter<Trie>>("trie", "Trie", workload, options, results, strings);
+            measure<TrieAdapter<std::set<std::string>>>("trie", "std::set<std::string>", workload, options, results,
+                                                        strings);
+        }
+    }
+}
+
+/*endregion*/
+
+/*region Output */
+
+static void writeJson(std::ostream& out, const Options& options, const std::vector<Result>& results) {
+    auto list = [](const auto& values, bool quoted) {
+        std::ostringstream text;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (i) text << ", ";
+            if (quoted) text << '"' << values[i] << '"';
+            else text << values[i];
+        }
+        return text.str();
+    };
+
+    out << "{\n  \"benchmark\": \"ContainerBenchmark\",\n"
+        << "  \"sizes\": [" << list(options.sizes, false) << "],\n"
+        << "  \"operations\": " << options.operations << ",\n"
+        << "  \"mixes\": [" << list(options.mixes, false) << "],\n"
+        << "  \"distributions\": [" << list(options.distributions, true) << "],\n"
+        << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        out << "    {\"group\": \"" << result.group << "\", \"container\": \"" << result.container
+            << "\", \"distribution\": \"" << result.distribution << "\", \"size\": " << result.size
+            << ", \"phase\": \"" << result.phase << "\", \"readPercent\": " << result.readPercent
+            << ", \"operations\": " << result.operations << ", ";
+        if (!result.skipped.empty()) {
+            out << "\"skipped\": \"" << result.skipped << "\"}";
+        } else {
+            out << "\"nsPerOperation\": " << result.nsPerOperation;
+            if (result.counted) {
+                auto perOperation = [&](std::uint64_t count) {
+                    return static_cast<double>(count) / static_cast<double>(result.operations);
+                };
+                const PerfCounters::Values& counters = result.counters;
+                out << ", \"cyclesPerOperation\": " << perOperation(counters.cycles)
+                    << ", \"instructionsPerOperation\": " << perOperation(counters.instructions)
+                    << ", \"cacheReferencesPerOperation\": " << perOperation(counters.cacheReferences)
+                    << ", \"cacheMissesPerOperation\": " << perOperation(counters.cacheMisses)
+                    << ", \"branchMissesPerOperation\": " << perOperation(counters.branchMisses);
+            }
+            out << "}";
+        }
+        out << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+template<typename T>
+static std::vector<T> parseList(const std::string& text, const std::function<T(const std::string&)>& parse) {
+    std::vector<T> values;
+    std::istringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) values.push_back(parse(item));
+    return values;
+}
+
+/*endregion*/
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << argument << "\n";
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (argument == "--sizes")
+            options.sizes = parseList<std::size_t>(value, [](const std::string& s) { return std::stoull(s); });
+        else if (argument == "--operations") options.operations = std::stoull(value);
+        else if (argument == "--mixes")
+            options.mixes = parseList<int>(value, [](const std::string& s) { return std::stoi(s); });
+        else if (argument == "--distributions")
+            options.distributions = parseList<std::string>(value, [](const std::string& s) { return s; });
+        else if (argument == "--output") options.output = value;
+        else {
+            std::cerr << "Unknown option " << argument << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    runAll(options, results);
+
+    if (options.output.empty()) {
+        writeJson(std::cout, options, results);
+    } else {
+        std::ofstream file(options.output);
+        writeJson(file, options, results);
+        if (!file) {
+            std::cerr << "Couldn't write " << options.output << "\n";
+            return 1;
+        }
+    }
+    std::cerr << "checksum " << sink << "\n";
+    return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file CuckooBenchmark.cpp
+ * @brief Measures the inserts and lookups of CuckooHashTable against the chained HashTable, at several loads.
+ *
+ * Usage:
+ *   CuckooBenchmark [<slots> [<lookups>]]
+ *
+ *   <slots>    Slots of the cuckoo table, a power of two (4194304 by default).
+ *   <lookups>  Lookups of each measure (10000000 by default).
+ *
+ * For each load (50%, 75%, 90% and 95% of the slots), as many random 64 bit keys are inserted in:
+ *  - CuckooHashTable, sized up front so it doesn't grow,
+ *  - CuckooHashTable with OptimisticReads, whose readers check the bucket versions,
+ *  - HashTable, constructed with as many buckets as keys.
+ * Then the same random keys are looked up in each table:
+ *  - hits, independent: the next key doesn't depend on the result, so the CPU overlaps the cache
+ *    misses of several lookups,
+ *  - hits, dependent: the value found picks the next key, one lookup's misses at a time, the latency,
+ *  - misses: every key is absent.
+ * The tool fails (exit code 1) if a cuckoo table grew, so its load wasn't the one measured.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 Tools/CuckooBenchmark.cpp -o CuckooBenchmark
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../Hashing/CuckooHashTable.h"
+#include "../Hashing/HashTable.h"
+
+using Clock = std::chrono::steady_clock;
+
+static bool failed = false;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void report(const std::string& name, double seconds, std::size_t operations) {
+    std::cout << "    " << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(8) << seconds / operations * 1e9 << " ns\n";
+}
+
+/**
+ * @brief Inserts the keys in an empty table, then looks them up, `table.get(key)` returning the key's index.
+ */
+template<typename Table>
+static void measure(const std::string& name, Table& table, const std::vector<std::uint64_t>& keys,
+                    const std::vector<std::uint64_t>& absent, std::size_t lookups) {
+    std::cout << "  " << name << "\n";
+
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < keys.size(); ++i) table.insert(keys[i], i);
+    report("insert", secondsSince(start), keys.size());
+
+    std::mt19937_64 random(7);
+    std::vector<std::size_t> picks(lookups);
+    for (auto& pick : picks) pick = random() % keys.size();
+
+    std::uint64_t checksum = 0;
+    start = Clock::now();
+    for (std::size_t pick : picks) checksum += table.get(keys[pick]);
+    report("hits, independent", secondsSince(start), lookups);
+
+    // Values are indices of keys, so each lookup waits for the previous one
+    std::size_t next = 0;
+    start = Clock::now();
+    for (std::size_t i = 0; i < lookups; ++i) next = (table.get(keys[next]) + i) % keys.size();
+    report("hits, dependent", secondsSince(start), lookups);
+    checksum += next;
+
+    std::size_t found = 0;
+    start = Clock::now();
+    for (std::size_t pick : picks) found += table.contains(absent[pick]);
+    report("misses", secondsSince(start), lookups);
+
+    if (found != 0 || table.size() != static_cast<int>(keys.size())) {
+        std::cout << "FAILED: " << name << " lost or invented keys\n";
+        failed = true;
+    }
+    std::cout << "    (checksum " << checksum << ")\n";
+}
+
+template<bool OptimisticReads>
+static void measureCuckoo(const std::string& name, std::size_t slots, const std::vector<std::uint64_t>& keys,
+                          const std::vector<std::uint64_t>& absent, std::size_t lookups) {
+    using Table = CuckooHashTable<std::uint64_t, std::uint64_t, NoInstrumentation, OptimisticReads>;
+    Table table(static_cast<int>(slots / 2));
+    if (table.capacity() != static_cast<int>(slots)) {
+        std::cout << "FAILED: " << name << " has " << table.capacity() << " slots, not " << slots << "\n";
+        failed = true;
+    }
+
+    measure(name, table, keys, absent, lookups);
+    if (table.capacity() != static_cast<int>(slots)) {
+        std::cout << "FAILED: " << name << " grew to " << table.capacity() << " slots\n";
+        failed = true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t slots = argc > 1 ? std::stoull(argv[1]) : 4194304;
+    std::size_t lookups = argc > 2 ? std::stoull(argv[2]) : 10000000;
+
+    // Present keys are even, absent ones odd
+    std::mt19937_64 random(42);
+    for (int load : {50, 75, 90, 95}) {
+        std::size_t keysCount = slots * load / 100;
+        std::vector<std::uint64_t> keys(keysCount), absent(keysCount);
+        for (auto& key : keys) key = random() & ~std::uint64_t(1);
+        for (auto& key : absent) key = random() | 1;
+
+        std::cout << load << "% load, " << keysCount << " keys\n";
+        measureCuckoo<false>("CuckooHashTable", slots, keys, absent, lookups);
+        measureCuckoo<true>("CuckooHashTable, optimistic reads", slots, keys, absent, lookups);
+        HashTable<std::uint64_t, std::uint64_t> chained(static_cast<int>(keysCount));
+        measure("HashTable", chained, keys, absent, lookups);
+    }
+
+    std::cout << (failed ? "FAILED\n" : "OK\n");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file DiskHashBenchmark.cpp
+ * @brief Measures the page I/Os per insert and per lookup of DiskHashTable, for several buffer pool sizes.
+ *
+ * Usage:
+ *   DiskHashBenchmark [<entries> [<file>]]
+ *
+ *   <entries>  Entries inserted (1000000 by default).
+ *   <file>     Index file, overwritten (disk_hash_benchmark.index by default).
+ *
+ * Keys and values are 64 bit integers, pages are 4 KB. For each pool size, the index is built by
+ * inserting random keys, flushed, then queried with the same number of random lookups, half of
+ * them for absent keys. The page reads and writes reported by stats() are divided by the operations
+ * count; the inserts count the writes of the flush too, since they are deferred until then.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 Tools/DiskHashBenchmark.cpp -o DiskHashBenchmark
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../Hashing/DiskHashTable.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t entriesCount = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    std::string path = argc > 2 ? argv[2] : "disk_hash_benchmark.index";
+
+    std::mt19937_64 random(42);
+    std::vector<std::uint64_t> keys(entriesCount);
+    for (auto& key : keys) key = random();
+
+    for (std::size_t poolPages : {16, 256, 4096}) {
+        std::remove(path.c_str());
+        DiskHashTable<std::uint64_t, std::uint64_t> index(path, poolPages);
+
+        auto start = Clock::now();
+        for (auto key : keys) index.insert(key, key);
+        index.flush();
+        double elapsed = secondsSince(start);
+        DiskHashStats built = index.stats();
+
+        std::uint64_t found = 0;
+        start = Clock::now();
+        for (std::size_t i = 0; i < entriesCount; ++i)
+            found += index.contains(i % 2 ? keys[random() % entriesCount] : random());
+        double lookupsElapsed = secondsSince(start);
+        DiskHashStats queried = index.stats();
+
+        auto perInsert = [&](std::uint64_t value) { return static_cast<double>(value) / entriesCount; };
+        std::cout << "Pool of " << poolPages << " pages (" << index.pagesCount() << " pages in the file, depth "
+                  << index.globalDepth() << ", " << built.splits << " splits)\n"
+                  << "  inserts: " << perInsert(built.pageReads) << " reads + " << perInsert(built.pageWrites)
+                  << " writes per insert, " << elapsed / entriesCount * 1e6 << " us\n"
+                  << "  lookups: " << perInsert(queried.pageReads - built.pageReads) << " reads per lookup, "
+                  << lookupsElapsed / entriesCount * 1e6 << " us (" << found << " found)\n";
+    }
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file HashArrayMappedTrieCheck.cpp
+ * @brief Differential check of HashArrayMappedTrie against std::map, over versions, transients and collisions.
+ *
+ * Usage:
+ *   HashArrayMappedTrieCheck [<operations> [<seed>]]
+ *
+ *   <operations>  Random operations of each check (100000 by default).
+ *   <seed>        Seed of the operations (42 by default).
+ *
+ * Random inserts, removes and lookups run on a map and on a std::map, every lookup and size() being
+ * compared. Now and then the current version is kept along with a copy of its std::map, and a transient
+ * batch applies random updates before persistent() ends it. At the end every kept version is compared
+ * with its std::map, through lookups and forEach(), which must visit each entry once: updating the later
+ * versions must not have changed them.
+ * The check runs twice: with 64 bit keys, then with keys whose std::hash only has 64 values, so most keys
+ * share their full hash with others and go to collision nodes. The tool fails (exit code 1) at the first
+ * difference.
+ *
+ * Build (from the repository root), with AddressSanitizer and UndefinedBehaviorSanitizer:
+ *   g++ -std=c++17 -O1 -g -fsanitize=address,undefined Tools/HashArrayMappedTrieCheck.cpp -o HashArrayMappedTrieCheck
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Tries/HashArrayMappedTrie.h"
+
+/**
+ * @brief Key whose hash only takes 64 values, forcing collision nodes.
+ */
+struct CollidingKey {
+    std::uint64_t value;
+
+    bool operator==(const CollidingKey& other) const { return value == other.value; }
+
+    bool operator<(const CollidingKey& other) const { return value < other.value; }
+};
+
+namespace std {
+    template<>
+    struct hash<CollidingKey> {
+        std::size_t operator()(const CollidingKey& key) const { return key.value % 64; }
+    };
+}
+
+static void check(bool condition, const std::string& message) {
+    if (condition) return;
+    std::cout << "FAILED: " << message << "\n";
+    std::exit(1);
+}
+
+template<typename Key>
+static void checkVersion(const HashArrayMappedTrie<Key, std::uint64_t>& map, const std::map<Key, std::uint64_t>& model,
+                         const std::string& name) {
+    check(map.size() == model.size(), name + ": size " + std::to_string(map.size()) + " instead of " +
+                                      std::to_string(model.size()));
+    for (const auto& [key, value] : model) {
+        const std::uint64_t* found = map.find(key);
+        check(found && *found == value && map.get(key) == value, name + ": key lost or wrong");
+    }
+
+    std::map<Key, std::uint64_t> visited;
+    map.forEach([&](const Key& key, const std::uint64_t& value) {
+        check(visited.emplace(key, value).second, name + ": forEach() visited a key twice");
+    });
+    check(visited == model, name + ": forEach() visited other entries");
+}
+
+template<typename Key>
+static void checkMap(const std::string& name, std::size_t operations, std::uint64_t seed,
+                     const std::function<Key(std::uint64_t)>& makeKey) {
+    std::mt19937_64 random(seed);
+    std::uint64_t keys = operations / 4 + 1;
+    HashArrayMappedTrie<Key, std::uint64_t> map;
+    std::map<Key, std::uint64_t> model;
+    std::vector<std::pair<HashArrayMappedTrie<Key, std::uint64_t>, std::map<Key, std::uint64_t>>> versions;
+
+    for (std::size_t i = 0; i < operations; ++i) {
+        Key key = makeKey(random() % keys);
+        switch (random() % 200) {
+            case 0:
+                versions.emplace_back(map, model);
+                break;
+            case 1: {  // A batch of updates, modifying its own nodes in place
+                auto batch = map.transient();
+                for (std::size_t update = random() % 1000; update > 0; --update) {
+                    Key batchKey = makeKey(random() % keys);
+                    if (random() % 3) {
+                        batch.insert(batchKey, i);
+                        model[batchKey] = i;
+                    } else {
+                        batch.remove(batchKey);
+                        model.erase(batchKey);
+                    }
+                }
+                check(batch.size() == model.size(), name + ": transient size() disagrees");
+                map = batch.persistent();
+                break;
+            }
+            default:
+                switch (random() % 4) {
+                    case 0:
+                    case 1:
+                        map = map.insert(key, i);
+                        model[key] = i;
+                        break;
+                    case 2:
+                        map = map.remove(key);
+                        model.erase(key);
+                        break;
+                    default: {
+                        auto expected = model.find(key);
+                        const std::uint64_t* found = map.find(key);
+                        check(expected == model.end() ? found == nullptr : found && *found == expected->second,
+                              name + ": find() disagrees");
+                    }
+                }
+                check(map.size() == model.size(), name + ": size() disagrees");
+        }
+    }
+
+    checkVersion(map, model, name);
+    for (const auto& [version, versionModel] : versions) checkVersion(version, versionModel, name + ", kept version");
+    std::cout << "  " << map.size() << " entries, " << versions.size() << " kept versions\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t operations = argc > 1 ? std::stoull(argv[1]) : 100000;
+    std::uint64_t seed = argc > 2 ? std::stoull(argv[2]) : 42;
+
+    std::cout << "64 bit keys\n";
+    checkMap<std::uint64_t>("64 bit keys", operations, seed, [](std::uint64_t value) {
+        return value * 0x9E3779B97F4A7C15ull;
+    });
+    std::cout << "colliding keys\n";
+    checkMap<CollidingKey>("colliding keys", operations, seed, [](std::uint64_t value) {
+        return CollidingKey{value};
+    });
+    std::cout << "OK\n";
+    return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file HashJoinBenchmark.cpp
+ * @brief Measures the throughput of RadixHashJoin against a join through a single HashTable.
+ *
+ * Usage:
+ *   HashJoinBenchmark [<build rows> [<probe rows> [<match ratio>]]] [--threads <count>]
+ *
+ *   <build rows>   Rows of the build side, with unique keys (10000000 by default).
+ *   <probe rows>   Rows of the probe side (100000000 by default).
+ *   <match ratio>  Share of the probe rows having a match (1 by default).
+ *   --threads      Workers of the scheduler running the parallel join (the hardware threads by default).
+ *
+ * Rows are 16 bytes, a 64 bit key and a 64 bit payload, in random order. Each join sums the payloads
+ * of the matching pairs, and the reported throughput counts the rows of both sides.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -pthread Tools/HashJoinBenchmark.cpp -o HashJoinBenchmark
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Hashing/RadixHashJoin.h"
+
+struct Row {
+    std::uint64_t key;
+    std::uint64_t payload;
+};
+
+template<typename Join>
+static void measure(const std::string& name, std::size_t rowsCount, Join join) {
+    auto start = std::chrono::steady_clock::now();
+    auto [matches, sum] = join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << name << ": " << elapsed.count() << " s, "
+              << rowsCount / elapsed.count() / 1e6 << " M rows/s, "
+              << matches << " matches (payload sum " << sum << ")\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t buildCount = 10000000, probeCount = 100000000;
+    double matchRatio = 1;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--threads" && i + 1 < argc) threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        else positional.push_back(argument);
+    }
+    if (positional.size() > 0) buildCount = std::stoull(positional[0]);
+    if (positional.size() > 1) probeCount = std::stoull(positional[1]);
+    if (positional.size() > 2) matchRatio = std::stod(positional[2]);
+
+    // Build keys are a shuffled permutation, probe keys fall in the build range with the match ratio
+    std::mt19937_64 random(42);
+    std::vector<Row> build(buildCount);
+    for (std::size_t i = 0; i < buildCount; ++i) build[i] = {i, i};
+    std::shuffle(build.begin(), build.end(), random);
+
+    std::vector<Row> probe(probeCount);
+    auto range = static_cast<std::uint64_t>(buildCount / std::max(matchRatio, 1e-9));
+    for (std::size_t i = 0; i < probeCount; ++i) probe[i] = {random() % std::max<std::uint64_t>(range, 1), i};
+
+    std::size_t rowsCount = buildCount + probeCount;
+    auto keyOf = [](const Row& row) { return row.key; };
+
+    measure("HashTable", rowsCount, [&] {
+        HashTable<std::uint64_t, std::uint64_t> table(static_cast<int>(buildCount + 1) | 1);
+        for (const Row& row : build) table.insert(row.key, row.payload);
+
+        std::uint64_t matches = 0, sum = 0;
+        for (const Row& row : probe) {
+            if (const std::uint64_t* payload = table.find(row.key)) {
+                matches++;
+                sum += *payload + row.payload;
+            }
+        }
+        return std::pair(matches, sum);
+    });
+
+    auto radixJoin = [&](TaskScheduler* scheduler) {
+        std::atomic<std::uint64_t> matches{0}, sum{0};
+        RadixHashJoin(scheduler).join(build, probe, keyOf, keyOf, [&](const Row& buildRow, const Row& probeRow) {
+            matches.fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(buildRow.payload + probeRow.payload, std::memory_order_relaxed);
+        });
+        return std::pair(matches.load(), sum.load());
+    };
+
+    std::cout << RadixHashJoin().partitionsCount(buildCount) << " partitions\n";
+    measure("RadixHashJoin", rowsCount, [&] { return radixJoin(nullptr); });
+
+    TaskScheduler scheduler(threads);
+    measure("RadixHashJoin, " + std::to_string(threads) + " threads", rowsCount, [&] { return radixJoin(&scheduler); });
+    return 0;
+}
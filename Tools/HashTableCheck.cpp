@@ -0,0 +1,400 @@
+/**
+ * @file HashTableCheck.cpp
+ * @brief Differential check of HashTable against std::map: filter, copy-on-write, node handles and expiry.
+ *
+ * Usage:
+ *   HashTableCheck [<operations> [<seed>]]
+ *
+ *   <operations>  Random operations of each check (50000 by default).
+ *   <seed>        Seed of the operations (42 by default).
+ *
+ * Each check runs random operations on one or more tables and on a std::map per table, comparing every
+ * lookup with the map, and comparing the whole tables (size, then every key of the map) now and then
+ * and at the end. Keys are drawn from a range about a quarter of the operations wide, so inserts update
+ * existing keys, and removes and lookups hit as often as they miss.
+ *  - filter: with enableFilter(), the filter being dropped and enabled again now and then.
+ *  - copy-on-write: copies (O(1)) and assignments of a copy-on-write table are kept as snapshots, and
+ *    written too; every snapshot must still match the map it was copied with. CountingInstrumentation
+ *    must see no node allocated by a copy nor by operator[] and remove() of missing keys, and a write
+ *    through operator[] must duplicate the nodes of one page, not the table.
+ *  - node handles: entries move between two tables with extract() and insert(NodeHandle&&), and
+ *    merge() moves whole tables, with and without copy-on-write snapshots of the source. Without
+ *    snapshots, CountingInstrumentation must see no node allocated nor freed by these moves.
+ *  - expiry: an Expiring table gets permanent entries, entries already expired (a time to live of 0)
+ *    and entries living an hour, then entries living 200 ms, which must all be gone 300 ms later.
+ *  - threads: a copy-on-write copy is read by another thread while the original is written.
+ * The tool fails (exit code 1) at the first difference.
+ *
+ * Build (from the repository root), with AddressSanitizer and UndefinedBehaviorSanitizer:
+ *   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -pthread Tools/HashTableCheck.cpp -o HashTableCheck
+ * or with ThreadSanitizer, for the threads check:
+ *   g++ -std=c++17 -O1 -g -fsanitize=thread -pthread Tools/HashTableCheck.cpp -o HashTableCheck
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../Common/Instrumentation.h"
+#include "../Hashing/HashTable.h"
+
+using Model = std::map<std::uint64_t, std::string>;
+
+static void check(bool condition, const std::string& message) {
+    if (condition) return;
+    std::cout << "FAILED: " << message << "\n";
+    std::exit(1);
+}
+
+static std::string valueOf(std::uint64_t key, std::uint64_t version) {
+    return "value-" + std::to_string(key) + "-" + std::to_string(version);
+}
+
+/**
+ * @brief Checks a lookup of the key against the map, through find(), contains() and get().
+ */
+template<typename Table>
+static void checkKey(const Table& table, const Model& model, std::uint64_t key, const std::string& name) {
+    auto expected = model.find(key);
+    const std::string* found = table.find(key);
+    if (expected == model.end()) {
+        check(found == nullptr && !table.contains(key), name + ": absent key " + std::to_string(key) + " found");
+        return;
+    }
+    check(found != nullptr && *found == expected->second, name + ": key " + std::to_string(key) + " lost or wrong");
+    check(table.contains(key) && table.get(key) == expected->second, name + ": contains() or get() disagree");
+}
+
+/**
+ * @brief Checks the whole table against the map: with equal sizes, finding every key of the map is enough.
+ */
+template<typename Table>
+static void checkTable(const Table& table, const Model& model, const std::string& name) {
+    check(table.size() == static_cast<int>(model.size()), name + ": size " + std::to_string(table.size()) +
+                                                          " instead of " + std::to_string(model.size()));
+    for (const auto& [key, value] : model) checkKey(table, model, key, name);
+}
+
+/**
+ * @brief Applies a random insert, remove or lookup to a table and its map.
+ */
+template<typename Table>
+static void randomOperation(Table& table, Model& model, std::mt19937_64& random, std::uint64_t keys,
+                            std::uint64_t version, const std::string& name) {
+    std::uint64_t key = random() % keys;
+    switch (random() % 4) {
+        case 0:
+        case 1:
+            table.insert(key, valueOf(key, version));
+            model[key] = valueOf(key, version);
+            break;
+        case 2:
+            table.remove(key);
+            model.erase(key);
+            break;
+        default:
+            checkKey(table, model, key, name);
+    }
+}
+
+static void checkFilter(std::size_t operations, std::uint64_t seed) {
+    std::mt19937_64 random(seed);
+    std::uint64_t keys = operations / 4 + 1;
+    HashTable<std::uint64_t, std::string> table;
+    Model model;
+    table.enableFilter();
+
+    for (std::size_t i = 0; i < operations; ++i) {
+        randomOperation(table, model, random, keys, i, "filter");
+        if (i % 10007 == 0) {
+            table.disableFilter();
+            checkTable(table, model, "filter (disabled)");
+            table.enableFilter(static_cast<int>(random() % 16) + 1);
+        }
+    }
+    checkTable(table, model, "filter");
+}
+
+static void checkCopyOnWrite(std::size_t operations, std::uint64_t seed) {
+    std::mt19937_64 random(seed);
+    std::uint64_t keys = operations / 4 + 1;
+    HashTable<std::uint64_t, std::string> table;
+    Model model;
+    table.setCopyOnWrite(true);
+
+    std::vector<std::pair<HashTable<std::uint64_t, std::string>, Model>> snapshots;
+    for (std::size_t i = 0; i < operations; ++i) {
+        switch (random() % 100) {
+            case 0:  // Copy, kept while the table changes
+                if (snapshots.size() < 16) snapshots.emplace_back(table, model);
+                break;
+            case 1:  // Assignment of the table to a snapshot
+                if (!snapshots.empty()) {
+                    auto& snapshot = snapshots[random() % snapshots.size()];
+                    snapshot.first = table;
+                    snapshot.second = model;
+                }
+                break;
+            case 2:  // Assignment of a snapshot to the table
+                if (!snapshots.empty()) {
+                    const auto& snapshot = snapshots[random() % snapshots.size()];
+                    table = snapshot.first;
+                    model = snapshot.second;
+                }
+                break;
+            case 3:  // Write to a snapshot, sharing pages with the table
+            case 4:
+                if (!snapshots.empty()) {
+                    auto& snapshot = snapshots[random() % snapshots.size()];
+                    randomOperation(snapshot.first, snapshot.second, random, keys, i, "copy-on-write snapshot");
+                }
+                break;
+            case 5:  // Drop a snapshot, releasing its pages
+                if (!snapshots.empty()) snapshots.erase(snapshots.begin() + random() % snapshots.size());
+                break;
+            default:
+                randomOperation(table, model, random, keys, i, "copy-on-write");
+        }
+    }
+
+    checkTable(table, model, "copy-on-write");
+    for (const auto& [snapshot, snapshotModel] : snapshots) checkTable(snapshot, snapshotModel, "copy-on-write snapshot");
+}
+
+static void checkCopyOnWriteAllocations(std::size_t entries) {
+    using CountedTable = HashTable<std::uint64_t, std::string, CountingInstrumentation>;
+    CountedTable table;
+    table.setCopyOnWrite(true);
+    for (std::uint64_t key = 0; key < entries; ++key) table.insert(key, valueOf(key, 0));
+
+    CountingInstrumentation::Scope scope;
+    CountedTable copy = table;
+    bool threw = false;
+    try {
+        copy[entries] = valueOf(entries, 1);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    copy.remove(entries);
+    InstrumentationCounters counted = scope.elapsed();
+    check(threw && counted.allocations == 0,
+          "copy-on-write: copying and missing keys allocated " + std::to_string(counted.allocations) + " nodes");
+
+    copy[0] = valueOf(0, 1);
+    counted = scope.elapsed();
+    check(counted.allocations > 0 && counted.allocations < entries,
+          "copy-on-write: a write through operator[] allocated " + std::to_string(counted.allocations) + " nodes");
+    check(table.get(0) == valueOf(0, 0) && copy.get(0) == valueOf(0, 1), "copy-on-write: operator[] wrote to both");
+}
+
+static void checkNodeHandles(std::size_t operations, std::uint64_t seed, bool copyOnWrite) {
+    std::string name = copyOnWrite ? "node handles (copy-on-write)" : "node handles";
+    std::mt19937_64 random(seed);
+    std::uint64_t keys = operations / 4 + 1;
+    HashTable<std::uint64_t, std::string> tables[2];
+    Model models[2];
+    for (auto& table : tables) table.setCopyOnWrite(copyOnWrite);
+
+    // Held by the copy-on-write run, so extract() and merge() meet shared pages
+    std::pair<HashTable<std::uint64_t, std::string>, Model> snapshot;
+
+    for (std::size_t i = 0; i < operations; ++i) {
+        int from = static_cast<int>(random() % 2), to = 1 - from;
+        std::uint64_t key = random() % keys;
+        switch (random() % 10) {
+            case 0: {  // Move a key to the other table, unless it is there already
+                auto node = tables[from].extract(key);
+                auto expected = models[from].find(key);
+                check(node.empty() == (expected == models[from].end()), name + ": extract() disagrees");
+                if (node.empty()) break;
+                check(node.key() == key && node.value() == expected->second, name + ": extracted a wrong node");
+
+                bool present = models[to].count(key) > 0;
+                check(tables[to].insert(std::move(node)) != present, name + ": insert(NodeHandle&&) disagrees");
+                if (present) {
+                    check(!node.empty() && node.key() == key, name + ": rejected node left its handle");
+                    check(tables[from].insert(std::move(node)) && node.empty(), name + ": node couldn't go back");
+                } else {
+                    check(node.empty(), name + ": inserted node stayed in its handle");
+                    models[to][key] = expected->second;
+                    models[from].erase(expected);
+                }
+                break;
+            }
+            case 1:  // Extract, change the key, and insert into the same table
+                if (auto node = tables[from].extract(key)) {
+                    std::uint64_t newKey = random() % keys;
+                    std::string value = models[from][key];
+                    models[from].erase(key);
+                    node.key() = newKey;
+                    bool present = models[from].count(newKey) > 0;
+                    check(tables[from].insert(std::move(node)) != present, name + ": renamed node insert disagrees");
+                    if (!present) models[from][newKey] = value;
+                }
+                break;
+            case 2:
+                if (random() % 500 == 0) {
+                    if (copyOnWrite) snapshot = {tables[from], models[from]};
+                    tables[to].merge(tables[from]);
+                    for (auto entry = models[from].begin(); entry != models[from].end();) {
+                        if (models[to].emplace(entry->first, entry->second).second) entry = models[from].erase(entry);
+                        else ++entry;
+                    }
+                    checkTable(tables[from], models[from], name + ", merge() source");
+                    checkTable(tables[to], models[to], name + ", merge() target");
+                    if (copyOnWrite) checkTable(snapshot.first, snapshot.second, name + ", snapshot of merge() source");
+                }
+                break;
+            default:
+                randomOperation(tables[from], models[from], random, keys, i, name);
+        }
+    }
+
+    checkTable(tables[0], models[0], name);
+    checkTable(tables[1], models[1], name);
+    if (copyOnWrite) checkTable(snapshot.first, snapshot.second, name + ", snapshot");
+}
+
+static void checkNodeHandleAllocations(std::size_t entries) {
+    using CountedTable = HashTable<std::uint64_t, std::string, CountingInstrumentation>;
+    CountedTable source, target;
+    Model sourceModel, targetModel;
+    for (std::uint64_t key = 0; key < entries; ++key) {
+        source.insert(key, valueOf(key, 0));
+        sourceModel[key] = valueOf(key, 0);
+        if (key % 3 == 0) {
+            target.insert(key, valueOf(key, 1));
+            targetModel[key] = valueOf(key, 1);
+        }
+    }
+
+    // Half of the keys move one by one, the others with merge(), those present in both stay in the source
+    CountingInstrumentation::Scope scope;
+    for (std::uint64_t key = 0; key < entries; key += 2) {
+        auto node = source.extract(key);
+        if (target.insert(std::move(node))) {
+            targetModel[key] = sourceModel[key];
+            sourceModel.erase(key);
+        } else {
+            source.insert(std::move(node));
+        }
+    }
+    target.merge(source);
+    InstrumentationCounters counted = scope.elapsed();
+
+    for (auto entry = sourceModel.begin(); entry != sourceModel.end();) {
+        if (targetModel.emplace(entry->first, entry->second).second) entry = sourceModel.erase(entry);
+        else ++entry;
+    }
+    check(counted.allocations == 0 && counted.deallocations == 0,
+          "node handles: moves allocated " + std::to_string(counted.allocations) + " nodes and freed " +
+          std::to_string(counted.deallocations));
+    checkTable(source, sourceModel, "node handles, allocations check source");
+    checkTable(target, targetModel, "node handles, allocations check target");
+}
+
+static void checkExpiry(std::size_t operations, std::uint64_t seed) {
+    using namespace std::chrono_literals;
+    std::mt19937_64 random(seed);
+    std::uint64_t keys = operations / 4 + 1;
+    HashTable<std::uint64_t, std::string, NoInstrumentation, true> table;
+    Model model;
+
+    // Expired entries are missing from the model, living ones last longer than the check
+    for (std::size_t i = 0; i < operations; ++i) {
+        std::uint64_t key = random() % keys;
+        switch (random() % 8) {
+            case 0:
+                table.insert(key, valueOf(key, i), 0ms);
+                model.erase(key);
+                break;
+            case 1:
+                table.insert(key, valueOf(key, i), 1h);
+                model[key] = valueOf(key, i);
+                break;
+            case 2:
+                table.expire();
+                break;
+            default:
+                randomOperation(table, model, random, keys, i, "expiry");
+        }
+        if (i % 10007 == 0) checkTable(table, model, "expiry");
+    }
+    table.expire();
+    checkTable(table, model, "expiry");
+
+    // Short lived entries, on keys absent from the table so the size only depends on the expiry
+    std::vector<std::uint64_t> shortLived;
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t key = keys; key < keys + keys / 4 + 1; ++key) {
+        table.insert(key, valueOf(key, 0), 200ms);
+        shortLived.push_back(key);
+    }
+    // Slow inserts (under a sanitizer) may outlive the first entries, which later inserts then free
+    if (std::chrono::steady_clock::now() - start < 200ms)
+        check(table.size() == static_cast<int>(model.size() + shortLived.size()), "expiry: short lived entries missing");
+    std::this_thread::sleep_for(300ms);
+    for (std::uint64_t key : shortLived) check(!table.contains(key), "expiry: expired key still found");
+    table.expire();
+    checkTable(table, model, "expiry, after 300 ms");
+}
+
+static void checkThreads(std::size_t operations, std::uint64_t seed) {
+    std::mt19937_64 random(seed);
+    std::uint64_t keys = operations / 4 + 1;
+    HashTable<std::uint64_t, std::string> table;
+    Model model;
+    table.setCopyOnWrite(true);
+    for (std::size_t i = 0; i < keys; ++i) randomOperation(table, model, random, keys, 0, "threads");
+
+    HashTable<std::uint64_t, std::string> copy = table;
+    std::atomic<bool> writing{true};
+    std::atomic<std::size_t> readerPasses{0};
+    std::thread reader([&] {
+        // The copy must keep the contents it was copied with, whatever the writes to the original
+        while (writing.load(std::memory_order_acquire) || readerPasses.load() == 0) {
+            checkTable(copy, model, "threads, copy read concurrently");
+            readerPasses++;
+        }
+    });
+
+    Model written = model;
+    for (std::size_t i = 0; i < operations; ++i) randomOperation(table, written, random, keys, i + 1, "threads");
+    writing.store(false, std::memory_order_release);
+    reader.join();
+
+    checkTable(table, written, "threads, original");
+    std::cout << "  (" << readerPasses << " passes over the copy during the writes)\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t operations = argc > 1 ? std::stoull(argv[1]) : 50000;
+    std::uint64_t seed = argc > 2 ? std::stoull(argv[2]) : 42;
+
+    std::cout << "filter\n";
+    checkFilter(operations, seed);
+    std::cout << "copy-on-write\n";
+    checkCopyOnWrite(operations, seed);
+    checkCopyOnWriteAllocations(operations);
+    std::cout << "node handles\n";
+    checkNodeHandles(operations, seed, false);
+    checkNodeHandles(operations, seed, true);
+    checkNodeHandleAllocations(operations);
+    std::cout << "expiry\n";
+    checkExpiry(operations, seed);
+    std::cout << "threads\n";
+    checkThreads(operations, seed);
+    std::cout << "OK\n";
+    return 0;
+}
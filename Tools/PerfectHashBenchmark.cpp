@@ -0,0 +1,126 @@
+/**
+ * @file PerfectHashBenchmark.cpp
+ * @brief Measures the lookups of PerfectHashTable against the chained HashTable, for string and integer keys.
+ *
+ * Usage:
+ *   PerfectHashBenchmark [<keys> [<lookups>]]
+ *
+ *   <keys>     Keys of each table (1000000 by default).
+ *   <lookups>  Lookups of each measure (10000000 by default).
+ *
+ * Each key type is built into both tables, the build time and memory of PerfectHashTable's hash
+ * function are printed, then the same random keys are looked up in both:
+ *  - hits, independent: every lookup is for a present key, and the next key doesn't depend on the
+ *    result, so the CPU overlaps the cache misses of several lookups,
+ *  - hits, dependent: the value found picks the next key, one lookup's misses at a time, the latency,
+ *  - misses: every key is absent.
+ * The string keys are 20 to 30 characters, the integer ones random 64 bit values.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -pthread Tools/PerfectHashBenchmark.cpp Hashing/MinimalPerfectHash.cpp -o PerfectHashBenchmark
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Hashing/HashTable.h"
+#include "../Hashing/PerfectHashTable.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void report(const std::string& name, double seconds, std::size_t lookups, std::uint64_t checksum) {
+    std::cout << "  " << std::left << std::setw(38) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(8) << seconds / lookups * 1e9 << " ns per lookup (checksum " << checksum << ")\n";
+}
+
+/**
+ * @brief Looks up the keys in a table, `find(key)` returning a pointer to the value or nullptr.
+ */
+template<typename Key, typename Find>
+static void measure(const std::string& name, const std::vector<Key>& keys, const std::vector<Key>& absent,
+                    std::size_t lookups, Find find) {
+    std::mt19937_64 random(7);
+    std::vector<std::size_t> picks(lookups);
+    for (auto& pick : picks) pick = random() % keys.size();
+
+    std::uint64_t checksum = 0;
+    auto start = Clock::now();
+    for (std::size_t pick : picks) checksum += *find(keys[pick]);
+    report(name + ", hits, independent", secondsSince(start), lookups, checksum);
+
+    // Values are indices of keys, so each lookup waits for the previous one
+    checksum = 0;
+    std::size_t next = 0;
+    start = Clock::now();
+    for (std::size_t i = 0; i < lookups; ++i) {
+        next = (*find(keys[next]) + i) % keys.size();
+        checksum += next;
+    }
+    report(name + ", hits, dependent", secondsSince(start), lookups, checksum);
+
+    checksum = 0;
+    start = Clock::now();
+    for (std::size_t pick : picks) checksum += find(absent[pick]) == nullptr;
+    report(name + ", misses", secondsSince(start), lookups, checksum);
+}
+
+template<typename Key>
+static void compare(const std::string& keyType, const std::vector<Key>& keys, const std::vector<Key>& absent,
+                    std::size_t lookups) {
+    std::cout << keyType << " keys\n";
+
+    std::vector<std::pair<Key, std::uint64_t>> entries;
+    entries.reserve(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) entries.emplace_back(keys[i], i);
+
+    auto start = Clock::now();
+    auto perfect = PerfectHashTable<Key, std::uint64_t>::build(std::move(entries));
+    double perfectBuild = secondsSince(start);
+
+    start = Clock::now();
+    HashTable<Key, std::uint64_t> chained;
+    for (std::size_t i = 0; i < keys.size(); ++i) chained.insert(keys[i], i);
+    double chainedBuild = secondsSince(start);
+
+    std::cout << "  build: PerfectHashTable " << std::setprecision(2) << perfectBuild << " s ("
+              << perfect.bitsPerKey() << " bits per key), HashTable " << chainedBuild << " s\n";
+
+    measure("PerfectHashTable", keys, absent, lookups, [&](const Key& key) { return perfect.find(key); });
+    measure("HashTable", keys, absent, lookups, [&](const Key& key) { return chained.find(key); });
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t keysCount = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    std::size_t lookups = argc > 2 ? std::stoull(argv[2]) : 10000000;
+
+    // Present keys have an even last character or value, absent ones an odd one
+    std::mt19937_64 random(42);
+    std::vector<std::string> strings(keysCount), absentStrings(keysCount);
+    for (std::size_t i = 0; i < keysCount; ++i) {
+        std::string key = "user/" + std::to_string(random()) + "/";
+        key.resize(20 + random() % 10, 'x');
+        strings[i] = key + 'a';
+        absentStrings[i] = key + 'b';
+    }
+    compare("std::string", strings, absentStrings, lookups);
+
+    std::vector<std::uint64_t> integers(keysCount), absentIntegers(keysCount);
+    for (std::size_t i = 0; i < keysCount; ++i) {
+        integers[i] = random() & ~std::uint64_t(1);
+        absentIntegers[i] = random() | 1;
+    }
+    compare("std::uint64_t", integers, absentIntegers, lookups);
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file PersistentMapBenchmark.cpp
+ * @brief Measures the cost of keeping versions of a map with HashArrayMappedTrie against copying HashTable.
+ *
+ * Usage:
+ *   PersistentMapBenchmark [<entries> [<versions>]]
+ *
+ *   <entries>   Entries of the map (1000000 by default).
+ *   <versions>  Versions kept, each one update away from the previous one (1000 by default).
+ *
+ * Keys and values are 64 bit integers. The map is built, then every version is made by one update
+ * of a random key while all the previous versions are kept alive. The versions are made:
+ *  - by copying a HashTable and updating the copy (a deep copy),
+ *  - by copying a HashTable with copy-on-write enabled (the update duplicates one page),
+ *  - by HashArrayMappedTrie::insert() (the update copies the path to the key).
+ * The HashTable versions are limited to what fits in memory, the reported time is per version.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 Tools/PersistentMapBenchmark.cpp -o PersistentMapBenchmark
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../Hashing/HashTable.h"
+#include "../Tries/HashArrayMappedTrie.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template<typename Make>
+static void measureVersions(const std::string& name, std::size_t versionsCount, Make makeVersion) {
+    auto start = Clock::now();
+    makeVersion(versionsCount);
+    double elapsed = secondsSince(start);
+    std::cout << name << ": " << elapsed / versionsCount * 1e6 << " us per version ("
+              << versionsCount << " versions)\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t entriesCount = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    std::size_t versionsCount = argc > 2 ? std::stoull(argv[2]) : 1000;
+
+    std::mt19937_64 random(42);
+    std::vector<std::uint64_t> keys(entriesCount);
+    for (auto& key : keys) key = random();
+
+    // Building
+    auto start = Clock::now();
+    HashTable<std::uint64_t, std::uint64_t> table(static_cast<int>(entriesCount) | 1);
+    for (auto key : keys) table.insert(key, key);
+    std::cout << "HashTable build: " << secondsSince(start) << " s\n";
+
+    start = Clock::now();
+    HashArrayMappedTrie<std::uint64_t, std::uint64_t> persistent;
+    for (auto key : keys) persistent = persistent.insert(key, key);
+    std::cout << "HashArrayMappedTrie build, persistent inserts: " << secondsSince(start) << " s\n";
+
+    start = Clock::now();
+    auto batch = HashArrayMappedTrie<std::uint64_t, std::uint64_t>().transient();
+    for (auto key : keys) batch.insert(key, key);
+    HashArrayMappedTrie<std::uint64_t, std::uint64_t> trie = batch.persistent();
+    std::cout << "HashArrayMappedTrie build, transient inserts: " << secondsSince(start) << " s\n";
+
+    // Lookups
+    std::uint64_t sum = 0;
+    start = Clock::now();
+    for (auto key : keys) sum += *table.find(key);
+    std::cout << "HashTable lookups: " << secondsSince(start) / entriesCount * 1e9 << " ns\n";
+    start = Clock::now();
+    for (auto key : keys) sum += *trie.find(key);
+    std::cout << "HashArrayMappedTrie lookups: " << secondsSince(start) / entriesCount * 1e9 << " ns (" << sum << ")\n";
+
+    // Versions, each one update away from the previous one
+    auto updatedKey = [&] { return keys[random() % entriesCount]; };
+    std::size_t copiesCount = std::min<std::size_t>(versionsCount, std::max<std::size_t>(1, 20000000 / entriesCount));
+
+    measureVersions("HashTable deep copies", copiesCount, [&](std::size_t count) {
+        std::vector<HashTable<std::uint64_t, std::uint64_t>> versions{table};
+        for (std::size_t i = 1; i < count; ++i) {
+            versions.push_back(versions.back());
+            versions.back().insert(updatedKey(), i);
+        }
+    });
+
+    measureVersions("HashTable copy-on-write", versionsCount, [&](std::size_t count) {
+        HashTable<std::uint64_t, std::uint64_t> shared = table;
+        shared.setCopyOnWrite(true);
+        std::vector<HashTable<std::uint64_t, std::uint64_t>> versions{shared};
+        for (std::size_t i = 1; i < count; ++i) {
+            versions.push_back(versions.back());
+            versions.back().insert(updatedKey(), i);
+        }
+    });
+
+    measureVersions("HashArrayMappedTrie", versionsCount, [&](std::size_t count) {
+        std::vector<HashArrayMappedTrie<std::uint64_t, std::uint64_t>> versions{trie};
+        for (std::size_t i = 1; i < count; ++i)
+            versions.push_back(versions.back().insert(updatedKey(), i));
+    });
+    return 0;
+}
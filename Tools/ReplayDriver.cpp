@@ -0,0 +1,114 @@
+/**
+ * @file ReplayDriver.cpp
+ * @brief Command line driver replaying a recorded trace against one of the containers.
+ *
+ * Usage:
+ *   ReplayDriver <trace> <container> [--paced] [--events] [--capacity <entries>] [--convert <binary trace>]
+ *
+ *   <trace>      CSV or binary trace (see Common/WorkloadReplay.h), or zipf:<operations>:<keys>[:<skew>]
+ *                to generate gets of Zipfian distributed keys.
+ *   <container>  hashtable, cuckoo, cache, avl, bst, binaryheap, binomialheap, leftistheap or trie.
+ *                Keys and values are replayed as std::string.
+ *   --paced      Replay at the recorded rate instead of full speed.
+ *   --events     Instantiate the container with CountingInstrumentation, so the slowest operations
+ *                report the rehashes, rotations and allocations they triggered (not available for trie,
+ *                whose instrumentation is chosen at compile time with DSA_TRIE_INSTRUMENTATION).
+ *   --capacity   Entries held by the cache (1000 by default), whose get hits and misses give its hit ratio.
+ *   --convert    Also write the trace in the binary format, which loads faster next time.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 Tools/ReplayDriver.cpp Tries/Trie.cpp -o ReplayDriver
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Common/WorkloadReplay.h"
+
+template<typename Container, typename... Args>
+static ReplayReport replay(const Trace& trace, ReplayPacing pacing, Args... args) {
+    Container container(args...);
+    return replayTrace(container, trace, pacing);
+}
+
+template<typename Instrumentation>
+static bool replay(const std::string& container, const Trace& trace, ReplayPacing pacing, std::size_t capacity,
+                   ReplayReport& report) {
+    using Key = std::string;
+
+    if (container == "hashtable") report = replay<HashTable<Key, std::string, Instrumentation>>(trace, pacing);
+    else if (container == "cuckoo") report = replay<CuckooHashTable<Key, std::string, Instrumentation>>(trace, pacing);
+    else if (container == "cache") report = replay<CacheTable<Key, std::string, Instrumentation>>(trace, pacing, capacity);
+    else if (container == "avl") report = replay<AVLTree<Key, std::less<Key>, Instrumentation>>(trace, pacing);
+    else if (container == "bst") report = replay<BinarySearchTree<Key, std::less<Key>, Instrumentation>>(trace, pacing);
+    else if (container == "binaryheap") report = replay<BinaryMinHeap<Key, std::less<Key>, Instrumentation>>(trace, pacing);
+    else if (container == "binomialheap") report = replay<BinomialMinHeap<Key, std::less<Key>, Instrumentation>>(trace, pacing);
+    else if (container == "leftistheap") report = replay<LeftistMinHeap<Key, std::less<Key>, Instrumentation>>(trace, pacing);
+    else if (container == "trie") report = replay<Trie>(trace, pacing);
+    else return false;
+
+    return true;
+}
+
+/**
+ * @brief Generates the trace described by zipf:<operations>:<keys>[:<skew>].
+ */
+static Trace zipfianTrace(const std::string& description) {
+    std::vector<std::string> fields;
+    std::istringstream stream(description.substr(5));
+    for (std::string field; std::getline(stream, field, ':');) fields.push_back(field);
+    if (fields.size() < 2 || fields.size() > 3)
+        throw std::invalid_argument("Invalid Zipfian trace " + description);
+
+    return makeZipfianTrace(std::stoul(fields[0]), std::stoul(fields[1]), fields.size() == 3 ? std::stod(fields[2]) : 0.99);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <trace> <container> [--paced] [--events] [--capacity <entries>] [--convert <binary trace>]\n";
+        return 2;
+    }
+
+    std::string tracePath = argv[1];
+    std::string container = argv[2];
+    ReplayPacing pacing = ReplayPacing::FullSpeed;
+    bool countEvents = false;
+    std::size_t capacity = 1000;
+    std::string convertPath;
+    for (int i = 3; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--paced") pacing = ReplayPacing::RecordedRate;
+        else if (option == "--events") countEvents = true;
+        else if (option == "--capacity" && i + 1 < argc) capacity = std::stoul(argv[++i]);
+        else if (option == "--convert" && i + 1 < argc) convertPath = argv[++i];
+        else {
+            std::cerr << "Unknown option " << option << '\n';
+            return 2;
+        }
+    }
+
+    try {
+        Trace trace = tracePath.rfind("zipf:", 0) == 0 ? zipfianTrace(tracePath) : readTrace(tracePath);
+        if (!convertPath.empty()) writeBinaryTrace(convertPath, trace);
+
+        ReplayReport report;
+        bool known = countEvents ? replay<CountingInstrumentation>(container, trace, pacing, capacity, report)
+                                 : replay<NoInstrumentation>(container, trace, pacing, capacity, report);
+        if (!known) {
+            std::cerr << "Unknown container " << container << '\n';
+            return 2;
+        }
+
+        std::cout << trace.size() << " operations replayed against " << container << '\n';
+        printReplayReport(std::cout, report);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
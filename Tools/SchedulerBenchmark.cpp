@@ -0,0 +1,93 @@
+/**
+ * @file SchedulerBenchmark.cpp
+ * @brief Measures the overhead of TaskScheduler's fork/join and the scaling of parallelFor with the workers.
+ *
+ * Usage:
+ *   SchedulerBenchmark [<max workers> [<iterations>]]
+ *
+ *   <max workers>  Largest pool measured, every count from 1 up to it (the hardware threads by default).
+ *   <iterations>   Iterations of the parallelFor loop (10000000 by default).
+ *
+ * For each pool size:
+ *  - fork/join from outside: parallelInvoke of two empty functions called from the main thread, which
+ *    submits through the shared queue and waits for a worker, reported per call,
+ *  - fork/join inside the pool: a binary tree of 2^20 empty tasks made of nested parallelInvoke calls,
+ *    the cost of forking from a worker's own deque and of stealing, reported per task,
+ *  - parallelFor over the iterations, each one a few dozen floating point operations, with the default
+ *    grain, reported as time and speedup against a plain loop on the main thread.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -pthread Tools/SchedulerBenchmark.cpp -o SchedulerBenchmark
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Common/TaskScheduler.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static double work(std::size_t i) {
+    double x = static_cast<double>(i);
+    for (int step = 0; step < 8; ++step) x = std::sqrt(x * 1.0001 + step);
+    return x;
+}
+
+/**
+ * @brief Forks a binary tree of empty tasks.
+ */
+static void forkTree(TaskScheduler& scheduler, int depth) {
+    if (depth == 0) return;
+    scheduler.parallelInvoke([&] { forkTree(scheduler, depth - 1); }, [&] { forkTree(scheduler, depth - 1); });
+}
+
+int main(int argc, char* argv[]) {
+    unsigned maxWorkers = argc > 1 ? static_cast<unsigned>(std::stoul(argv[1]))
+                                   : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t iterations = argc > 2 ? std::stoull(argv[2]) : 10000000;
+    const int treeDepth = 20;
+    const int externalCalls = 100000;
+
+    // Sequential reference
+    std::vector<double> results(iterations);
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) results[i] = work(i);
+    double sequential = secondsSince(start);
+    std::cout << "Sequential loop: " << sequential * 1e3 << " ms\n";
+
+    for (unsigned workers = 1; workers <= maxWorkers; ++workers) {
+        TaskScheduler scheduler(workers);
+        std::cout << workers << " worker" << (workers > 1 ? "s" : "") << ":\n";
+
+        start = Clock::now();
+        for (int i = 0; i < externalCalls; ++i) scheduler.parallelInvoke([] {}, [] {});
+        std::cout << "  parallelInvoke from outside: " << secondsSince(start) / externalCalls * 1e9 << " ns per call\n";
+
+        // Run the tree from inside the pool, so the forks go to the workers' deques
+        start = Clock::now();
+        scheduler.parallelInvoke([&] { forkTree(scheduler, treeDepth); }, [] {});
+        double tasks = static_cast<double>((1u << (treeDepth + 1)) - 1);
+        std::cout << "  nested parallelInvoke: " << secondsSince(start) / tasks * 1e9 << " ns per task\n";
+
+        start = Clock::now();
+        scheduler.parallelFor(std::size_t{0}, iterations, [&](std::size_t i) { results[i] = work(i); });
+        double elapsed = secondsSince(start);
+        std::cout << "  parallelFor: " << elapsed * 1e3 << " ms, speedup " << sequential / elapsed << "\n";
+    }
+
+    double checksum = 0;
+    for (double result : results) checksum += result;
+    std::cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file SplitOrderedCheck.cpp
+ * @brief Checks SplitOrderedHashTable against std::map, then under concurrent inserts, removes and lookups.
+ *
+ * Usage:
+ *   SplitOrderedCheck [<operations> [<threads>]]
+ *
+ *   <operations>  Random operations of each thread (200000 by default).
+ *   <threads>     Threads of the concurrent checks (4 by default).
+ *
+ * Checks:
+ *  - sequential: random inserts, removes and lookups from one thread, every result compared with a
+ *    std::map, growing the table from 1 bucket.
+ *  - contended: every thread inserts, removes and looks up random keys of a small shared range. A key
+ *    is present at the end iff its successful inserts outnumber its successful removes (by exactly one,
+ *    since insert() fails on a present key and remove() on an absent one), which the threads count.
+ *    Every value found must be the one inserted with the key.
+ *  - growing: every thread inserts its own range of keys while doubling the table, then removes every
+ *    other key, and looks up the keys of the other threads meanwhile, which can only find their values.
+ * Each check ends comparing every key and size() with the counts. The tool fails (exit code 1) at the
+ * first difference.
+ *
+ * Build (from the repository root), with ThreadSanitizer:
+ *   g++ -std=c++17 -O1 -g -fsanitize=thread -pthread Tools/SplitOrderedCheck.cpp -o SplitOrderedCheck
+ * or with AddressSanitizer and UndefinedBehaviorSanitizer:
+ *   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -pthread Tools/SplitOrderedCheck.cpp -o SplitOrderedCheck
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Hashing/SplitOrderedHashTable.h"
+
+using Table = SplitOrderedHashTable<std::uint64_t, std::uint64_t>;
+
+static std::atomic<bool> failed{false};
+
+static void check(bool condition, const std::string& message) {
+    if (condition || failed.exchange(true)) return;
+    std::cout << "FAILED: " << message << "\n";
+}
+
+/**
+ * @brief Value inserted with a key by a thread, so a lookup can tell whether it belongs to the key.
+ */
+static std::uint64_t valueOf(std::uint64_t key, std::size_t thread) {
+    return key << 8 | thread;
+}
+
+template<typename Body>
+static void runThreads(std::size_t threadsCount, Body body) {
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 0; thread < threadsCount; ++thread) threads.emplace_back(body, thread);
+    for (auto& thread : threads) thread.join();
+}
+
+/**
+ * @brief Checks the table holds exactly the keys of [0, keys) whose count is 1, none having another count.
+ */
+static void checkContents(const Table& table, const std::vector<std::int64_t>& counts, const std::string& name) {
+    std::size_t present = 0;
+    for (std::uint64_t key = 0; key < counts.size(); ++key) {
+        check(counts[key] == 0 || counts[key] == 1,
+              name + ": key " + std::to_string(key) + " inserted " + std::to_string(counts[key]) + " more times than removed");
+        std::uint64_t value;
+        bool found = table.find(key, value);
+        check(found == (counts[key] == 1), name + ": key " + std::to_string(key) + " is " +
+                                           (found ? "present" : "missing"));
+        check(!found || value >> 8 == key, name + ": key " + std::to_string(key) + " has another key's value");
+        present += found;
+    }
+    check(table.size() == present, name + ": size " + std::to_string(table.size()) + " instead of " +
+                                   std::to_string(present));
+}
+
+static void checkSequential(std::size_t operations) {
+    std::mt19937_64 random(42);
+    std::uint64_t keys = operations / 4 + 1;
+    Table table(1);
+    std::map<std::uint64_t, std::uint64_t> model;
+
+    for (std::size_t i = 0; i < operations && !failed; ++i) {
+        std::uint64_t key = random() % keys, value;
+        switch (random() % 4) {
+            case 0:
+            case 1:
+                check(table.insert(key, i) == model.emplace(key, i).second, "sequential: insert() disagrees");
+                break;
+            case 2:
+                check(table.remove(key) == (model.erase(key) > 0), "sequential: remove() disagrees");
+                break;
+            default: {
+                auto expected = model.find(key);
+                bool found = table.find(key, value);
+                check(found == (expected != model.end()) && (!found || value == expected->second),
+                      "sequential: find() disagrees on key " + std::to_string(key));
+                check(table.contains(key) == found, "sequential: contains() disagrees");
+            }
+        }
+    }
+
+    check(table.size() == model.size(), "sequential: size() disagrees");
+    for (const auto& [key, value] : model) check(table.get(key) == value, "sequential: get() disagrees");
+    std::cout << "  " << table.bucketsCount() << " buckets for " << table.size() << " keys\n";
+}
+
+static void checkContended(std::size_t operations, std::size_t threadsCount) {
+    constexpr std::uint64_t KEYS = 512;
+    Table table;
+    std::vector<std::vector<std::int64_t>> counts(threadsCount, std::vector<std::int64_t>(KEYS));
+
+    runThreads(threadsCount, [&](std::size_t thread) {
+        std::mt19937_64 random(thread + 1);
+        for (std::size_t i = 0; i < operations && !failed; ++i) {
+            std::uint64_t key = random() % KEYS, value;
+            switch (random() % 3) {
+                case 0:
+                    counts[thread][key] += table.insert(key, valueOf(key, thread));
+                    break;
+                case 1:
+                    counts[thread][key] -= table.remove(key);
+                    break;
+                default:
+                    if (table.find(key, value)) check(value >> 8 == key, "contended: a lookup found another key's value");
+            }
+        }
+    });
+
+    std::vector<std::int64_t> total(KEYS);
+    for (const auto& threadCounts : counts)
+        for (std::uint64_t key = 0; key < KEYS; ++key) total[key] += threadCounts[key];
+    checkContents(table, total, "contended");
+}
+
+static void checkGrowing(std::size_t operations, std::size_t threadsCount) {
+    Table table(1);
+    std::uint64_t keysCount = operations * threadsCount;
+
+    runThreads(threadsCount, [&](std::size_t thread) {
+        std::mt19937_64 random(thread + 1);
+        auto lookUpOthers = [&] {
+            std::uint64_t key = random() % keysCount, value;
+            if (table.find(key, value)) check(value == valueOf(key, key % threadsCount), "growing: wrong value");
+        };
+
+        // Thread t owns the keys equal to t modulo the threads count
+        for (std::uint64_t key = thread; key < keysCount && !failed; key += threadsCount) {
+            check(table.insert(key, valueOf(key, thread)), "growing: insert() of a new key failed");
+            lookUpOthers();
+        }
+        for (std::uint64_t key = thread; key < keysCount && !failed; key += 2 * threadsCount) {
+            check(table.remove(key), "growing: remove() of a present key failed");
+            lookUpOthers();
+        }
+    });
+
+    std::vector<std::int64_t> expected(keysCount);
+    for (std::uint64_t key = 0; key < keysCount; ++key) expected[key] = (key / threadsCount) % 2;
+    checkContents(table, expected, "growing");
+    std::cout << "  " << table.bucketsCount() << " buckets for " << table.size() << " keys\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t operations = argc > 1 ? std::stoull(argv[1]) : 200000;
+    std::size_t threadsCount = argc > 2 ? std::stoull(argv[2]) : 4;
+
+    std::cout << "sequential\n";
+    checkSequential(operations);
+    std::cout << "contended, " << threadsCount << " threads\n";
+    if (!failed) checkContended(operations, threadsCount);
+    std::cout << "growing, " << threadsCount << " threads\n";
+    if (!failed) checkGrowing(operations, threadsCount);
+
+    std::cout << (failed ? "FAILED\n" : "OK\n");
+    return failed ? 1 : 0;
+}
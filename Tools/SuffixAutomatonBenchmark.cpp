@@ -0,0 +1,89 @@
+/**
+ * @file SuffixAutomatonBenchmark.cpp
+ * @brief Measures the construction and the queries of SuffixAutomaton over a large text.
+ *
+ * Usage:
+ *   SuffixAutomatonBenchmark [<text bytes> [<alphabet>] [<queries>]]
+ *
+ *   <text bytes>  Size of the text (100000000 by default).
+ *   <alphabet>    Characters the text is drawn from ("ACGT" by default).
+ *   <queries>     Patterns of each kind queried (1000000 by default).
+ *
+ * The text is drawn uniformly from the alphabet. The queries are 20 character patterns, half of them
+ * substrings of the text and half random strings, for containsSubstring() and countOccurrences(),
+ * then longestCommonSubstring() of a 1 MB string holding a 1000 character slice of the text.
+ * The automaton takes (alphabet size + 3) ints per state: 4.5 GB or more for the default 100 MB text.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 Tools/SuffixAutomatonBenchmark.cpp Tries/SuffixAutomaton.cpp -o SuffixAutomatonBenchmark
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../Tries/SuffixAutomaton.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t textSize = argc > 1 ? std::stoull(argv[1]) : 100000000;
+    std::string alphabet = argc > 2 ? argv[2] : "ACGT";
+    std::size_t queriesCount = argc > 3 ? std::stoull(argv[3]) : 1000000;
+    const std::size_t patternSize = 20;
+    if (textSize < patternSize || alphabet.empty() || queriesCount == 0) {
+        std::cerr << "Usage: " << argv[0] << " [<text bytes> [<alphabet>] [<queries>]]\n"
+                  << "The text needs at least " << patternSize << " characters, the alphabet and the queries at least one.\n";
+        return 2;
+    }
+
+    std::mt19937_64 random(42);
+    auto randomString = [&](std::size_t size) {
+        std::string result(size, ' ');
+        for (auto& ch : result) ch = alphabet[random() % alphabet.size()];
+        return result;
+    };
+    std::string text = randomString(textSize);
+
+    auto start = Clock::now();
+    SuffixAutomaton automaton(text);
+    double elapsed = secondsSince(start);
+    std::cout << "Build: " << elapsed << " s, " << elapsed / textSize * 1e9 << " ns per character, "
+              << automaton.stateCount() << " states ("
+              << static_cast<double>(automaton.stateCount()) / textSize << " per character)\n";
+
+    std::vector<std::string> patterns(queriesCount);
+    for (std::size_t i = 0; i < queriesCount; ++i) {
+        if (i % 2) patterns[i] = randomString(patternSize);
+        else patterns[i] = text.substr(random() % (textSize - patternSize + 1), patternSize);
+    }
+
+    std::size_t found = 0;
+    start = Clock::now();
+    for (const auto& pattern : patterns) found += automaton.containsSubstring(pattern);
+    std::cout << "containsSubstring: " << secondsSince(start) / queriesCount * 1e9 << " ns (" << found
+              << " found)\n";
+
+    std::uint64_t occurrences = 0;
+    start = Clock::now();
+    for (const auto& pattern : patterns) occurrences += automaton.countOccurrences(pattern);
+    std::cout << "countOccurrences: " << secondsSince(start) / queriesCount * 1e9 << " ns (" << occurrences
+              << " occurrences)\n";
+
+    std::string other = randomString(1000000);
+    other.replace(other.size() / 2, 1000, text.substr(textSize / 2, 1000));
+    start = Clock::now();
+    std::string common = automaton.longestCommonSubstring(other);
+    std::cout << "longestCommonSubstring of " << other.size() << " characters: " << secondsSince(start) * 1e3
+              << " ms (" << common.size() << " characters)\n";
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file TrieSoak.cpp
+ * @brief Churns a Trie with inserts and removals, showing whether its memory stays flat over time.
+ *
+ * Usage:
+ *   TrieSoak [<rounds> [<live words> [<churn>]]]
+ *
+ *   <rounds>      Rounds of churn (100 by default).
+ *   <live words>  Words kept in the trie (200000 by default).
+ *   <churn>       Words removed, then replaced by new ones, in each round (100000 by default).
+ *
+ * Words are 4 to 16 random lowercase letters, the live words all distinct: a new word already live
+ * is drawn again. The trie is filled once, then each round removes random live words and inserts as
+ * many new ones, so the number of words stays constant, which the tool checks (exit code 1). Every
+ * 10 rounds (and after the last one), the tool prints the words, nodeCount(), the node and
+ * children map bytes of stats(), and the resident set size of the process read from /proc (Linux).
+ * A trie that doesn't erase the edges of removed words keeps growing in nodes, map bytes and RSS.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 Tools/TrieSoak.cpp Tries/Trie.cpp -o TrieSoak
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <unistd.h>
+
+#include "../Tries/Trie.h"
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @return resident set size of the process in MB, 0 if /proc isn't available.
+ */
+static double residentMegabytes() {
+    std::ifstream statm("/proc/self/statm");
+    std::size_t totalPages = 0, residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) return 0;
+    return static_cast<double>(residentPages) * static_cast<double>(::sysconf(_SC_PAGESIZE)) / (1 << 20);
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t rounds = argc > 1 ? std::stoull(argv[1]) : 100;
+    std::size_t liveCount = argc > 2 ? std::stoull(argv[2]) : 200000;
+    std::size_t churn = argc > 3 ? std::stoull(argv[3]) : 100000;
+    if (liveCount == 0 || liveCount > 1000000000) {
+        std::cerr << "Usage: " << argv[0] << " [<rounds> [<live words> [<churn>]]]\n"
+                  << "Live words must be between 1 and 1000000000.\n";
+        return 2;
+    }
+
+    std::mt19937_64 random(42);
+    std::unordered_set<std::string> liveSet;
+    auto newWord = [&] {
+        std::string word;
+        do {
+            word.assign(4 + random() % 13, ' ');
+            for (auto& ch : word) ch = static_cast<char>('a' + random() % 26);
+        } while (!liveSet.insert(word).second);
+        return word;
+    };
+
+    Trie trie;
+    std::vector<std::string> live(liveCount);
+    for (auto& word : live) {
+        word = newWord();
+        trie.insert(word);
+    }
+
+    bool failed = false;
+    auto report = [&](std::size_t round, double seconds) {
+        if (static_cast<std::size_t>(trie.size()) != liveCount) {
+            std::cout << "FAILED: " << trie.size() << " words in the trie instead of " << liveCount << "\n";
+            failed = true;
+        }
+        Trie::Stats stats = trie.stats();
+        std::cout << "round " << round << ": " << trie.size() << " words, " << trie.nodeCount() << " nodes, "
+                  << (stats.nodeBytes + stats.childrenMapBytes) / (1 << 20) << " MB in nodes and maps, "
+                  << residentMegabytes() << " MB resident, " << seconds << " s\n";
+    };
+    report(0, 0);
+
+    auto start = Clock::now();
+    for (std::size_t round = 1; round <= rounds; ++round) {
+        for (std::size_t i = 0; i < churn; ++i) {
+            std::string& word = live[random() % liveCount];
+            trie.remove(word);
+            liveSet.erase(word);
+            word = newWord();
+            trie.insert(word);
+        }
+        if (round % 10 == 0 || round == rounds)
+            report(round, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return failed ? 1 : 0;
+}
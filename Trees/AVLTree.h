@@ -29,7 +29,14 @@
 // The AVLTree class allows insertion and removal of elements while keeping the tree balanced,
 // providing fast search and retrieval of elements with logarithmic time complexity.
 //
-// Note: The Key type must support comparison operators (>, <, >=, <=) for proper functionality.
+// Note: Values are ordered by the Compare policy (std::less by default). Each visited node costs a single
+// three-way comparison when the language allows it (see Common/ThreeWayCompare.h), at most two otherwise.
+//
+// The Instrumentation policy (see Common/Instrumentation.h) is notified of node allocations,
+// node visits, comparisons and rotations. The default NoInstrumentation compiles to nothing.
+//
+// Nodes are allocated from a std::pmr::memory_resource given at construction (the default resource
+// otherwise). Copies use the default resource, moves carry the nodes along with their resource.
 //
 // This code is designed for educational purposes and can be freely used and modified.
 // Refer to the GitHub repository for the full code and documentation:
@@ -40,9 +47,14 @@
 #ifndef DSA_AVLTREE_H
 #define DSA_AVLTREE_H
 
+#include <functional>
 #include <iostream>
 
-template <typename Comparable>
+#include "../Common/Instrumentation.h"
+#include "../Common/MemoryResource.h"
+#include "../Common/ThreeWayCompare.h"
+
+template <typename Comparable, typename Compare = std::less<Comparable>, typename Instrumentation = NoInstrumentation>
 class AVLTree {
 private:
 
@@ -74,6 +86,10 @@ public:
 
     // default constructor
     AVLTree() = default;
+    // Constructs an empty tree allocating its nodes from the given memory resource, which must outlive the tree.
+    explicit AVLTree(std::pmr::memory_resource* resource);
+    // Constructs an empty tree ordered by the given comparator.
+    explicit AVLTree(const Compare& compare, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
     // Copy constructor. Performs a deep copy.
     AVLTree(const AVLTree& rhs);
     // Move Constructor
@@ -112,6 +128,10 @@ public:
      * @brief clears the tree.
      * */
     void makeEmpty();
+    /**
+     * @return the memory resource the tree's nodes are allocated from.
+     * */
+    [[nodiscard]] std::pmr::memory_resource* getMemoryResource() const;
 
     /* Non-Const Methods */
     /**
@@ -137,6 +157,8 @@ public:
 
 private:
     AVLNode* root = nullptr;
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+    Compare compare;
 
     static const int ALLOWED_IMBALANCE = 1;
 
@@ -222,7 +244,7 @@ private:
      * @param value The value to be searched for in the AVL tree.
      * @return True if the value is found, otherwise false.
      */
-    bool contains(const AVLNode* const& node, Comparable value) const;
+    bool contains(const AVLNode* const& node, const Comparable& value) const;
 
     /**
      * @brief Print the AVL tree starting from the given node.
@@ -286,19 +308,19 @@ private:
 };
 
 /* region Static Helper Methods  */
-template <typename Comparable>
-int AVLTree<Comparable>::getHeight(const AVLNode *node) const {
+template <typename Comparable, typename Compare, typename Instrumentation>
+int AVLTree<Comparable, Compare, Instrumentation>::getHeight(const AVLNode *node) const {
     return node ?  node->height : -1;
 }
 
-template <typename Comparable>
-void AVLTree<Comparable>::setHeight(AVLNode *node) const {
+template <typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::setHeight(AVLNode *node) const {
     if(node)
         node->height = 1 + std::max(getHeight(node->right), getHeight(node->left));
 }
 
-template <typename Comparable>
-int AVLTree<Comparable>::getBalanceFactor(const AVLNode *node) const {
+template <typename Comparable, typename Compare, typename Instrumentation>
+int AVLTree<Comparable, Compare, Instrumentation>::getBalanceFactor(const AVLNode *node) const {
     if(!node) return 0;
     int leftHeight = getHeight(node->left);
     int rightHeight = getHeight(node->right);
@@ -306,18 +328,18 @@ int AVLTree<Comparable>::getBalanceFactor(const AVLNode *node) const {
     return leftHeight - rightHeight;
 }
 
-template <typename Comparable>
-bool AVLTree<Comparable>::isRightHeavy(const AVLNode *node) const {
+template <typename Comparable, typename Compare, typename Instrumentation>
+bool AVLTree<Comparable, Compare, Instrumentation>::isRightHeavy(const AVLNode *node) const {
     return getBalanceFactor(node) < ALLOWED_IMBALANCE * -1;
 }
 
-template <typename Comparable>
-bool AVLTree<Comparable>::isLeftHeavy(const AVLNode *node) const {
+template <typename Comparable, typename Compare, typename Instrumentation>
+bool AVLTree<Comparable, Compare, Instrumentation>::isLeftHeavy(const AVLNode *node) const {
     return getBalanceFactor(node) > ALLOWED_IMBALANCE;
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::makeEmpty(AVLTree::AVLNode *&node) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::makeEmpty(AVLTree::AVLNode *&node) {
     if(!node) return;
 
     // Empty the children
@@ -325,12 +347,13 @@ void AVLTree<Comparable>::makeEmpty(AVLTree::AVLNode *&node) {
     makeEmpty(node->left);
 
     // Delete the node content
-    delete(node);
+    Instrumentation::onDeallocate(sizeof(AVLNode));
+    deleteNode(resource, node);
     node = nullptr;
 }
 
-template<typename Comparable>
-typename AVLTree<Comparable>::AVLNode * AVLTree<Comparable>::findMin(AVLNode *node) const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+typename AVLTree<Comparable, Compare, Instrumentation>::AVLNode * AVLTree<Comparable, Compare, Instrumentation>::findMin(AVLNode *node) const {
     if(!node) return nullptr;
 
     if(!node->left) return node;
@@ -338,8 +361,8 @@ typename AVLTree<Comparable>::AVLNode * AVLTree<Comparable>::findMin(AVLNode *no
     return findMin(node->left);
 }
 
-template<typename Comparable>
-typename AVLTree<Comparable>::AVLNode* AVLTree<Comparable>::findMax(AVLNode *node) const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+typename AVLTree<Comparable, Compare, Instrumentation>::AVLNode* AVLTree<Comparable, Compare, Instrumentation>::findMax(AVLNode *node) const {
     if(!node) return nullptr;
 
     if(!node->right) return node;
@@ -347,29 +370,33 @@ typename AVLTree<Comparable>::AVLNode* AVLTree<Comparable>::findMax(AVLNode *nod
 
 }
 
-template<typename Comparable>
-typename  AVLTree<Comparable>::AVLNode* AVLTree<Comparable>::clone(const AVLNode *treeRoot) const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+typename  AVLTree<Comparable, Compare, Instrumentation>::AVLNode* AVLTree<Comparable, Compare, Instrumentation>::clone(const AVLNode *treeRoot) const {
     if(!treeRoot) return nullptr;
 
-    auto node = new AVLNode(treeRoot->value); // Copy the value of treeRoot to a new node.
+    Instrumentation::onAllocate(sizeof(AVLNode));
+    auto node = newNode<AVLNode>(resource, treeRoot->value); // Copy the value of treeRoot to a new node.
     node->right = clone(treeRoot->right); // Recursively clone the right subtree.
     node->left = clone(treeRoot->left);   // Recursively clone the left subtree.
 
     return node;
 }
 
-template<typename Comparable>
-bool AVLTree<Comparable>::contains(const  AVLNode * const& node, Comparable value) const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool AVLTree<Comparable, Compare, Instrumentation>::contains(const  AVLNode * const& node, const Comparable& value) const {
     if(!node) return false;
-    if(value > node->value) return contains(node->right, value);
-    if(value < node->value) return contains(node->left, value);
+    Instrumentation::onVisit();
+
+    int order = threeWayCompare<Instrumentation>(compare, value, node->value);
+    if(order > 0) return contains(node->right, value);
+    if(order < 0) return contains(node->left, value);
 
     // value found
     return true;
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::printTree(const AVLNode *treeRoot, int depth) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::printTree(const AVLNode *treeRoot, int depth) {
     if(!treeRoot) return;
 
     for (int i = 0; i < depth; ++i) {
@@ -386,30 +413,41 @@ void AVLTree<Comparable>::printTree(const AVLNode *treeRoot, int depth) {
 
 /* region Constructors */
 
+template<typename Comparable, typename Compare, typename Instrumentation>
+AVLTree<Comparable, Compare, Instrumentation>::AVLTree(std::pmr::memory_resource *resource) : resource(resource) {
+}
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+AVLTree<Comparable, Compare, Instrumentation>::AVLTree(const Compare& compare, std::pmr::memory_resource *resource)
+    : resource(resource), compare(compare) {
+}
+
 /* Copy Constructor */
-template<typename Comparable>
-AVLTree<Comparable>::AVLTree(const AVLTree& rhs) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+AVLTree<Comparable, Compare, Instrumentation>::AVLTree(const AVLTree& rhs) : compare(rhs.compare) {
     root = clone(rhs.root);
 }
 
 /* Move Constructor */
-template<typename Comparable>
-AVLTree<Comparable>::AVLTree(AVLTree&& rhs)  noexcept {
+template<typename Comparable, typename Compare, typename Instrumentation>
+AVLTree<Comparable, Compare, Instrumentation>::AVLTree(AVLTree&& rhs)  noexcept {
     root = rhs.root;
+    resource = rhs.resource;
+    compare = rhs.compare;
     rhs.root = nullptr;
 }
 
 /* Destructor */
-template<typename Comparable>
-AVLTree<Comparable>::~AVLTree() {
+template<typename Comparable, typename Compare, typename Instrumentation>
+AVLTree<Comparable, Compare, Instrumentation>::~AVLTree() {
     makeEmpty();
 }
 /* endregion */
 
 /* region Private Member Methods */
 
-template<typename Comparable>
-void AVLTree<Comparable>::balance(AVLNode *& node) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::balance(AVLNode *& node) {
     /*
      * If the tree is left heavy, there are two cases:
      * 1) If left subtree is left heavy (insertion done to the outside),
@@ -438,23 +476,27 @@ void AVLTree<Comparable>::balance(AVLNode *& node) {
     }
 };
 
-template<typename Comparable>
-void AVLTree<Comparable>::insert(const Comparable &value, AVLTree::AVLNode *&node) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::insert(const Comparable &value, AVLTree::AVLNode *&node) {
     // Base condition
     if(!node) {
-        node = new AVLNode(value);
+        Instrumentation::onAllocate(sizeof(AVLNode));
+        node = newNode<AVLNode>(resource, value);
         return;
     }
+    Instrumentation::onVisit();
+
+    int order = threeWayCompare<Instrumentation>(compare, value, node->value);
 
     // If value greater than current node,
     // Call the function recursively to the right child
-    if(value > node->value){
+    if(order > 0){
         insert(value,node->right);
      }
 
     // If value less than current node,
     // Call the function recursively to the left child
-    else if(value < node->value){
+    else if(order < 0){
         insert(value,node->left);
     }
 
@@ -467,8 +509,10 @@ void AVLTree<Comparable>::insert(const Comparable &value, AVLTree::AVLNode *&nod
 
 }
 
-template <typename Comparable>
-void AVLTree<Comparable>::rightRotate(AVLNode*& node) {
+template <typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::rightRotate(AVLNode*& node) {
+    Instrumentation::onRotate();
+
     auto newRoot = node->left;
     node->left = newRoot->right;
     newRoot->right = node;
@@ -481,8 +525,9 @@ void AVLTree<Comparable>::rightRotate(AVLNode*& node) {
     node = newRoot;
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::leftRotate(AVLNode*& node) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::leftRotate(AVLNode*& node) {
+    Instrumentation::onRotate();
 
     auto newRoot = node->right;
     node->right = newRoot->left;
@@ -495,13 +540,14 @@ void AVLTree<Comparable>::leftRotate(AVLNode*& node) {
 
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::removeNode(AVLNode*& node) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::removeNode(AVLNode*& node) {
     // Node is a isLeaf Node
     // Just delete it's content and set the pointer to nullptr
     bool isLeaf = node->left == nullptr && node->right == nullptr;
     if (isLeaf) {
-        delete node;
+        Instrumentation::onDeallocate(sizeof(AVLNode));
+        deleteNode(resource, node);
         node = nullptr;
         return;
     }
@@ -520,30 +566,35 @@ void AVLTree<Comparable>::removeNode(AVLNode*& node) {
         // Delete the node and replace it with its child
         if (node->left) {
             auto initialLeft = node->left;
-            delete node;
+            Instrumentation::onDeallocate(sizeof(AVLNode));
+            deleteNode(resource, node);
             node = initialLeft;
         } else if (node->right) {
             auto initialRight = node->right;
-            delete node;
+            Instrumentation::onDeallocate(sizeof(AVLNode));
+            deleteNode(resource, node);
             node = initialRight;
         }
 
     }
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::remove(const Comparable &value, AVLNode*& node) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::remove(const Comparable &value, AVLNode*& node) {
     // Node with the given value not found in the tree.
     if (!node ) {
         return;
     }
+    Instrumentation::onVisit();
+
+    int order = threeWayCompare<Instrumentation>(compare, value, node->value);
 
     // Node with the given value should be in the left subtree
-    if (value < node->value) {
+    if (order < 0) {
         remove(value, node->left);
 
     // Node with the given value should be in the right subtree
-    } else if (value > node->value) {
+    } else if (order > 0) {
         remove(value, node->right);
 
     // Found the node to be removed
@@ -562,31 +613,31 @@ void AVLTree<Comparable>::remove(const Comparable &value, AVLNode*& node) {
 /*endregion*/
 
 /* region Non-Constant Public Methods  */
-template<typename Comparable>
-void AVLTree<Comparable>::insert(const Comparable& value){
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::insert(const Comparable& value){
     insert(value,root);
 };
 
-template<typename Comparable>
-void AVLTree<Comparable>::insert(Comparable&& value){
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::insert(Comparable&& value){
     insert(std::move(value),root);
 };
 
-template<typename Comparable>
-void AVLTree<Comparable>::remove(const Comparable &value) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::remove(const Comparable &value) {
     remove(value,root);
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::remove(Comparable && value) {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::remove(Comparable && value) {
     remove(std::move(value),root);
 }
 
 /* endregion */
 
 /* region Constant Public Methods */
-template <typename Comparable>
-Comparable AVLTree<Comparable>::findMin() const{
+template <typename Comparable, typename Compare, typename Instrumentation>
+Comparable AVLTree<Comparable, Compare, Instrumentation>::findMin() const{
     auto minNode =findMin(root);
 
     if(!minNode){
@@ -596,8 +647,8 @@ Comparable AVLTree<Comparable>::findMin() const{
     return minNode->value;
 };
 
-template <typename Comparable>
-Comparable AVLTree<Comparable>::findMax() const{
+template <typename Comparable, typename Compare, typename Instrumentation>
+Comparable AVLTree<Comparable, Compare, Instrumentation>::findMax() const{
     auto maxNode = findMax(root);
 
     if(!maxNode){
@@ -607,29 +658,34 @@ Comparable AVLTree<Comparable>::findMax() const{
     return maxNode->value;
 };
 
-template<typename Comparable>
-bool AVLTree<Comparable>::contains(const Comparable &value) const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool AVLTree<Comparable, Compare, Instrumentation>::contains(const Comparable &value) const {
     return contains(root, value);
 }
-template<typename Comparable>
-bool AVLTree<Comparable>::contains(Comparable &&value) const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool AVLTree<Comparable, Compare, Instrumentation>::contains(Comparable &&value) const {
     return contains(root,std::move(value));
 }
 
-template<typename Comparable>
-bool AVLTree<Comparable>::isEmpty() const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+bool AVLTree<Comparable, Compare, Instrumentation>::isEmpty() const {
     return root == nullptr;
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::printTree() const {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::printTree() const {
     printTree(root, 0);
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::makeEmpty() {
+template<typename Comparable, typename Compare, typename Instrumentation>
+void AVLTree<Comparable, Compare, Instrumentation>::makeEmpty() {
     makeEmpty(root);
 }
+
+template<typename Comparable, typename Compare, typename Instrumentation>
+std::pmr::memory_resource *AVLTree<Comparable, Compare, Instrumentation>::getMemoryResource() const {
+    return resource;
+}
 /* endregion */
 
 #endif //DSA_AVLTREE_H
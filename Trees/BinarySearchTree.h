@@ -33,7 +33,14 @@
 // moderate search and retrieval performance with average time complexity of O(log n),
 // where n is the number of elements in the tree.
 //
-// Note: The Key type must support comparison operators (>, <, >=, <=) for proper functionality.
+// Note: Values are ordered by the Compare policy (std::less by default). Each visited node costs a single
+// three-way comparison when the language allows it (see Common/ThreeWayCompare.h), at most two otherwise.
+//
+// The Instrumentation policy (see Common/Instrumentation.h) is notified of node allocations,
+// node visits and comparisons. The default NoInstrumentation compiles to nothing.
+//
+// Nodes are allocated from a std::pmr::memory_resource given at construction (the default resource
+// otherwise). Copies use the default resource, moves carry the nodes along with their resource.
 //
 // This code is designed for educational purposes and can be freely used and modified.
 // Refer to the GitHub repository for the full code and documentation:
@@ -44,14 +51,22 @@
 #ifndef DATA_STRUCTURES_AND_ALGORITHM_ANALYSIS_IN_C_BINARYSEARCHTREE_H
 #define DATA_STRUCTURES_AND_ALGORITHM_ANALYSIS_IN_C_BINARYSEARCHTREE_H
 
+#include <functional>
 #include <iostream>
 #include <utility>
 
-template <typename Comparable>
+#include "../Common/Instrumentation.h"
+#include "../Common/MemoryResource.h"
+#include "../Common/ThreeWayCompare.h"
+
+template <typename Comparable, typename Compare = std::less<Comparable>, typename Instrumentation = NoInstrumentation>
 class BinarySearchTree
 {
 public:
     BinarySearchTree();                                // default constructor
+    explicit BinarySearchTree(std::pmr::memory_resource *resource); // nodes are allocated from resource, which must outlive the tree
+    explicit BinarySearchTree(const Compare &compare,                // values are ordered by compare
+                              std::pmr::memory_resource *resource = std::pmr::get_default_resource());
     BinarySearchTree(const BinarySearchTree &rhs);     // copy constructor
     BinarySearchTree(BinarySearchTree &&rhs) noexcept; // move constructor
     ~BinarySearchTree();                               // destructor
@@ -79,6 +94,10 @@ public:
      * @return true if empty, otherwise false.
      * */
     [[nodiscard]] bool isEmpty() const;
+    /**
+     * @return the memory resource the tree's nodes are allocated from.
+     * */
+    [[nodiscard]] std::pmr::memory_resource *getMemoryResource() const;
     /**
      * @brief prints the tree.
      * */
@@ -119,13 +138,15 @@ private:
     };
 
     BinaryNode *root;
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource();
+    Compare compare;
 
     /* Constant Private Methods */
 
     BinaryNode *findMin(BinaryNode *node) const;
     BinaryNode *findMax(BinaryNode *node) const;
     BinaryNode *clone(BinaryNode *treeRoot) const;
-    bool contains(BinarySearchTree::BinaryNode *node, Comparable value) const;
+    bool contains(BinarySearchTree::BinaryNode *node, const Comparable &value) const;
     void printTree(BinaryNode *treeRoot, int depth) const;
 
     /* Non-Constant Private Methods */
@@ -142,30 +163,45 @@ private:
 /* region */
 
 /* Default constructor */
-template <typename Comparable>
-BinarySearchTree<Comparable>::BinarySearchTree()
+template <typename Comparable, typename Compare, typename Instrumentation>
+BinarySearchTree<Comparable, Compare, Instrumentation>::BinarySearchTree()
+{
+    root = nullptr;
+}
+
+template <typename Comparable, typename Compare, typename Instrumentation>
+BinarySearchTree<Comparable, Compare, Instrumentation>::BinarySearchTree(std::pmr::memory_resource *resource) : resource(resource)
+{
+    root = nullptr;
+}
+
+template <typename Comparable, typename Compare, typename Instrumentation>
+BinarySearchTree<Comparable, Compare, Instrumentation>::BinarySearchTree(const Compare &compare, std::pmr::memory_resource *resource)
+    : resource(resource), compare(compare)
 {
     root = nullptr;
 }
 
 /* Copy Constructor */
-template <typename Comparable>
-BinarySearchTree<Comparable>::BinarySearchTree(const BinarySearchTree &rhs)
+template <typename Comparable, typename Compare, typename Instrumentation>
+BinarySearchTree<Comparable, Compare, Instrumentation>::BinarySearchTree(const BinarySearchTree &rhs) : compare(rhs.compare)
 {
     root = clone(rhs.root);
 }
 
 /* Move Constructor */
-template <typename Comparable>
-BinarySearchTree<Comparable>::BinarySearchTree(BinarySearchTree &&rhs) noexcept
+template <typename Comparable, typename Compare, typename Instrumentation>
+BinarySearchTree<Comparable, Compare, Instrumentation>::BinarySearchTree(BinarySearchTree &&rhs) noexcept
 {
     root = rhs.root;
+    resource = rhs.resource;
+    compare = rhs.compare;
     rhs.root = nullptr;
 }
 
 /* Destructor */
-template <typename Comparable>
-BinarySearchTree<Comparable>::~BinarySearchTree()
+template <typename Comparable, typename Compare, typename Instrumentation>
+BinarySearchTree<Comparable, Compare, Instrumentation>::~BinarySearchTree()
 {
     makeEmpty();
 }
@@ -174,90 +210,97 @@ BinarySearchTree<Comparable>::~BinarySearchTree()
 
 /* Public Constant Methods  */
 /* region */
-template <typename Comparable>
-const Comparable &BinarySearchTree<Comparable>::findMin() const
+template <typename Comparable, typename Compare, typename Instrumentation>
+const Comparable &BinarySearchTree<Comparable, Compare, Instrumentation>::findMin() const
 {
     return findMin(root);
 };
 
-template <typename Comparable>
-const Comparable &BinarySearchTree<Comparable>::findMax() const
+template <typename Comparable, typename Compare, typename Instrumentation>
+const Comparable &BinarySearchTree<Comparable, Compare, Instrumentation>::findMax() const
 {
     return findMax(root);
 };
 
-template <typename Comparable>
-bool BinarySearchTree<Comparable>::contains(const Comparable &value) const
+template <typename Comparable, typename Compare, typename Instrumentation>
+bool BinarySearchTree<Comparable, Compare, Instrumentation>::contains(const Comparable &value) const
 {
     return contains(root, value);
 }
-template <typename Comparable>
-bool BinarySearchTree<Comparable>::contains(Comparable &&value) const
+template <typename Comparable, typename Compare, typename Instrumentation>
+bool BinarySearchTree<Comparable, Compare, Instrumentation>::contains(Comparable &&value) const
 {
     return contains(root, std::move(value));
 }
 
-template <typename Comparable>
-bool BinarySearchTree<Comparable>::isEmpty() const
+template <typename Comparable, typename Compare, typename Instrumentation>
+bool BinarySearchTree<Comparable, Compare, Instrumentation>::isEmpty() const
 {
     return root == nullptr;
 }
 
-template <typename Comparable>
-void BinarySearchTree<Comparable>::printTree() const
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::printTree() const
 {
     printTree(root, 0);
 }
+
+template <typename Comparable, typename Compare, typename Instrumentation>
+std::pmr::memory_resource *BinarySearchTree<Comparable, Compare, Instrumentation>::getMemoryResource() const
+{
+    return resource;
+}
 /* endregion */
 
 /* Public Non-Constant Methods */
 /* region */
 
-template <typename Comparable>
-void BinarySearchTree<Comparable>::makeEmpty()
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::makeEmpty()
 {
     makeEmpty(root);
 }
 
-template <typename Comparable>
-void BinarySearchTree<Comparable>::insert(const Comparable &value)
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::insert(const Comparable &value)
 {
     insert(value, root);
 }
 
-template <typename Comparable>
-void BinarySearchTree<Comparable>::insert(Comparable &&value)
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::insert(Comparable &&value)
 {
     insert(value, root);
 }
 
-template <typename Comparable>
-void BinarySearchTree<Comparable>::remove(const Comparable &value)
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::remove(const Comparable &value)
 {
     remove(value, root);
 }
 
-template <typename Comparable>
-void BinarySearchTree<Comparable>::remove(Comparable &&value)
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::remove(Comparable &&value)
 {
     remove(value, root);
 }
 
-template <typename Comparable>
-BinarySearchTree<Comparable> &BinarySearchTree<Comparable>::operator=(const BinarySearchTree &rhs)
+template <typename Comparable, typename Compare, typename Instrumentation>
+BinarySearchTree<Comparable, Compare, Instrumentation> &BinarySearchTree<Comparable, Compare, Instrumentation>::operator=(const BinarySearchTree &rhs)
 {
     if (this != &rhs)
     {
         // Clear the current tree
         makeEmpty(root);
         // Perform deep copy
+        compare = rhs.compare;
         root = clone(rhs.root);
     }
     return *this;
 }
 
-template <typename Comparable>
-BinarySearchTree<Comparable> &BinarySearchTree<Comparable>::operator=(BinarySearchTree &&rhs) noexcept
+template <typename Comparable, typename Compare, typename Instrumentation>
+BinarySearchTree<Comparable, Compare, Instrumentation> &BinarySearchTree<Comparable, Compare, Instrumentation>::operator=(BinarySearchTree &&rhs) noexcept
 {
     if (this != &rhs)
     {
@@ -265,6 +308,8 @@ BinarySearchTree<Comparable> &BinarySearchTree<Comparable>::operator=(BinarySear
         makeEmpty();
         // Move ownership of resources
         root = std::exchange(rhs.root, nullptr);
+        resource = rhs.resource;
+        compare = rhs.compare;
     }
     return *this;
 }
@@ -274,8 +319,8 @@ BinarySearchTree<Comparable> &BinarySearchTree<Comparable>::operator=(BinarySear
 /* Private Constant Members */
 /* region */
 
-template <typename Comparable>
-typename BinarySearchTree<Comparable>::BinaryNode *BinarySearchTree<Comparable>::findMin(BinarySearchTree::BinaryNode *node) const
+template <typename Comparable, typename Compare, typename Instrumentation>
+typename BinarySearchTree<Comparable, Compare, Instrumentation>::BinaryNode *BinarySearchTree<Comparable, Compare, Instrumentation>::findMin(BinarySearchTree::BinaryNode *node) const
 {
     if (!node->left)
         return node;
@@ -283,8 +328,8 @@ typename BinarySearchTree<Comparable>::BinaryNode *BinarySearchTree<Comparable>:
     return findMin(node->left);
 }
 
-template <typename Comparable>
-typename BinarySearchTree<Comparable>::BinaryNode *BinarySearchTree<Comparable>::findMax(BinarySearchTree::BinaryNode *node) const
+template <typename Comparable, typename Compare, typename Instrumentation>
+typename BinarySearchTree<Comparable, Compare, Instrumentation>::BinaryNode *BinarySearchTree<Comparable, Compare, Instrumentation>::findMax(BinarySearchTree::BinaryNode *node) const
 {
     if (!node->right)
         return node;
@@ -292,35 +337,39 @@ typename BinarySearchTree<Comparable>::BinaryNode *BinarySearchTree<Comparable>:
     return findMax(node->right);
 }
 
-template <typename Comparable>
-typename BinarySearchTree<Comparable>::BinaryNode *BinarySearchTree<Comparable>::clone(BinarySearchTree::BinaryNode *treeRoot) const
+template <typename Comparable, typename Compare, typename Instrumentation>
+typename BinarySearchTree<Comparable, Compare, Instrumentation>::BinaryNode *BinarySearchTree<Comparable, Compare, Instrumentation>::clone(BinarySearchTree::BinaryNode *treeRoot) const
 {
     if (!treeRoot)
         return nullptr;
 
-    auto node = new BinaryNode(treeRoot->value); // Copy the value of treeRoot to a new node.
+    Instrumentation::onAllocate(sizeof(BinaryNode));
+    auto node = newNode<BinaryNode>(resource, treeRoot->value); // Copy the value of treeRoot to a new node.
     node->right = clone(treeRoot->right);        // Recursively clone the right subtree.
     node->left = clone(treeRoot->left);          // Recursively clone the left subtree.
 
     return node;
 }
 
-template <typename Comparable>
-bool BinarySearchTree<Comparable>::contains(BinarySearchTree::BinaryNode *node, Comparable value) const
+template <typename Comparable, typename Compare, typename Instrumentation>
+bool BinarySearchTree<Comparable, Compare, Instrumentation>::contains(BinarySearchTree::BinaryNode *node, const Comparable &value) const
 {
     if (!node)
         return false;
-    if (value > node->value)
+    Instrumentation::onVisit();
+
+    int order = threeWayCompare<Instrumentation>(compare, value, node->value);
+    if (order > 0)
         return contains(node->right, value);
-    if (value < node->value)
+    if (order < 0)
         return contains(node->left, value);
 
     // value found
     return true;
 }
 
-template <typename Comparable>
-void BinarySearchTree<Comparable>::printTree(BinaryNode *treeRoot, int depth) const
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::printTree(BinaryNode *treeRoot, int depth) const
 {
     if (!treeRoot)
         return;
@@ -340,22 +389,26 @@ void BinarySearchTree<Comparable>::printTree(BinaryNode *treeRoot, int depth) co
 
 
 //
-template <typename Comparable>
-void BinarySearchTree<Comparable>::insert(const Comparable &value, BinarySearchTree::BinaryNode *&treeRoot)
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::insert(const Comparable &value, BinarySearchTree::BinaryNode *&treeRoot)
 {
     // insert the value in place
     if (!treeRoot)
     {
-        treeRoot = new BinaryNode(value);
+        Instrumentation::onAllocate(sizeof(BinaryNode));
+        treeRoot = newNode<BinaryNode>(resource, value);
         return;
     }
+    Instrumentation::onVisit();
+
+    int order = threeWayCompare<Instrumentation>(compare, value, treeRoot->value);
 
     // if value is greater than current node, insert to the right subtree
-    if (value > treeRoot->value)
+    if (order > 0)
         insert(value, treeRoot->right);
 
     // if value is less than current node, insert to the left subtree
-    else if (value < treeRoot->value)
+    else if (order < 0)
         insert(value, treeRoot->left);
 
     else
@@ -365,21 +418,22 @@ void BinarySearchTree<Comparable>::insert(const Comparable &value, BinarySearchT
     }
 }
 
-template <typename Comparable>
-void BinarySearchTree<Comparable>::insert(Comparable &&value, BinarySearchTree::BinaryNode *&tree)
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::insert(Comparable &&value, BinarySearchTree::BinaryNode *&tree)
 {
     insert(std::move(value), tree); // Move the value into the original insert function.
 }
 
-template <typename Comparable>
-void BinarySearchTree<Comparable>::removeNode(BinarySearchTree<Comparable>::BinaryNode *&node)
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::removeNode(BinarySearchTree<Comparable, Compare, Instrumentation>::BinaryNode *&node)
 {
     // Node is a isLeaf Node
     // Just delete it's content and set the pointer to nullptr
     bool isLeaf = node->left == nullptr && node->right == nullptr;
     if (isLeaf)
     {
-        delete node;
+        Instrumentation::onDeallocate(sizeof(BinaryNode));
+        deleteNode(resource, node);
         node = nullptr;
         return;
     }
@@ -401,35 +455,40 @@ void BinarySearchTree<Comparable>::removeNode(BinarySearchTree<Comparable>::Bina
         if (node->left)
         {
             auto initialLeft = node->left;
-            delete node;
+            Instrumentation::onDeallocate(sizeof(BinaryNode));
+            deleteNode(resource, node);
             node = initialLeft;
         }
         else if (node->right)
         {
             auto initialRight = node->right;
-            delete node;
+            Instrumentation::onDeallocate(sizeof(BinaryNode));
+            deleteNode(resource, node);
             node = initialRight;
         }
     }
 }
 
-template <typename Comparable>
-void BinarySearchTree<Comparable>::remove(const Comparable &value, BinarySearchTree::BinaryNode *&node)
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::remove(const Comparable &value, BinarySearchTree::BinaryNode *&node)
 {
     if (node == nullptr)
     {
         // Node with the given value not found in the tree.
         return;
     }
+    Instrumentation::onVisit();
+
+    int order = threeWayCompare<Instrumentation>(compare, value, node->value);
 
     // Node with the given value should be in the left subtree
-    if (value < node->value)
+    if (order < 0)
     {
         remove(value, node->left);
 
         // Node with the given value should be in the right subtree
     }
-    else if (value > node->value)
+    else if (order > 0)
     {
         remove(value, node->right);
 
@@ -441,8 +500,8 @@ void BinarySearchTree<Comparable>::remove(const Comparable &value, BinarySearchT
     }
 }
 
-template <typename Comparable>
-void BinarySearchTree<Comparable>::makeEmpty(BinarySearchTree::BinaryNode *&node)
+template <typename Comparable, typename Compare, typename Instrumentation>
+void BinarySearchTree<Comparable, Compare, Instrumentation>::makeEmpty(BinarySearchTree::BinaryNode *&node)
 {
     if (!node)
         return;
@@ -452,7 +511,8 @@ void BinarySearchTree<Comparable>::makeEmpty(BinarySearchTree::BinaryNode *&node
     makeEmpty(node->left);
 
     // Delete the node content
-    delete (node);
+    Instrumentation::onDeallocate(sizeof(BinaryNode));
+    deleteNode(resource, node);
     node = nullptr;
 }
 
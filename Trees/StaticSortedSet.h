@@ -0,0 +1,112 @@
+// StaticSortedSet.h
+//
+// StaticSortedSet - An immutable sorted set that can be built at compile time.
+// For fixed sets of values (reserved words, opcodes, ...) it replaces an AVLTree filled at startup:
+// declared constexpr, the values are sorted by the compiler and stored in a plain array in read only data,
+// with no startup cost, no allocation and no pointer chasing. Lookups are binary searches.
+//
+// Usage example:
+// --------------
+// constexpr auto reserved = makeStaticSortedSet<std::string_view>({"while", "if", "for", "else"});
+// static_assert(reserved.contains("for"));
+// static_assert(reserved[0] == "else");
+//
+// Note: Values are ordered by the Compare policy (std::less by default), which must be usable
+// in constant expressions, as must the values' copy assignment.
+//
+// Created by Mahmoud Ashraf on 10/18/2026.
+
+#ifndef DSA_STATICSORTEDSET_H
+#define DSA_STATICSORTEDSET_H
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+
+template <typename Comparable, std::size_t N, typename Compare = std::less<Comparable>>
+class StaticSortedSet {
+public:
+    /**
+     * @brief Sorts the values, meant to be evaluated at compile time.
+     * @param values The values of the set.
+     * @throws std::invalid_argument If a value appears twice (a compile error when constexpr).
+     */
+    constexpr explicit StaticSortedSet(const Comparable (&values)[N]);
+
+    /**
+     * @brief searches the set for a value.
+     * @return true if found, otherwise false.
+     * */
+    constexpr bool contains(const Comparable& value) const;
+
+    /**
+     * @return index of the first value not ordered before the given value, size() if there is none.
+     * */
+    constexpr std::size_t lowerBound(const Comparable& value) const;
+
+    /**
+     * @return the value at the given position of the sorted order.
+     * */
+    constexpr const Comparable& operator[](std::size_t index) const { return values[index]; }
+
+    [[nodiscard]] static constexpr std::size_t size() { return N; }
+
+    constexpr auto begin() const { return values.begin(); }
+    constexpr auto end() const { return values.end(); }
+
+private:
+    std::array<Comparable, N> values{};
+    Compare compare{};
+};
+
+/**
+ * @brief Deduces the size of a StaticSortedSet, e.g. makeStaticSortedSet<int>({3, 1, 2}).
+ */
+template <typename Comparable, typename Compare = std::less<Comparable>, std::size_t N>
+constexpr StaticSortedSet<Comparable, N, Compare> makeStaticSortedSet(const Comparable (&values)[N]) {
+    return StaticSortedSet<Comparable, N, Compare>(values);
+}
+
+template <typename Comparable, std::size_t N, typename Compare>
+constexpr StaticSortedSet<Comparable, N, Compare>::StaticSortedSet(const Comparable (&values)[N]) {
+    // Insertion sort, std::sort isn't constexpr before C++20
+    for (std::size_t i = 0; i < N; ++i) {
+        Comparable value = values[i];
+        std::size_t position = i;
+        while (position > 0 && compare(value, this->values[position - 1])) {
+            this->values[position] = this->values[position - 1];
+            position--;
+        }
+        this->values[position] = value;
+    }
+
+    for (std::size_t i = 1; i < N; ++i)
+        if (!compare(this->values[i - 1], this->values[i]))
+            throw std::invalid_argument("Duplicate value in static sorted set.");
+}
+
+template <typename Comparable, std::size_t N, typename Compare>
+constexpr std::size_t StaticSortedSet<Comparable, N, Compare>::lowerBound(const Comparable& value) const {
+    // One comparison per halving step
+    std::size_t first = 0;
+    std::size_t count = N;
+    while (count > 0) {
+        std::size_t half = count / 2;
+        if (compare(values[first + half], value)) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+template <typename Comparable, std::size_t N, typename Compare>
+constexpr bool StaticSortedSet<Comparable, N, Compare>::contains(const Comparable& value) const {
+    std::size_t index = lowerBound(value);
+    return index < N && !compare(value, values[index]);
+}
+
+#endif //DSA_STATICSORTEDSET_H
@@ -0,0 +1,635 @@
+/**
+ * @file HashArrayMappedTrie.h
+ * @brief Declaration and implementation of the HashArrayMappedTrie class, a persistent (immutable) hash map.
+ *
+ * A hash array mapped trie is a trie over the bits of the keys' hashes: a node consumes 5 bits and has
+ * up to 32 slots, each holding an entry, a child node, or nothing. The node only stores its used slots,
+ * found from two 32 bit maps (the slots holding an entry, the slots holding a child) by counting the
+ * bits set below the slot's bit. With 64 bit hashes a lookup visits at most 13 nodes, about log32(n)
+ * in practice; keys with equal 64 bit hashes share a collision node below the last level.
+ *
+ * Maps are never modified: insert() and remove() return a new version, which copies the nodes on the
+ * path to the key and shares every other node with the previous version. Copying a map is O(1) and
+ * versions can be kept and read from any thread, the nodes being reference counted atomically.
+ *
+ * A Transient batches many updates: its nodes are owned by the batch, so once a node has been copied
+ * by the first update it is modified in place by the following ones, without copying the path again.
+ * persistent() ends the batch and returns the result as a map, sharing its nodes with the maps the
+ * batch started from.
+ *
+ * Removals keep the trie canonical: a node left with a single entry and no child is replaced by that
+ * entry in its parent, so the shape only depends on the keys, not on the history of updates.
+ *
+ * The Instrumentation policy (see Common/Instrumentation.h) is notified of node allocations,
+ * node visits and key comparisons.
+ *
+ * Usage example:
+ * --------------
+ * HashArrayMappedTrie<std::string, int> empty;
+ * auto first = empty.insert("timeout", 30);
+ * auto second = first.insert("retries", 3);   // first is unchanged
+ * second.get("timeout"); // 30
+ *
+ * auto batch = second.transient();
+ * for (auto& [key, value] : overrides) batch.insert(key, value);
+ * auto third = batch.persistent();
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_HASHARRAYMAPPEDTRIE_H
+#define DSA_HASHARRAYMAPPEDTRIE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "../Common/Instrumentation.h"
+#include "../Hashing/SeededHash.h"
+
+template<typename Key, typename Value, typename Instrumentation = NoInstrumentation>
+class HashArrayMappedTrie {
+    struct Node;
+
+public:
+    class Transient;
+
+    /*region Big Five & Other Constructors*/
+
+    // Default Constructor
+    HashArrayMappedTrie() = default;
+
+    // Destructor
+    ~HashArrayMappedTrie() { release(root); }
+
+    /**
+     * @brief Copy Constructor, O(1): the copy shares every node.
+     */
+    HashArrayMappedTrie(const HashArrayMappedTrie& other) : root(acquire(other.root)), count(other.count) {}
+
+    HashArrayMappedTrie(HashArrayMappedTrie&& other) noexcept : root(other.root), count(other.count) {
+        other.root = nullptr;
+        other.count = 0;
+    }
+
+    HashArrayMappedTrie& operator=(const HashArrayMappedTrie& other);
+
+    HashArrayMappedTrie& operator=(HashArrayMappedTrie&& other) noexcept;
+
+    /*endregion*/
+
+    /*region Constant Methods */
+
+    /**
+     * @return pointer to the value associated with the key, or null if the key is missing.
+     */
+    const Value* find(const Key& key) const { return lookup(root, key); }
+
+    /**
+     * @return the value associated with the key.
+     * @throws std::runtime_error If the key is missing.
+     */
+    const Value& get(const Key& key) const;
+
+    bool contains(const Key& key) const { return find(key) != nullptr; }
+
+    [[nodiscard]] std::size_t size() const { return count; }
+
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+    /**
+     * @return a new version with the key associated with the value, added or replaced.
+     */
+    [[nodiscard]] HashArrayMappedTrie insert(const Key& key, const Value& value) const;
+
+    /**
+     * @return a new version without the key, sharing every node with this one if the key is missing.
+     */
+    [[nodiscard]] HashArrayMappedTrie remove(const Key& key) const;
+
+    /**
+     * @return a batch of updates starting from this version.
+     */
+    [[nodiscard]] Transient transient() const { return Transient(acquire(root), count); }
+
+    /**
+     * @brief Calls function(key, value) for every entry, in no particular order.
+     */
+    template<typename Function>
+    void forEach(Function function) const { visit(root, function); }
+
+    /*endregion*/
+
+private:
+    static constexpr int BITS = 5;
+    static constexpr int HASH_BITS = 64;  // Nodes at this depth and below are collision nodes
+    static constexpr std::uint32_t MASK = (1u << BITS) - 1;
+
+    struct Entry {
+        std::uint64_t hash;
+        Key key;
+        Value value;
+    };
+
+    Node* root = nullptr;
+    std::size_t count = 0;
+
+    HashArrayMappedTrie(Node* root, std::size_t count) : root(root), count(count) {}
+
+    static std::uint64_t hashOf(const Key& key) {
+        return seededHash(static_cast<std::uint64_t>(std::hash<Key>{}(key)), 0);
+    }
+
+    static int rank(std::uint32_t map, std::uint32_t bit) { return popCount(map & (bit - 1)); }
+
+    static int popCount(std::uint32_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcount(word);
+#else
+        int count = 0;
+        for (; word; word &= word - 1) count++;
+        return count;
+#endif
+    }
+
+    /**
+     * @return a token owning the nodes created by one update, or by one transient.
+     */
+    static std::uint64_t newEditor() {
+        static std::atomic<std::uint64_t> editors{0};
+        return editors.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    static Node* acquire(Node* node);
+
+    static void release(Node* node);
+
+    static const Value* lookup(const Node* node, const Key& key);
+
+    template<typename Function>
+    static void visit(const Node* node, Function& function);
+
+    /**
+     * @brief Returns the node made editable by the editor, copying it if another editor owns it.
+     * Like every function taking a node and returning its replacement, it takes over the caller's reference.
+     */
+    static Node* editable(Node* node, std::uint64_t editor);
+
+    /**
+     * @brief Builds a copy of a node with an entry and/or a child removed and/or added.
+     *
+     * The node's entries and children are moved if the editor owns it, copied otherwise.
+     * The caller takes over the reference of the removed child, and entry is moved from.
+     * An index of -1 means nothing is removed or added.
+     */
+    static Node* rebuild(Node* node, std::uint64_t editor, std::uint32_t dataMap, std::uint32_t nodeMap,
+                         int removedEntry, int addedEntry, Entry* entry, int removedChild, int addedChild, Node* child);
+
+    /**
+     * @return a node holding two entries with different keys, at the depth of shift.
+     */
+    static Node* pair(int shift, Entry&& first, Entry&& second, std::uint64_t editor);
+
+    static Node* insert(Node* node, int shift, Entry&& entry, std::uint64_t editor, bool& added);
+
+    /**
+     * @brief Removes a key known to be present.
+     */
+    static Node* remove(Node* node, int shift, std::uint64_t hash, const Key& key, std::uint64_t editor);
+
+    static Node* insertInto(Node* root, const Key& key, const Value& value, std::uint64_t editor, bool& added);
+
+    static Node* removeFrom(Node* root, const Key& key, std::uint64_t editor);
+};
+
+/*region Node */
+
+/**
+ * @brief A node and its arrays, in a single allocation: the header, the children, then the entries.
+ */
+template<typename Key, typename Value, typename Instrumentation>
+struct HashArrayMappedTrie<Key, Value, Instrumentation>::Node {
+    std::atomic<std::uint32_t> references{1};
+    std::uint32_t dataMap;          // Slots holding an entry, unused by collision nodes
+    std::uint32_t nodeMap;          // Slots holding a child
+    std::uint32_t entriesCount;
+    std::uint32_t childrenCount;
+    std::uint64_t editor;           // Token of the update or transient allowed to modify the node in place
+
+    Node(std::uint32_t dataMap, std::uint32_t nodeMap, std::uint32_t entriesCount, std::uint32_t childrenCount,
+         std::uint64_t editor)
+            : dataMap(dataMap), nodeMap(nodeMap), entriesCount(entriesCount), childrenCount(childrenCount), editor(editor) {}
+
+    Node** children() { return reinterpret_cast<Node**>(reinterpret_cast<char*>(this) + childrenOffset()); }
+
+    Entry* entries() { return reinterpret_cast<Entry*>(reinterpret_cast<char*>(this) + entriesOffset(childrenCount)); }
+
+    const Node* const* children() const { return const_cast<Node*>(this)->children(); }
+
+    const Entry* entries() const { return const_cast<Node*>(this)->entries(); }
+
+    static std::size_t bytes(std::uint32_t entriesCount, std::uint32_t childrenCount) {
+        return entriesOffset(childrenCount) + entriesCount * sizeof(Entry);
+    }
+
+    /**
+     * @return a node with unconstructed entries and children.
+     */
+    static Node* allocate(std::uint32_t dataMap, std::uint32_t nodeMap, std::uint32_t entriesCount,
+                          std::uint32_t childrenCount, std::uint64_t editor) {
+        static_assert(alignof(Entry) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned entries aren't supported.");
+        auto size = bytes(entriesCount, childrenCount);
+        Instrumentation::onAllocate(size);
+        return new(::operator new(size)) Node(dataMap, nodeMap, entriesCount, childrenCount, editor);
+    }
+
+    /**
+     * @brief Destroys the entries and frees the node, leaving the children's references to the caller.
+     */
+    static void destroy(Node* node) {
+        Entry* entries = node->entries();
+        for (std::uint32_t i = 0; i < node->entriesCount; ++i) entries[i].~Entry();
+        Instrumentation::onDeallocate(bytes(node->entriesCount, node->childrenCount));
+        node->~Node();
+        ::operator delete(node);
+    }
+
+private:
+    static constexpr std::size_t childrenOffset() {
+        return (sizeof(Node) + alignof(Node*) - 1) / alignof(Node*) * alignof(Node*);
+    }
+
+    static std::size_t entriesOffset(std::uint32_t childrenCount) {
+        auto end = childrenOffset() + childrenCount * sizeof(Node*);
+        return (end + alignof(Entry) - 1) / alignof(Entry) * alignof(Entry);
+    }
+};
+
+/*endregion*/
+
+/*region Transient */
+
+/**
+ * @brief A batch of updates, modifying the nodes it created in place. Not thread-safe.
+ */
+template<typename Key, typename Value, typename Instrumentation>
+class HashArrayMappedTrie<Key, Value, Instrumentation>::Transient {
+public:
+    ~Transient() { release(root); }
+
+    Transient(Transient&& other) noexcept : root(other.root), count(other.count), editor(other.editor) {
+        other.root = nullptr;
+        other.editor = 0;
+    }
+
+    Transient(const Transient& other) = delete;
+    Transient& operator=(const Transient& other) = delete;
+    Transient& operator=(Transient&& other) = delete;
+
+    const Value* find(const Key& key) const { return lookup(root, key); }
+
+    bool contains(const Key& key) const { return find(key) != nullptr; }
+
+    [[nodiscard]] std::size_t size() const { return count; }
+
+    /**
+     * @throws std::logic_error If persistent() was called.
+     */
+    void insert(const Key& key, const Value& value) {
+        bool added;
+        root = insertInto(root, key, value, checkedEditor(), added);
+        if (added) count++;
+    }
+
+    /**
+     * @throws std::logic_error If persistent() was called.
+     */
+    void remove(const Key& key) {
+        auto current = checkedEditor();
+        if (!contains(key)) return;
+        root = removeFrom(root, key, current);
+        count--;
+    }
+
+    /**
+     * @brief Ends the batch, further updates throw.
+     * @return the map holding the updates.
+     */
+    HashArrayMappedTrie persistent() {
+        checkedEditor();
+        editor = 0;
+        Node* result = root;
+        root = nullptr;
+        return HashArrayMappedTrie(result, count);
+    }
+
+private:
+    friend class HashArrayMappedTrie;
+
+    Node* root;
+    std::size_t count;
+    std::uint64_t editor;
+
+    Transient(Node* root, std::size_t count) : root(root), count(count), editor(newEditor()) {}
+
+    std::uint64_t checkedEditor() const {
+        if (!editor) throw std::logic_error("The transient was made persistent already.");
+        return editor;
+    }
+};
+
+/*endregion*/
+
+/*region Big Five */
+
+template<typename Key, typename Value, typename Instrumentation>
+HashArrayMappedTrie<Key, Value, Instrumentation>&
+HashArrayMappedTrie<Key, Value, Instrumentation>::operator=(const HashArrayMappedTrie& other) {
+    if (this == &other) return *this;
+    Node* previous = root;
+    root = acquire(other.root);
+    count = other.count;
+    release(previous);
+    return *this;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+HashArrayMappedTrie<Key, Value, Instrumentation>&
+HashArrayMappedTrie<Key, Value, Instrumentation>::operator=(HashArrayMappedTrie&& other) noexcept {
+    if (this == &other) return *this;
+    release(root);
+    root = other.root;
+    count = other.count;
+    other.root = nullptr;
+    other.count = 0;
+    return *this;
+}
+
+/*endregion*/
+
+/*region Public Methods */
+
+template<typename Key, typename Value, typename Instrumentation>
+const Value& HashArrayMappedTrie<Key, Value, Instrumentation>::get(const Key& key) const {
+    const Value* value = find(key);
+    if (!value) throw std::runtime_error("key doesn't exist");
+    return *value;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+HashArrayMappedTrie<Key, Value, Instrumentation>
+HashArrayMappedTrie<Key, Value, Instrumentation>::insert(const Key& key, const Value& value) const {
+    bool added;
+    Node* result = insertInto(acquire(root), key, value, newEditor(), added);
+    return HashArrayMappedTrie(result, added ? count + 1 : count);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+HashArrayMappedTrie<Key, Value, Instrumentation>
+HashArrayMappedTrie<Key, Value, Instrumentation>::remove(const Key& key) const {
+    if (!contains(key)) return *this;
+    return HashArrayMappedTrie(removeFrom(acquire(root), key, newEditor()), count - 1);
+}
+
+/*endregion*/
+
+/*region Private Methods */
+
+template<typename Key, typename Value, typename Instrumentation>
+typename HashArrayMappedTrie<Key, Value, Instrumentation>::Node*
+HashArrayMappedTrie<Key, Value, Instrumentation>::acquire(Node* node) {
+    if (node) node->references.fetch_add(1, std::memory_order_relaxed);
+    return node;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+void HashArrayMappedTrie<Key, Value, Instrumentation>::release(Node* node) {
+    if (!node || node->references.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    Node** children = node->children();
+    for (std::uint32_t i = 0; i < node->childrenCount; ++i) release(children[i]);
+    Node::destroy(node);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+const Value* HashArrayMappedTrie<Key, Value, Instrumentation>::lookup(const Node* node, const Key& key) {
+    auto hash = hashOf(key);
+    for (int shift = 0; node; shift += BITS) {
+        Instrumentation::onVisit();
+        const Entry* entries = node->entries();
+        if (shift >= HASH_BITS) {
+            for (std::uint32_t i = 0; i < node->entriesCount; ++i) {
+                Instrumentation::onCompare();
+                if (entries[i].key == key) return &entries[i].value;
+            }
+            return nullptr;
+        }
+
+        std::uint32_t bit = 1u << ((hash >> shift) & MASK);
+        if (node->dataMap & bit) {
+            const Entry& entry = entries[rank(node->dataMap, bit)];
+            if (entry.hash != hash) return nullptr;
+            Instrumentation::onCompare();
+            return entry.key == key ? &entry.value : nullptr;
+        }
+        node = node->nodeMap & bit ? node->children()[rank(node->nodeMap, bit)] : nullptr;
+    }
+    return nullptr;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+template<typename Function>
+void HashArrayMappedTrie<Key, Value, Instrumentation>::visit(const Node* node, Function& function) {
+    if (!node) return;
+    const Entry* entries = node->entries();
+    for (std::uint32_t i = 0; i < node->entriesCount; ++i) function(entries[i].key, entries[i].value);
+    const Node* const* children = node->children();
+    for (std::uint32_t i = 0; i < node->childrenCount; ++i) visit(children[i], function);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+typename HashArrayMappedTrie<Key, Value, Instrumentation>::Node*
+HashArrayMappedTrie<Key, Value, Instrumentation>::editable(Node* node, std::uint64_t editor) {
+    if (node->editor == editor) return node;
+    return rebuild(node, editor, node->dataMap, node->nodeMap, -1, -1, nullptr, -1, -1, nullptr);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+typename HashArrayMappedTrie<Key, Value, Instrumentation>::Node*
+HashArrayMappedTrie<Key, Value, Instrumentation>::rebuild(Node* node, std::uint64_t editor, std::uint32_t dataMap,
+                                                         std::uint32_t nodeMap, int removedEntry, int addedEntry,
+                                                         Entry* entry, int removedChild, int addedChild, Node* child) {
+    // A node owned by the editor is referenced by its parent only, its contents can be moved
+    bool owned = node->editor == editor;
+    auto entriesCount = node->entriesCount - (removedEntry >= 0) + (addedEntry >= 0);
+    auto childrenCount = node->childrenCount - (removedChild >= 0) + (addedChild >= 0);
+    Node* result = Node::allocate(dataMap, nodeMap, entriesCount, childrenCount, editor);
+
+    Node** sourceChildren = node->children();
+    Node** children = result->children();
+    if (removedChild >= 0 && !owned) acquire(sourceChildren[removedChild]);
+    for (std::uint32_t i = 0, source = 0; i < childrenCount; ++i) {
+        if (static_cast<int>(i) == addedChild) {
+            children[i] = child;
+            continue;
+        }
+        if (static_cast<int>(source) == removedChild) source++;
+        children[i] = owned ? sourceChildren[source] : acquire(sourceChildren[source]);
+        source++;
+    }
+
+    Entry* sourceEntries = node->entries();
+    Entry* entries = result->entries();
+    for (std::uint32_t i = 0, source = 0; i < entriesCount; ++i) {
+        if (static_cast<int>(i) == addedEntry) {
+            new(&entries[i]) Entry(std::move(*entry));
+            continue;
+        }
+        if (static_cast<int>(source) == removedEntry) source++;
+        if (owned) new(&entries[i]) Entry(std::move(sourceEntries[source]));
+        else new(&entries[i]) Entry(sourceEntries[source]);
+        source++;
+    }
+
+    if (owned) Node::destroy(node);
+    else release(node);
+    return result;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+typename HashArrayMappedTrie<Key, Value, Instrumentation>::Node*
+HashArrayMappedTrie<Key, Value, Instrumentation>::pair(int shift, Entry&& first, Entry&& second, std::uint64_t editor) {
+    if (shift >= HASH_BITS) {
+        Node* node = Node::allocate(0, 0, 2, 0, editor);
+        new(&node->entries()[0]) Entry(std::move(first));
+        new(&node->entries()[1]) Entry(std::move(second));
+        return node;
+    }
+
+    auto firstSlot = (first.hash >> shift) & MASK, secondSlot = (second.hash >> shift) & MASK;
+    if (firstSlot == secondSlot) {
+        Node* node = Node::allocate(0, 1u << firstSlot, 0, 1, editor);
+        node->children()[0] = pair(shift + BITS, std::move(first), std::move(second), editor);
+        return node;
+    }
+
+    Node* node = Node::allocate((1u << firstSlot) | (1u << secondSlot), 0, 2, 0, editor);
+    bool firstBelow = firstSlot < secondSlot;
+    new(&node->entries()[firstBelow ? 0 : 1]) Entry(std::move(first));
+    new(&node->entries()[firstBelow ? 1 : 0]) Entry(std::move(second));
+    return node;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+typename HashArrayMappedTrie<Key, Value, Instrumentation>::Node*
+HashArrayMappedTrie<Key, Value, Instrumentation>::insert(Node* node, int shift, Entry&& entry, std::uint64_t editor,
+                                                        bool& added) {
+    Instrumentation::onVisit();
+    if (shift >= HASH_BITS) {
+        for (std::uint32_t i = 0; i < node->entriesCount; ++i) {
+            Instrumentation::onCompare();
+            if (node->entries()[i].key == entry.key) {
+                node = editable(node, editor);
+                node->entries()[i].value = std::move(entry.value);
+                added = false;
+                return node;
+            }
+        }
+        added = true;
+        return rebuild(node, editor, 0, 0, -1, static_cast<int>(node->entriesCount), &entry, -1, -1, nullptr);
+    }
+
+    std::uint32_t bit = 1u << ((entry.hash >> shift) & MASK);
+    if (node->dataMap & bit) {
+        int index = rank(node->dataMap, bit);
+        Entry& existing = node->entries()[index];
+        if (existing.hash == entry.hash) {
+            Instrumentation::onCompare();
+            if (existing.key == entry.key) {
+                node = editable(node, editor);
+                node->entries()[index].value = std::move(entry.value);
+                added = false;
+                return node;
+            }
+        }
+
+        // Both entries move down to a new child, the existing one is moved if the node is dropped anyway
+        Entry pushed = node->editor == editor ? std::move(existing) : existing;
+        Node* child = pair(shift + BITS, std::move(pushed), std::move(entry), editor);
+        added = true;
+        auto nodeMap = node->nodeMap | bit;
+        return rebuild(node, editor, node->dataMap & ~bit, nodeMap, index, -1, nullptr, -1, rank(nodeMap, bit), child);
+    }
+
+    if (node->nodeMap & bit) {
+        node = editable(node, editor);
+        Node*& child = node->children()[rank(node->nodeMap, bit)];
+        child = insert(child, shift + BITS, std::move(entry), editor, added);
+        return node;
+    }
+
+    added = true;
+    auto dataMap = node->dataMap | bit;
+    return rebuild(node, editor, dataMap, node->nodeMap, -1, rank(dataMap, bit), &entry, -1, -1, nullptr);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+typename HashArrayMappedTrie<Key, Value, Instrumentation>::Node*
+HashArrayMappedTrie<Key, Value, Instrumentation>::remove(Node* node, int shift, std::uint64_t hash, const Key& key,
+                                                        std::uint64_t editor) {
+    Instrumentation::onVisit();
+    if (shift >= HASH_BITS) {
+        int index = 0;
+        while (!(node->entries()[index].key == key)) index++;
+        return rebuild(node, editor, 0, 0, index, -1, nullptr, -1, -1, nullptr);
+    }
+
+    std::uint32_t bit = 1u << ((hash >> shift) & MASK);
+    if (node->dataMap & bit)
+        return rebuild(node, editor, node->dataMap & ~bit, node->nodeMap, rank(node->dataMap, bit), -1, nullptr, -1, -1, nullptr);
+
+    node = editable(node, editor);
+    int index = rank(node->nodeMap, bit);
+    Node* child = remove(node->children()[index], shift + BITS, hash, key, editor);
+    node->children()[index] = child;
+    if (child->entriesCount != 1 || child->childrenCount != 0) return node;
+
+    // The child is down to one entry, which takes its slot (the trie stays canonical)
+    Entry last = child->editor == editor ? std::move(child->entries()[0]) : child->entries()[0];
+    auto dataMap = node->dataMap | bit;
+    node = rebuild(node, editor, dataMap, node->nodeMap & ~bit, -1, rank(dataMap, bit), &last, index, -1, nullptr);
+    release(child);
+    return node;
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+typename HashArrayMappedTrie<Key, Value, Instrumentation>::Node*
+HashArrayMappedTrie<Key, Value, Instrumentation>::insertInto(Node* root, const Key& key, const Value& value,
+                                                            std::uint64_t editor, bool& added) {
+    Entry entry{hashOf(key), key, value};
+    if (!root) {
+        added = true;
+        Node* node = Node::allocate(1u << (entry.hash & MASK), 0, 1, 0, editor);
+        new(&node->entries()[0]) Entry(std::move(entry));
+        return node;
+    }
+    return insert(root, 0, std::move(entry), editor, added);
+}
+
+template<typename Key, typename Value, typename Instrumentation>
+typename HashArrayMappedTrie<Key, Value, Instrumentation>::Node*
+HashArrayMappedTrie<Key, Value, Instrumentation>::removeFrom(Node* root, const Key& key, std::uint64_t editor) {
+    root = remove(root, 0, hashOf(key), key, editor);
+    if (root->entriesCount == 0 && root->childrenCount == 0) {
+        release(root);
+        return nullptr;
+    }
+    return root;
+}
+
+/*endregion*/
+
+#endif //DSA_HASHARRAYMAPPEDTRIE_H
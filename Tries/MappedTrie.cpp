@@ -0,0 +1,167 @@
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedTrie.h"
+#include "TrieImage.h"
+
+/*region PUBLIC */
+
+/* region Big Five */
+
+MappedTrie::MappedTrie(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) throw std::runtime_error("Couldn't open trie image " + path);
+
+    // Offsets in the image are 32 bits, a larger file can't be a valid image
+    struct stat fileStat{};
+    if(::fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t)sizeof(TrieImage::Header) ||
+       (std::uint64_t)fileStat.st_size > UINT32_MAX){
+        ::close(fd);
+        throw std::runtime_error("Invalid trie image " + path);
+    }
+
+    void* mapped = ::mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping stays valid after closing the descriptor
+    ::close(fd);
+    if(mapped == MAP_FAILED) throw std::runtime_error("Couldn't map trie image " + path);
+
+    image = static_cast<const char*>(mapped);
+    imageSize = (std::uint32_t)fileStat.st_size;
+
+    TrieImage::Header header{};
+    std::memcpy(&header, image, sizeof(header));
+    if(std::memcmp(header.magic, TrieImage::MAGIC, sizeof(header.magic)) != 0 ||
+       header.imageSize != imageSize || header.rootOffset < sizeof(header) ||
+       header.rootOffset + 4 > imageSize){
+        unmap();
+        throw std::runtime_error("Invalid trie image " + path);
+    }
+
+    rootOffset = header.rootOffset;
+}
+
+MappedTrie::MappedTrie(MappedTrie &&other) noexcept : image(std::exchange(other.image, nullptr)),
+                                                      imageSize(std::exchange(other.imageSize, 0)),
+                                                      rootOffset(std::exchange(other.rootOffset, NO_NODE)) {
+}
+
+MappedTrie::~MappedTrie() {
+    unmap();
+}
+
+MappedTrie &MappedTrie::operator=(MappedTrie &&other) noexcept {
+    if (this != &other) {
+        unmap();
+
+        image = std::exchange(other.image, nullptr);
+        imageSize = std::exchange(other.imageSize, 0);
+        rootOffset = std::exchange(other.rootOffset, NO_NODE);
+    }
+    return *this;
+}
+
+/*endregion*/
+
+/* region Public Constant Methods */
+
+std::vector<std::string> MappedTrie::getWords(const std::string &prefix) const {
+    std::vector<std::string> words;
+
+    auto node = getLastNode(prefix);
+    if(node != NO_NODE){
+        std::string s = prefix;
+        getWords(node, s, words);
+    }
+
+    return words;
+}
+
+bool MappedTrie::contains(const std::string &word) const {
+    auto node = getLastNode(word);
+    return node != NO_NODE && TrieImage::isWordEnd(TrieImage::read(image, node));
+}
+
+int MappedTrie::size() const {
+    if(!image) return 0;
+
+    TrieImage::Header header{};
+    std::memcpy(&header, image, sizeof(header));
+    return (int)header.wordCount;
+}
+
+int MappedTrie::nodeCount() const {
+    if(!image) return 0;
+
+    TrieImage::Header header{};
+    std::memcpy(&header, image, sizeof(header));
+    return (int)header.nodeCount;
+}
+
+/*endregion*/
+
+/*endregion PUBLIC*/
+
+/* region PRIVATE */
+
+std::uint32_t MappedTrie::getChildCount(std::uint32_t node) const {
+    auto childCount = TrieImage::childCount(TrieImage::read(image, node));
+    if((std::uint64_t)node + TrieImage::recordSize(childCount) > imageSize)
+        throw std::runtime_error("Corrupted trie image.");
+    return childCount;
+}
+
+std::uint32_t MappedTrie::getChild(std::uint32_t node, char ch) const {
+    auto childCount = getChildCount(node);
+
+    // Children characters are sorted, but tables are small enough for a linear scan
+    const char* chars = image + node + 4 + 4 * childCount;
+    for (std::uint32_t i = 0; i < childCount; ++i) {
+        if(chars[i] != ch) continue;
+
+        auto child = TrieImage::read(image, node + 4 + 4 * i);
+        if(child <= node || child % 4 != 0 || child + 4 > imageSize)
+            throw std::runtime_error("Corrupted trie image.");
+        return child;
+    }
+    return NO_NODE;
+}
+
+std::uint32_t MappedTrie::getLastNode(const std::string &word) const {
+    if(!image) return NO_NODE;
+
+    auto current = rootOffset;
+    for (char ch: word) {
+        current = getChild(current, ch);
+        if(current == NO_NODE) return NO_NODE;
+    }
+    return current;
+}
+
+void MappedTrie::getWords(std::uint32_t node, std::string &word, std::vector<std::string> &words) const {
+    auto info = TrieImage::read(image, node);
+    if(TrieImage::isWordEnd(info))
+        words.push_back(word);
+
+    auto childCount = getChildCount(node);
+    const char* chars = image + node + 4 + 4 * childCount;
+    for (std::uint32_t i = 0; i < childCount; ++i) {
+        word += chars[i];
+        getWords(getChild(node, chars[i]), word, words);
+        word.pop_back();
+    }
+}
+
+void MappedTrie::unmap() {
+    if(image) ::munmap(const_cast<char*>(image), imageSize);
+    image = nullptr;
+    imageSize = 0;
+}
+
+/* endregion */
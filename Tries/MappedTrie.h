@@ -0,0 +1,124 @@
+/**
+ * @file MappedTrie.h
+ * @brief Declaration of the MappedTrie class, a read-only trie queried in place from a memory mapped image.
+ *
+ * A MappedTrie maps a file written by Trie::save() and answers queries directly out of the
+ * mapped bytes, without building any node. Opening it is O(1) regardless of the trie size,
+ * and since the mapping is shared, processes opening the same file share its page cache.
+ *
+ * @note This class relies on POSIX mmap.
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_MAPPEDTRIE_H
+#define DSA_MAPPEDTRIE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+class MappedTrie {
+public:
+    /* region Big Five */
+
+    /**
+     * @brief Maps a trie image file.
+     *
+     * @param path The path of a file written by Trie::save().
+     * @throws std::runtime_error If the file can't be mapped or is not a valid trie image.
+     */
+    explicit MappedTrie(const std::string& path);
+
+    MappedTrie(const MappedTrie& other) = delete;
+    MappedTrie(MappedTrie&& other) noexcept; // Move constructor
+
+    ~MappedTrie(); // Destructor, unmaps the file
+
+    MappedTrie& operator=(const MappedTrie& other) = delete;
+    MappedTrie& operator=(MappedTrie&& other) noexcept; // Move Assignment Operator
+
+    /*endregion*/
+
+    /* region Public Constant Methods */
+
+    /**
+     * @brief Retrieves a vector of words that have the given prefix.
+     *
+     * @param prefix The prefix for which to retrieve words.
+     * @return A vector of words with the given prefix, in ascending order.
+     */
+    [[nodiscard]] std::vector<std::string> getWords(const std::string& prefix) const;
+
+    /**
+     * @brief Checks if a word exists in the trie.
+     *
+     * @param word word to check if exists
+     * @return true if the word exist, false otherwise.
+     * */
+    [[nodiscard]] bool contains(const std::string& word) const;
+
+    /**
+     * @return number of words in the trie
+     * */
+    [[nodiscard]] int size() const;
+
+    /**
+     * @return number of nodes in the trie, including the root
+     * */
+    [[nodiscard]] int nodeCount() const;
+
+    /*endregion*/
+
+private:
+    static constexpr std::uint32_t NO_NODE = 0;   // The header occupies offset 0, so no record can be there
+
+    const char* image = nullptr;
+    std::uint32_t imageSize = 0;
+    std::uint32_t rootOffset = NO_NODE;
+
+    /* region Private Constant Methods */
+
+    /**
+     * @brief Reads the children count of a node, checking that its whole record lies in the image.
+     *
+     * @param node The offset of the node's record.
+     * @throws std::runtime_error If the record runs past the end of the image.
+     */
+    [[nodiscard]] std::uint32_t getChildCount(std::uint32_t node) const;
+
+    /**
+     * @brief Gets the record offset of a node's child.
+     *
+     * @param node The offset of the parent node's record.
+     * @param ch The character of the child.
+     * @return The offset of the child's record, or NO_NODE if there is no such child.
+     */
+    [[nodiscard]] std::uint32_t getChild(std::uint32_t node, char ch) const;
+
+    /**
+     * @brief Retrieves the record offset of the last node of a given word.
+     *
+     * @return The offset of the node, or NO_NODE if the word is not a prefix in the trie.
+     */
+    [[nodiscard]] std::uint32_t getLastNode(const std::string& word) const;
+
+    /**
+     * @brief Recursively retrieves words from the sub-trie rooted at the given node.
+     *
+     * @param node The offset of the current node's record.
+     * @param word The current word formed during traversal.
+     * @param words The vector to store retrieved words.
+     */
+    void getWords(std::uint32_t node, std::string& word, std::vector<std::string>& words) const;
+
+    /*endregion*/
+
+    /**
+     * @brief Unmaps the image, if any.
+     */
+    void unmap();
+};
+
+#endif //DSA_MAPPEDTRIE_H
@@ -0,0 +1,202 @@
+/**
+ * @file StaticTrie.h
+ * @brief Immutable trie built at compile time from a fixed word list.
+ *
+ * For fixed vocabularies (keywords, command names, ...) a StaticTrie replaces inserting the words
+ * into a Trie at startup. Built by makeStaticTrie() in a constant expression, the nodes and edges
+ * are computed by the compiler and stored in flat arrays in read only data: no startup cost,
+ * no allocation, and a node's edges are contiguous.
+ *
+ * The number of nodes has to be known to size the arrays, so the word list is passed as a
+ * template argument referring to a constexpr array with static storage duration.
+ *
+ * Usage example:
+ * --------------
+ * static constexpr std::array<std::string_view, 3> keywords{"int", "if", "for"};
+ * constexpr auto keywordTrie = makeStaticTrie<keywords>();
+ * static_assert(keywordTrie.contains("if"));
+ * static_assert(keywordTrie.hasPrefix("fo"));
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_STATICTRIE_H
+#define DSA_STATICTRIE_H
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+namespace StaticTrieBuilder {
+    /**
+     * @return the words sorted (byte wise, as std::string_view compares them).
+     */
+    template<std::size_t N>
+    constexpr std::array<std::string_view, N> sorted(const std::array<std::string_view, N>& words) {
+        std::array<std::string_view, N> result{};
+        for (std::size_t i = 0; i < N; ++i) {
+            std::string_view word = words[i];
+            std::size_t position = i;
+            while (position > 0 && word < result[position - 1]) {
+                result[position] = result[position - 1];
+                position--;
+            }
+            result[position] = word;
+        }
+        return result;
+    }
+
+    /**
+     * @return the number of nodes of the trie of the words, the root included.
+     */
+    template<std::size_t N>
+    constexpr std::size_t nodesCount(const std::array<std::string_view, N>& words) {
+        auto sortedWords = sorted(words);
+
+        // Every word adds a node per character past its common prefix with the previous word
+        std::size_t count = 1;
+        for (std::size_t i = 0; i < N; ++i) {
+            std::size_t common = 0;
+            if (i > 0) {
+                const auto& previous = sortedWords[i - 1];
+                while (common < previous.size() && common < sortedWords[i].size()
+                       && previous[common] == sortedWords[i][common])
+                    common++;
+            }
+            count += sortedWords[i].size() - common;
+        }
+        return count;
+    }
+}
+
+template<std::size_t WordsCount, std::size_t NodesCount>
+class StaticTrie {
+public:
+    /**
+     * @brief Builds the trie, meant to be evaluated at compile time (see makeStaticTrie()).
+     *
+     * @param words The words, duplicates are allowed.
+     * @pre NodesCount is StaticTrieBuilder::nodesCount(words).
+     */
+    constexpr explicit StaticTrie(const std::array<std::string_view, WordsCount>& words);
+
+    /**
+     * @brief Checks if the trie contains a word.
+     */
+    [[nodiscard]] constexpr bool contains(std::string_view word) const {
+        int node = findNode(word);
+        return node != NO_NODE && nodes[node].isWord;
+    }
+
+    /**
+     * @brief Checks if any word of the trie starts with the given prefix.
+     */
+    [[nodiscard]] constexpr bool hasPrefix(std::string_view prefix) const {
+        return findNode(prefix) != NO_NODE;
+    }
+
+    /**
+     * @return number of distinct words in the trie.
+     */
+    [[nodiscard]] constexpr std::size_t size() const { return wordsCount; }
+
+    [[nodiscard]] static constexpr std::size_t nodeCount() { return NodesCount; }
+
+private:
+    static constexpr int NO_NODE = -1;
+
+    struct Node {
+        int firstEdge = 0;  // index of the node's first edge in edgeChars and edgeTargets
+        int edgesCount = 0;
+        bool isWord = false;
+    };
+
+    std::array<Node, NodesCount> nodes{};
+    // Edge i goes to edgeTargets[i] with edgeChars[i], a node's edges are sorted by character
+    std::array<char, NodesCount> edgeChars{};
+    std::array<int, NodesCount> edgeTargets{};
+    std::size_t wordsCount = 0;
+
+    /**
+     * @return the node reached by following the characters of word from the root, NO_NODE if there is none.
+     */
+    [[nodiscard]] constexpr int findNode(std::string_view word) const;
+
+    /**
+     * @brief Builds the subtrie of node, holding words[begin, end) which share their first depth characters.
+     */
+    constexpr void build(const std::array<std::string_view, WordsCount>& words, std::size_t begin, std::size_t end,
+                         std::size_t depth, int node, int& nextNode, int& nextEdge);
+};
+
+/**
+ * @brief Builds the StaticTrie of a constexpr std::array<std::string_view, N> with static storage duration.
+ */
+template<const auto& Words>
+constexpr auto makeStaticTrie() {
+    constexpr std::size_t wordsCount = std::tuple_size_v<std::remove_cv_t<std::remove_reference_t<decltype(Words)>>>;
+    return StaticTrie<wordsCount, StaticTrieBuilder::nodesCount(Words)>(Words);
+}
+
+template<std::size_t WordsCount, std::size_t NodesCount>
+constexpr StaticTrie<WordsCount, NodesCount>::StaticTrie(const std::array<std::string_view, WordsCount>& words) {
+    auto sortedWords = StaticTrieBuilder::sorted(words);
+
+    int nextNode = 1;
+    int nextEdge = 0;
+    build(sortedWords, 0, WordsCount, 0, 0, nextNode, nextEdge);
+}
+
+template<std::size_t WordsCount, std::size_t NodesCount>
+constexpr void StaticTrie<WordsCount, NodesCount>::build(const std::array<std::string_view, WordsCount>& words,
+                                                         std::size_t begin, std::size_t end, std::size_t depth,
+                                                         int node, int& nextNode, int& nextEdge) {
+    // Words ending at this node sort first
+    while (begin < end && words[begin].size() == depth) {
+        if (!nodes[node].isWord) wordsCount++;
+        nodes[node].isWord = true;
+        begin++;
+    }
+
+    // Reserve the node's edges before building the children, so they are contiguous
+    int childrenCount = 0;
+    for (std::size_t i = begin; i < end; ++i)
+        if (i == begin || words[i][depth] != words[i - 1][depth]) childrenCount++;
+    nodes[node].firstEdge = nextEdge;
+    nodes[node].edgesCount = childrenCount;
+    nextEdge += childrenCount;
+
+    int edge = nodes[node].firstEdge;
+    std::size_t groupBegin = begin;
+    for (std::size_t i = begin + 1; i <= end; ++i) {
+        if (i < end && words[i][depth] == words[groupBegin][depth]) continue;
+
+        int child = nextNode++;
+        edgeChars[edge] = words[groupBegin][depth];
+        edgeTargets[edge] = child;
+        edge++;
+        build(words, groupBegin, i, depth + 1, child, nextNode, nextEdge);
+        groupBegin = i;
+    }
+}
+
+template<std::size_t WordsCount, std::size_t NodesCount>
+constexpr int StaticTrie<WordsCount, NodesCount>::findNode(std::string_view word) const {
+    int node = 0;
+    for (char ch : word) {
+        const Node& current = nodes[node];
+        int next = NO_NODE;
+        for (int edge = current.firstEdge; edge < current.firstEdge + current.edgesCount; ++edge) {
+            if (edgeChars[edge] == ch) {
+                next = edgeTargets[edge];
+                break;
+            }
+        }
+        if (next == NO_NODE) return NO_NODE;
+        node = next;
+    }
+    return node;
+}
+
+#endif //DSA_STATICTRIE_H
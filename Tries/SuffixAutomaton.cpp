@@ -0,0 +1,167 @@
+#include <algorithm>
+
+#include "SuffixAutomaton.h"
+
+/*region PUBLIC */
+
+/* region Constructors */
+
+SuffixAutomaton::SuffixAutomaton(const std::string &text) : mTextSize((int)text.size()) {
+    // Compress the alphabet to the characters present in the text,
+    // so each state's row in the flat transitions table stays small
+    std::fill(std::begin(alphabetIndex), std::end(alphabetIndex), NO_STATE);
+    for (char ch: text) {
+        auto& column = alphabetIndex[(unsigned char)ch];
+        if(column == NO_STATE) column = alphabetSize++;
+    }
+
+    // Reserving the 2n - 1 states bound would cost tens of GB on large texts before any state exists,
+    // the tables grow with addState() instead
+
+    int last = addState(0);
+    for (char ch: text) {
+        last = extend(last, alphabetIndex[(unsigned char)ch]);
+    }
+
+    countEndPositions();
+}
+
+/*endregion*/
+
+/* region Public Constant Methods */
+
+bool SuffixAutomaton::containsSubstring(const std::string &pattern) const {
+    return walk(pattern) != NO_STATE;
+}
+
+int SuffixAutomaton::countOccurrences(const std::string &pattern) const {
+    if(pattern.empty()) return mTextSize + 1;
+
+    int state = walk(pattern);
+    return state == NO_STATE ? 0 : occurrences[state];
+}
+
+std::string SuffixAutomaton::longestCommonSubstring(const std::string &other) const {
+    int state = 0, matched = 0;
+    int bestLength = 0, bestEnd = 0;
+
+    for (std::size_t i = 0; i < other.size(); ++i) {
+        // Follow suffix links until the current match can be extended by other[i]
+        while(state != 0 && next(state, other[i]) == NO_STATE){
+            state = suffixLink[state];
+            matched = length[state];
+        }
+
+        int target = next(state, other[i]);
+        if(target != NO_STATE){
+            state = target;
+            matched++;
+        }
+
+        if(matched > bestLength){
+            bestLength = matched;
+            bestEnd = (int)i + 1;
+        }
+    }
+
+    return other.substr(bestEnd - bestLength, bestLength);
+}
+
+int SuffixAutomaton::stateCount() const {
+    return (int)length.size();
+}
+
+int SuffixAutomaton::textSize() const {
+    return mTextSize;
+}
+
+/*endregion*/
+
+/*endregion PUBLIC*/
+
+/* region PRIVATE */
+
+int SuffixAutomaton::next(int state, char ch) const {
+    int column = alphabetIndex[(unsigned char)ch];
+    if(column == NO_STATE) return NO_STATE;
+
+    return transitions[(size_t)state * alphabetSize + column];
+}
+
+int SuffixAutomaton::walk(const std::string &pattern) const {
+    int state = 0;
+
+    for (char ch: pattern) {
+        state = next(state, ch);
+        if(state == NO_STATE) return NO_STATE;
+    }
+    return state;
+}
+
+int SuffixAutomaton::addState(int stateLength) {
+    transitions.resize(transitions.size() + alphabetSize, NO_STATE);
+    suffixLink.push_back(NO_STATE);
+    length.push_back(stateLength);
+    occurrences.push_back(0);
+
+    return (int)length.size() - 1;
+}
+
+int SuffixAutomaton::extend(int last, int column) {
+    int current = addState(length[last] + 1);
+    occurrences[current] = 1;
+
+    // Add the transition to every suffix of the old text that doesn't have it yet
+    int state = last;
+    while(state != NO_STATE && transitions[(size_t)state * alphabetSize + column] == NO_STATE){
+        transitions[(size_t)state * alphabetSize + column] = current;
+        state = suffixLink[state];
+    }
+
+    if(state == NO_STATE){
+        suffixLink[current] = 0;
+        return current;
+    }
+
+    int target = transitions[(size_t)state * alphabetSize + column];
+    if(length[state] + 1 == length[target]){
+        suffixLink[current] = target;
+        return current;
+    }
+
+    // Split target: clone it with the shorter length so the automaton stays deterministic
+    int clone = addState(length[state] + 1);
+    std::copy_n(transitions.begin() + (long)target * alphabetSize, alphabetSize,
+                transitions.begin() + (long)clone * alphabetSize);
+    suffixLink[clone] = suffixLink[target];
+
+    while(state != NO_STATE && transitions[(size_t)state * alphabetSize + column] == target){
+        transitions[(size_t)state * alphabetSize + column] = clone;
+        state = suffixLink[state];
+    }
+
+    suffixLink[target] = clone;
+    suffixLink[current] = clone;
+
+    return current;
+}
+
+void SuffixAutomaton::countEndPositions() {
+    // Counting sort the states by length, then push each state's count to its suffix link
+    // from the longest to the shortest, so every state is complete before being propagated.
+    std::vector<int> buckets(mTextSize + 2, 0);
+    for (int stateLength: length) buckets[stateLength]++;
+    for (std::size_t i = 1; i < buckets.size(); ++i) buckets[i] += buckets[i - 1];
+
+    std::vector<int> order(length.size());
+    for (int state = (int)length.size() - 1; state >= 0; --state) {
+        order[--buckets[length[state]]] = state;
+    }
+
+    for (int i = (int)order.size() - 1; i > 0; --i) {
+        int state = order[i];
+        occurrences[suffixLink[state]] += occurrences[state];
+    }
+}
+
+/* endregion */
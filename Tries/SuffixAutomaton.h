@@ -0,0 +1,135 @@
+/**
+ * @file SuffixAutomaton.h
+ * @brief Declaration of the SuffixAutomaton class for substring queries over a static text.
+ *
+ * A suffix automaton is the smallest deterministic automaton accepting all the suffixes of a text.
+ * Every substring of the text corresponds to a path starting from the initial state, which makes
+ * it suitable for substring membership, occurrence counting and longest common substring queries,
+ * things the Trie can't answer since it only works on prefixes of whole inserted words.
+ *
+ * The automaton is built in linear time over the text and has at most 2n - 1 states.
+ * Transitions are stored in a single flat array of [states x alphabet size] entries,
+ * where the alphabet is compressed to the distinct characters that appear in the text. A state costs
+ * (alphabet size + 3) ints and a text of n characters typically needs about 1.5n to 1.7n states, so
+ * large texts call for small alphabets: 100 MB of DNA takes about 4.5 GB, more while the tables grow.
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_SUFFIXAUTOMATON_H
+#define DSA_SUFFIXAUTOMATON_H
+
+#include <string>
+#include <vector>
+
+
+class SuffixAutomaton {
+public:
+    /* region Constructors */
+
+    /**
+     * @brief Builds the suffix automaton of the given text.
+     *
+     * @param text The text to be indexed.
+     */
+    explicit SuffixAutomaton(const std::string& text);
+
+    /*endregion*/
+
+    /* region Public Constant Methods */
+
+    /**
+     * @brief Checks if a string occurs as a substring of the text.
+     *
+     * @param pattern The string to search for.
+     * @return true if pattern is a substring of the text, false otherwise.
+     */
+    [[nodiscard]] bool containsSubstring(const std::string& pattern) const;
+
+    /**
+     * @brief Counts the (possibly overlapping) occurrences of a string in the text.
+     *
+     * @param pattern The string to count.
+     * @return number of occurrences of pattern in the text. The empty string occurs text size + 1 times.
+     */
+    [[nodiscard]] int countOccurrences(const std::string& pattern) const;
+
+    /**
+     * @brief Finds the longest string occurring in both the text and another string.
+     *
+     * Runs in O(other.size()).
+     *
+     * @param other The string to compare with the text.
+     * @return The longest common substring, the first one found in other if there are several.
+     */
+    [[nodiscard]] std::string longestCommonSubstring(const std::string& other) const;
+
+    /**
+     * @return number of states in the automaton
+     * */
+    [[nodiscard]] int stateCount() const;
+
+    /**
+     * @return length of the indexed text
+     * */
+    [[nodiscard]] int textSize() const;
+
+    /*endregion*/
+
+private:
+    static constexpr int NO_STATE = -1;
+
+    int alphabetSize = 0;
+    int alphabetIndex[256];         // Character -> column in the transitions table, NO_STATE if absent from text
+    int mTextSize = 0;
+
+    std::vector<int> transitions;   // Flat [state * alphabetSize + column] table, NO_STATE if no transition
+    std::vector<int> suffixLink;
+    std::vector<int> length;        // Length of the longest string of each state
+    std::vector<int> occurrences;   // Size of each state's end-positions set
+
+    /* region Private Constant Methods */
+
+    /**
+     * @brief Gets the transition of a state by a character.
+     *
+     * @return The target state, or NO_STATE if there is no such transition.
+     */
+    [[nodiscard]] int next(int state, char ch) const;
+
+    /**
+     * @brief Walks the automaton from the initial state along the given string.
+     *
+     * @return The state reached after consuming the string, or NO_STATE if it is not a substring.
+     */
+    [[nodiscard]] int walk(const std::string& pattern) const;
+
+    /*endregion*/
+
+    /* region Private Non-Constant Methods */
+
+    /**
+     * @brief Appends a new state with the given longest length and no transitions.
+     *
+     * @return index of the new state.
+     */
+    int addState(int stateLength);
+
+    /**
+     * @brief Extends the automaton by one character of the text (online construction step).
+     *
+     * @param last The state of the whole text processed so far.
+     * @param column The alphabet column of the appended character.
+     * @return The state of the whole text after appending the character.
+     */
+    int extend(int last, int column);
+
+    /**
+     * @brief Computes the occurrences count of every state by propagating them along suffix links.
+     */
+    void countEndPositions();
+
+    /*endregion*/
+};
+
+#endif //DSA_SUFFIXAUTOMATON_H
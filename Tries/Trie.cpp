@@ -1,34 +1,43 @@
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
 #include <stack>
+#include <stdexcept>
 #include <utility>
 
 #include "Trie.h"
+#include "TrieImage.h"
+#include "../Common/MemoryResource.h"
 
 
 /* region Internal Trie NODE struct */
 
 Trie::Node::~Node(){
+    Instrumentation::onDeallocate(sizeof(Node));
     for (auto pair: children) {
-        delete pair.second;
+        deleteNode(resource(), pair.second);
     }
 }
 
 void Trie::Node::insertChild(char ch){
-    children.insert({ch,new Node(ch)});
+    children.insert({ch,newNode<Node>(resource(), ch, resource())});
 };
 
 void Trie::Node::insertChild(Node* child) {
     if(!child) return;
 
-    if(children[child->value]) delete children[child->value];
-
-    children[child->value] = child;
+    auto [it, inserted] = children.insert({child->value, child});
+    if(!inserted){
+        deleteNode(resource(), it->second);
+        it->second = child;
+    }
 }
 
 Trie::Node* Trie::Node::getChild(char ch){
-    if(children.find(ch) == children.end())
-        return nullptr;
-
-    return children[ch];
+    Instrumentation::onVisit();
+    auto it = children.find(ch);
+    return it == children.end() ? nullptr : it->second;
 }
 
 bool Trie::Node::hasChild(const char &ch) {
@@ -39,24 +48,126 @@ std::vector<Trie::Node *> Trie::Node::getChildren() const {
     std::vector<Node *> childrenVector;
     childrenVector.reserve(children.size() + 1);
     for (auto pair:children) {
-        if(!pair.second) continue;
-
         childrenVector.push_back(pair.second);
     }
     return childrenVector;
 }
 
 void Trie::Node::removeChild(char ch) {
-    auto child = children[ch];
-    if(!child->hasChildren()) {
-        delete child;
-        children[ch] = nullptr;
+    auto it = children.find(ch);
+    if(it == children.end()) return;
+
+    // Erase the edge itself, so no dead entries are left in the map
+    if(!it->second->hasChildren()) {
+        deleteNode(resource(), it->second);
+        children.erase(it);
     }
 }
 
 bool Trie::Node::hasChildren() const {
-    return !getChildren().empty();
+    return !children.empty();
 };
+
+std::pmr::memory_resource *Trie::Node::resource() const {
+    return children.get_allocator().resource();
+}
+
+std::size_t Trie::Node::childrenMapBytes() const {
+    // Bucket array of pointers + one heap allocated hash node (entry and next pointer) per element
+    return children.bucket_count() * sizeof(void*)
+           + children.size() * (sizeof(std::pair<const char,Node*>) + sizeof(void*));
+}
+/*endregion */
+
+/* region Internal Trie PATTERN struct */
+
+Trie::Pattern::Pattern(const std::string &pattern) {
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        Token token;
+        char ch = pattern[i];
+
+        if(ch == '*'){
+            // Consecutive stars are equivalent to a single one
+            if(!tokens.empty() && tokens.back().isStar) continue;
+            token.isStar = true;
+        }
+        else if(ch == '?'){
+            token.accepted.set();
+        }
+        else if(ch == '['){
+            std::size_t j = i + 1;
+            bool negated = j < pattern.size() && (pattern[j] == '!' || pattern[j] == '^');
+            if(negated) j++;
+
+            // A ']' right after the opening bracket is a literal member of the class
+            bool first = true;
+            while(j < pattern.size() && (pattern[j] != ']' || first)){
+                auto from = (unsigned char)pattern[j];
+                auto to = from;
+
+                if(j + 2 < pattern.size() && pattern[j + 1] == '-' && pattern[j + 2] != ']'){
+                    to = (unsigned char)pattern[j + 2];
+                    j += 2;
+                }
+                if(from > to) throw std::invalid_argument("Invalid range in pattern character class.");
+
+                for (int c = from; c <= to; ++c)
+                    token.accepted.set(c);
+
+                first = false;
+                j++;
+            }
+            if(j >= pattern.size()) throw std::invalid_argument("Unterminated character class in pattern.");
+
+            if(negated) token.accepted.flip();
+            i = j;
+        }
+        else {
+            if(ch == '\\'){
+                if(i + 1 >= pattern.size()) throw std::invalid_argument("Pattern ends with an escape character.");
+                ch = pattern[++i];
+            }
+            token.accepted.set((unsigned char)ch);
+        }
+
+        tokens.push_back(token);
+    }
+}
+
+std::vector<bool> Trie::Pattern::startStates() const {
+    std::vector<bool> states(tokens.size() + 1, false);
+    addState(states, 0);
+    return states;
+}
+
+std::vector<bool> Trie::Pattern::step(const std::vector<bool> &states, char ch) const {
+    std::vector<bool> next(tokens.size() + 1, false);
+
+    for (std::size_t state = 0; state < tokens.size(); ++state) {
+        if(!states[state]) continue;
+
+        const Token& token = tokens[state];
+        if(token.isStar)
+            addState(next, state);
+        else if(token.accepted.test((unsigned char)ch))
+            addState(next, state + 1);
+    }
+    return next;
+}
+
+bool Trie::Pattern::accepts(const std::vector<bool> &states) const {
+    return states[tokens.size()];
+}
+
+void Trie::Pattern::addState(std::vector<bool> &states, std::size_t state) const {
+    // A star can match the empty sequence, so the state after it is reachable as well
+    while(!states[state]){
+        states[state] = true;
+        if(state == tokens.size() || !tokens[state].isStar) return;
+        state++;
+    }
+}
+
 /*endregion */
 
 /*region PUBLIC */
@@ -64,38 +175,54 @@ bool Trie::Node::hasChildren() const {
 /* region Big Five */
 
 Trie::Trie() {
-    root = new Node(' ');
+    root = newNode<Node>(resource, ' ', resource);
+    nodesCount = 1;
+}
+
+Trie::Trie(std::pmr::memory_resource *resource) : resource(resource) {
+    root = newNode<Node>(resource, ' ', resource);
+    nodesCount = 1;
 }
 
 Trie::Trie(const Trie& other) {
     root = copyNodes(other.root);
+    wordsCount = other.wordsCount;
+    nodesCount = other.nodesCount;
 }
 
 Trie::~Trie(){
-    delete root;
+    deleteNode(resource, root);
 }
 
 Trie& Trie::operator=(const Trie& other) {
     if (this != &other) {
         // Clear the existing trie
-        delete root;
+        deleteNode(resource, root);
 
         // Perform a deep copy of the other trie
         root = copyNodes(other.root);
+        wordsCount = other.wordsCount;
+        nodesCount = other.nodesCount;
     }
     return *this;
 }
 
-Trie::Trie(Trie&& other) noexcept : root(std::exchange(other.root, nullptr)) {
+Trie::Trie(Trie&& other) noexcept : root(std::exchange(other.root, nullptr)),
+                                    resource(other.resource),
+                                    wordsCount(std::exchange(other.wordsCount, 0)),
+                                    nodesCount(std::exchange(other.nodesCount, 0)) {
 }
 
 Trie& Trie::operator=(Trie&& other) noexcept {
     if (this != &other) {
         // Clear the existing trie
-        delete root;
+        deleteNode(resource, root);
 
-        // Move the root pointer from the other object
+        // Move the root pointer (and the resource its nodes come from) from the other object
         root = std::exchange(other.root, nullptr);
+        resource = other.resource;
+        wordsCount = std::exchange(other.wordsCount, 0);
+        nodesCount = std::exchange(other.nodesCount, 0);
     }
     return *this;
 }
@@ -131,6 +258,80 @@ bool Trie::contains(const std::string& word) const {
     return current->isWordEnd;
 }
 
+std::vector<std::string> Trie::match(const std::string &pattern, int limit) const {
+    std::vector<std::string> words;
+
+    match(pattern, [&words](const std::string& word){
+        words.push_back(word);
+        return true;
+    }, limit);
+
+    return words;
+}
+
+int Trie::match(const std::string &pattern, const std::function<bool(const std::string &)> &visitor, int limit) const {
+    Pattern compiled(pattern);
+    if(!root || limit == 0) return 0;
+
+    std::string word;
+    int remaining = limit;
+    int visited = 0;
+
+    match(root, compiled, compiled.startStates(), word, [&visitor, &visited](const std::string& w){
+        visited++;
+        return visitor(w);
+    }, remaining);
+
+    return visited;
+}
+
+int Trie::size() const {
+    return wordsCount;
+}
+
+int Trie::nodeCount() const {
+    return nodesCount;
+}
+
+std::pmr::memory_resource *Trie::getMemoryResource() const {
+    return resource;
+}
+
+Trie::Stats Trie::stats() const {
+    Stats stats;
+    stats.words = wordsCount;
+    stats.nodes = nodesCount;
+
+    if(!root) return stats;
+
+    collectStats(root, 0, stats);
+
+    // collectStats counts the chain nodes, normalize it by the non-root nodes count
+    if(nodesCount > 1)
+        stats.singleChildChainFraction /= (nodesCount - 1);
+
+    stats.nodeBytes = nodesCount * sizeof(Node);
+    return stats;
+}
+
+void Trie::save(const std::string &path) const {
+    std::vector<char> image(sizeof(TrieImage::Header), 0);
+    std::uint32_t rootOffset = serialize(root, image);
+    if(image.size() > UINT32_MAX) throw std::length_error("Trie image exceeds 4 GiB.");
+
+    TrieImage::Header header{};
+    std::memcpy(header.magic, TrieImage::MAGIC, sizeof(header.magic));
+    header.wordCount = (std::uint32_t)wordsCount;
+    header.nodeCount = (std::uint32_t)nodesCount;
+    header.rootOffset = rootOffset;
+    header.imageSize = (std::uint32_t)image.size();
+    std::memcpy(image.data(), &header, sizeof(header));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(image.data(), (std::streamsize)image.size());
+    if(!file) throw std::runtime_error("Couldn't write trie image to " + path);
+}
+
 /*endregion*/
 
 /* region Public Non-Constant Methods */
@@ -139,13 +340,16 @@ void Trie::insert(const std::string& word) {
     auto current = root;
 
     for (char ch:word) {
-        if(!current->hasChild(ch))
+        if(!current->hasChild(ch)) {
             current->insertChild(ch);
+            nodesCount++;
+        }
 
         current = current->getChild(ch);
     }
 
     // Mark last char as a word ending
+    if(!current->isWordEnd) wordsCount++;
     current->isWordEnd = true;
 }
 
@@ -153,6 +357,37 @@ void Trie::remove(const std::string &word) {
     if(!contains(word)) return;
 
     remove(root,word,0);
+    wordsCount--;
+}
+
+/*endregion*/
+
+/* region Public Static Methods */
+
+Trie Trie::load(const std::string &path, std::pmr::memory_resource *resource) {
+    std::ifstream file(path, std::ios::binary);
+    if(!file) throw std::runtime_error("Couldn't open trie image " + path);
+
+    std::vector<char> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    TrieImage::Header header{};
+    if(image.size() < sizeof(header)) throw std::runtime_error("Invalid trie image " + path);
+    std::memcpy(&header, image.data(), sizeof(header));
+
+    if(std::memcmp(header.magic, TrieImage::MAGIC, sizeof(header.magic)) != 0 || header.imageSize != image.size())
+        throw std::runtime_error("Invalid trie image " + path);
+
+    Trie trie(resource);
+    deleteNode(trie.resource, trie.root);
+    trie.root = nullptr;
+    trie.nodesCount = 0;
+    trie.root = trie.deserialize(' ', image.data(), header.imageSize, header.rootOffset);
+
+    // deserialize() counted what it built, an image disagreeing with its own header is corrupted
+    if((std::uint32_t)trie.nodesCount != header.nodeCount || (std::uint32_t)trie.wordsCount != header.wordCount)
+        throw std::runtime_error("Invalid trie image " + path);
+
+    return trie;
 }
 
 /*endregion*/
@@ -191,7 +426,7 @@ Trie::Node *Trie::getLastNode(const std::string &word) const {
 Trie::Node* Trie::copyNodes(Node* source)  const{
     if (!source) return nullptr;
 
-    auto node = new Node(source->value);
+    auto node = newNode<Node>(resource, source->value, resource);
     node->isWordEnd = source->isWordEnd;
 
     for (const auto& child : source->getChildren()) {
@@ -200,6 +435,107 @@ Trie::Node* Trie::copyNodes(Node* source)  const{
     return node;
 }
 
+bool Trie::match(const Node *node, const Pattern &pattern, const std::vector<bool> &states, std::string &word,
+                 const std::function<bool(const std::string &)> &visitor, int &remaining) const {
+    if(node->isWordEnd && pattern.accepts(states)){
+        if(!visitor(word)) return false;
+        if(remaining > 0 && --remaining == 0) return false;
+    }
+
+    for (Node* child: node->getChildren()) {
+        auto next = pattern.step(states, child->value);
+
+        // Prune the sub-trie if no NFA state survived this character
+        bool alive = false;
+        for (bool state: next) alive = alive || state;
+        if(!alive) continue;
+
+        word += child->value;
+        bool proceed = match(child, pattern, next, word, visitor, remaining);
+        word.pop_back();
+
+        if(!proceed) return false;
+    }
+    return true;
+}
+
+std::uint32_t Trie::serialize(const Node *node, std::vector<char> &image) const {
+    auto children = node->getChildren();
+    std::sort(children.begin(), children.end(), [](const Node* a, const Node* b){
+        return (unsigned char)a->value < (unsigned char)b->value;
+    });
+
+    auto childCount = (std::uint32_t)children.size();
+    // Offsets are 32 bits wide, a larger image can't address its records
+    if(image.size() + TrieImage::recordSize(childCount) > UINT32_MAX)
+        throw std::length_error("Trie image exceeds 4 GiB.");
+    auto offset = (std::uint32_t)image.size();
+    image.resize(offset + TrieImage::recordSize(childCount), 0);
+
+    auto info = TrieImage::makeInfo(node->isWordEnd, childCount);
+    std::memcpy(&image[offset], &info, sizeof(info));
+
+    // Children records follow their parent's (preorder), patch their offsets once written
+    std::uint32_t charsOffset = offset + 4 + 4 * childCount;
+    for (std::uint32_t i = 0; i < childCount; ++i) {
+        image[charsOffset + i] = children[i]->value;
+
+        std::uint32_t childOffset = serialize(children[i], image);
+        std::memcpy(&image[offset + 4 + 4 * i], &childOffset, sizeof(childOffset));
+    }
+
+    return offset;
+}
+
+Trie::Node *Trie::deserialize(char value, const char *image, std::uint32_t size, std::uint32_t offset) {
+    if(offset % 4 != 0 || offset + 4 > size)
+        throw std::runtime_error("Corrupted trie image.");
+
+    auto info = TrieImage::read(image, offset);
+    auto childCount = TrieImage::childCount(info);
+    if(childCount > 256 || offset + TrieImage::recordSize(childCount) > size)
+        throw std::runtime_error("Corrupted trie image.");
+
+    auto node = newNode<Node>(resource, value, resource);
+    node->isWordEnd = TrieImage::isWordEnd(info);
+    nodesCount++;
+    if(node->isWordEnd) wordsCount++;
+
+    const char* chars = image + offset + 4 + 4 * childCount;
+    for (std::uint32_t i = 0; i < childCount; ++i) {
+        auto childOffset = TrieImage::read(image, offset + 4 + 4 * i);
+        try {
+            // Preorder puts children after their parent, anything else would allow cycles
+            if(childOffset <= offset) throw std::runtime_error("Corrupted trie image.");
+            node->insertChild(deserialize(chars[i], image, size, childOffset));
+        } catch (...) {
+            deleteNode(resource, node);
+            throw;
+        }
+    }
+    return node;
+}
+
+void Trie::collectStats(const Node* node, int depth, Stats& stats) const {
+    auto children = node->getChildren();
+    int fanOut = (int)children.size();
+
+    if((int)stats.fanOutHistogram.size() <= fanOut) stats.fanOutHistogram.resize(fanOut + 1, 0);
+    if((int)stats.depthHistogram.size() <= depth) stats.depthHistogram.resize(depth + 1, 0);
+
+    stats.fanOutHistogram[fanOut]++;
+    stats.depthHistogram[depth]++;
+    stats.childrenMapBytes += node->childrenMapBytes();
+
+    // Root can never be merged into a chain, so it is excluded
+    if(depth > 0 && fanOut == 1 && !node->isWordEnd)
+        stats.singleChildChainFraction++;
+
+    for (Node* child: children) {
+        collectStats(child, depth + 1, stats);
+    }
+}
+
 void Trie::remove(Node *node, const std::string &word, int nextIndex) {
     if(!node) return;
 
@@ -219,6 +555,7 @@ void Trie::remove(Node *node, const std::string &word, int nextIndex) {
     // Physically delete the child node if it is not a part of another word
     if(!child->hasChildren() && !child->isWordEnd){
         node->removeChild(nextCh);
+        nodesCount--;
     }
 }
 
@@ -11,24 +11,41 @@
  * where each node represents a character of a string. This allows for fast prefix matching and other string-based
  * operations. The class also includes methods for copying, moving, and managing the trie's contents.
  *
+ * Trie is not a template, so its Instrumentation policy (see Common/Instrumentation.h) is selected at build
+ * time by defining DSA_TRIE_INSTRUMENTATION (e.g. -DDSA_TRIE_INSTRUMENTATION=CountingInstrumentation)
+ * consistently for every translation unit. It is notified of node allocations and visits.
+ *
+ * Nodes and their children maps are allocated from a std::pmr::memory_resource given at construction
+ * (the default resource otherwise). Copies use the default resource, moves carry the nodes along with their resource.
+ *
  * @author Mahmoud Ashraf
  * @date 20/8/2023
  */
 #ifndef DSA_TRIE_H
 #define DSA_TRIE_H
 
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
 #include <unordered_map>
 #include <string>
 #include <vector>
 
+#include "../Common/Instrumentation.h"
+
 
 class Trie {
 
 struct Node;
+struct Pattern;
 public:
+    struct Stats;
+
     /* region Big Five */
 
     Trie();
+    explicit Trie(std::pmr::memory_resource* resource); // Nodes are allocated from resource, which must outlive the trie
 
     Trie(const Trie& other); // copy constructor
     Trie(Trie&& other) noexcept; // Move constructor
@@ -62,6 +79,80 @@ public:
      * */
     [[nodiscard]] bool contains(const std::string& word) const;
 
+    /**
+     * @brief Retrieves the words matching a wildcard pattern.
+     *
+     * Supported syntax:
+     * - '?' matches exactly one character.
+     * - '*' matches any sequence of characters (including the empty one).
+     * - "[abc]", "[a-z]" match one character of the class, "[!abc]" or "[^abc]" negate it.
+     * - '\' escapes the following character.
+     *
+     * The pattern is compiled to an NFA that is walked together with the trie,
+     * so sub-tries that can't lead to a match are never visited.
+     *
+     * @param pattern The wildcard pattern to match.
+     * @param limit Maximum number of words to retrieve, a negative value means no limit.
+     * @return A vector of the matching words.
+     * @throws std::invalid_argument If the pattern is malformed.
+     */
+    [[nodiscard]] std::vector<std::string> match(const std::string& pattern, int limit = -1) const;
+
+    /**
+     * @brief Streams the words matching a wildcard pattern to a visitor.
+     *
+     * Same as match(pattern, limit), but each matching word is passed to the visitor
+     * as soon as it is found instead of being collected.
+     * The search stops early when the visitor returns false or the limit is reached.
+     *
+     * @param pattern The wildcard pattern to match.
+     * @param visitor Callback invoked with each matching word, returns false to stop the search.
+     * @param limit Maximum number of words to visit, a negative value means no limit.
+     * @return The number of visited words.
+     * @throws std::invalid_argument If the pattern is malformed.
+     */
+    int match(const std::string& pattern, const std::function<bool(const std::string&)>& visitor, int limit = -1) const;
+
+    /**
+     * @brief Gets the number of words stored in the trie.
+     *
+     * @return number of words in the trie.
+     */
+    [[nodiscard]] int size() const;
+
+    /**
+     * @brief Gets the number of nodes allocated by the trie, including the root.
+     *
+     * @return number of nodes in the trie.
+     */
+    [[nodiscard]] int nodeCount() const;
+
+    /**
+     * @return the memory resource the trie's nodes are allocated from.
+     */
+    [[nodiscard]] std::pmr::memory_resource* getMemoryResource() const;
+
+    /**
+     * @brief Collects shape and memory statistics of the trie.
+     *
+     * Traverses the whole trie, so it runs in O(number of nodes).
+     *
+     * @return a Stats object describing the current trie.
+     */
+    [[nodiscard]] Stats stats() const;
+
+    /**
+     * @brief Writes the trie to a file as a compact binary image.
+     *
+     * The image is a preorder stream of node records with their child tables (see TrieImage.h),
+     * it can be read back with Trie::load() or queried in place with MappedTrie.
+     *
+     * @param path The path of the file to be written.
+     * @throws std::runtime_error If the file can't be written.
+     * @throws std::length_error If the image would exceed 4 GiB, the limit of its 32 bit offsets.
+     */
+    void save(const std::string& path) const;
+
     /*endregion*/
 
     /* region Public Non-Constant Methods */
@@ -84,8 +175,31 @@ public:
 
     /*endregion*/
 
+    /* region Public Static Methods */
+
+    /**
+     * @brief Reads a trie from a binary image written by save().
+     *
+     * @param path The path of the image file.
+     * @param resource The memory resource the loaded trie allocates its nodes from.
+     * @return The loaded trie.
+     * @throws std::runtime_error If the file can't be read or is not a valid trie image.
+     */
+    static Trie load(const std::string& path, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /*endregion*/
+
 private:
+#ifdef DSA_TRIE_INSTRUMENTATION
+    using Instrumentation = DSA_TRIE_INSTRUMENTATION;
+#else
+    using Instrumentation = NoInstrumentation;
+#endif
+
     Node* root;
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+    int wordsCount = 0;     // Number of words stored in the trie
+    int nodesCount = 0;     // Number of allocated nodes, root included
 
     /* region Private Constant Methods */
 
@@ -112,6 +226,52 @@ private:
 
     Node* copyNodes(Node* source) const;
 
+    /**
+     * @brief Recursively walks the trie and the pattern NFA together, visiting the matching words.
+     *
+     * @param node The current node being traversed.
+     * @param pattern The compiled pattern.
+     * @param states The NFA states reached after consuming the current word.
+     * @param word The current word formed during traversal.
+     * @param visitor Callback invoked with each matching word.
+     * @param remaining Number of words still allowed to be visited, negative means unlimited.
+     * @return false if the search should stop, true otherwise.
+     */
+    bool match(const Node* node, const Pattern& pattern, const std::vector<bool>& states, std::string& word,
+               const std::function<bool(const std::string&)>& visitor, int& remaining) const;
+
+    /**
+     * @brief Recursively accumulates the statistics of the sub-trie rooted at the given node.
+     *
+     * @param node The current node being traversed.
+     * @param depth The depth of the node (root is at depth 0).
+     * @param stats The Stats object to accumulate into.
+     */
+    void collectStats(const Node* node, int depth, Stats& stats) const;
+
+    /**
+     * @brief Recursively appends the records of the sub-trie rooted at the given node to an image.
+     *
+     * @param node The current node being serialized.
+     * @param image The image buffer to append to.
+     * @return The offset of the node's record in the image.
+     * @throws std::length_error If the image grows past 4 GiB.
+     */
+    std::uint32_t serialize(const Node* node, std::vector<char>& image) const;
+
+    /**
+     * @brief Recursively builds the sub-trie whose record is at the given offset of an image,
+     * adding the built nodes and words to the trie's counts.
+     *
+     * @param value The character of the node to be built.
+     * @param image The image buffer.
+     * @param size The image size in bytes.
+     * @param offset The offset of the node's record.
+     * @return Pointer to the built node.
+     * @throws std::runtime_error If the record lies outside the image.
+     */
+    Node* deserialize(char value, const char* image, std::uint32_t size, std::uint32_t offset);
+
     /*endregion*/
 
     /* region Private Non-Constant Methods */
@@ -135,7 +295,13 @@ struct Trie::Node{
     char value;
     bool isWordEnd = false;
 
-    explicit Node(char value) : value(value){};
+    /**
+     * @param value The character of the node.
+     * @param resource The memory resource the node's children (and their maps) are allocated from.
+     */
+    Node(char value, std::pmr::memory_resource* resource) : value(value), children(resource){
+        Instrumentation::onAllocate(sizeof(Node));
+    };
     ~Node();
 
     /*region PUBLIC non-Constant Methods*/
@@ -194,7 +360,7 @@ struct Trie::Node{
     /**
      * @brief Checks if the node has any children.
      *
-     * Checks whether the current node has any valid child nodes.
+     * Checks whether the current node has any child nodes, in O(1) and without allocating.
      *
      * @return True if the node has children, otherwise false.
      */
@@ -203,16 +369,96 @@ struct Trie::Node{
     /**
      * @brief Retrieves a vector of child nodes.
      *
-     * Retrieves a vector containing pointers to all valid child nodes of the current node.
+     * Retrieves a vector containing pointers to all child nodes of the current node.
      *
      * @return A vector of child node pointers.
      */
     std::vector<Node*> getChildren() const;
+
+    /**
+     * @brief Estimates the heap memory used by the node's children map.
+     *
+     * Counts the bucket array and one allocated map node per entry.
+     *
+     * @return Estimated number of bytes owned by the children map.
+     */
+    std::size_t childrenMapBytes() const;
     /*endregion*/
 
 private:
-    std::unordered_map<char,Node*> children;
+    std::pmr::unordered_map<char,Node*> children;
 
+    /**
+     * @return the memory resource this node's children are allocated from.
+     */
+    std::pmr::memory_resource* resource() const;
+
+};
+
+/**
+ * @brief Wildcard pattern compiled to an NFA.
+ *
+ * Each token of the pattern is an NFA state, and state [tokens.size()] is the accepting state.
+ * A '*' token loops on any character and can also be skipped (epsilon transition),
+ * every other token consumes exactly one matching character.
+ */
+struct Trie::Pattern{
+    struct Token{
+        bool isStar = false;
+        std::bitset<256> accepted;  // Characters accepted by non-star tokens
+    };
+
+    std::vector<Token> tokens;
+
+    explicit Pattern(const std::string& pattern);
+
+    /**
+     * @brief Gets the set of states active before consuming any character.
+     */
+    [[nodiscard]] std::vector<bool> startStates() const;
+
+    /**
+     * @brief Gets the set of states reached after consuming a character from the given states.
+     *
+     * @param states The current set of states.
+     * @param ch The consumed character.
+     * @return The next set of states, all false if no state accepts the character.
+     */
+    [[nodiscard]] std::vector<bool> step(const std::vector<bool>& states, char ch) const;
+
+    /**
+     * @brief Checks whether the given set of states contains the accepting state.
+     */
+    [[nodiscard]] bool accepts(const std::vector<bool>& states) const;
+
+private:
+    /**
+     * @brief Adds a state to the set, following the epsilon transitions of '*' tokens.
+     */
+    void addState(std::vector<bool>& states, std::size_t state) const;
+};
+
+/**
+ * @brief Shape and memory statistics of a Trie.
+ *
+ * fanOutHistogram[k] holds the number of nodes having exactly k children,
+ * depthHistogram[d] holds the number of nodes at depth d (root is at depth 0).
+ */
+struct Trie::Stats{
+    int words = 0;
+    int nodes = 0;
+
+    std::vector<int> fanOutHistogram;
+    std::vector<int> depthHistogram;
+
+    std::size_t nodeBytes = 0;          // Bytes used by the Node objects themselves
+    std::size_t childrenMapBytes = 0;   // Bytes used by the unordered_maps' buckets and entries
+
+    /*
+     * Fraction of non-root nodes that have exactly one child and do not end a word.
+     * These nodes are the ones a compressed (radix) layout would merge away.
+     * */
+    double singleChildChainFraction = 0;
 };
 
 #endif //DSA_TRIE_H
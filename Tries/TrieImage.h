@@ -0,0 +1,68 @@
+/**
+ * @file TrieImage.h
+ * @brief Binary on-disk layout shared by Trie::save, Trie::load and MappedTrie.
+ *
+ * The image starts with a fixed Header followed by the node records in preorder
+ * (every node is written before its children, children in ascending character order).
+ * All integers are 32-bit, in the native byte order, and every record is 4-byte aligned
+ * so it can be read in place from a memory mapped file.
+ *
+ * Node record layout:
+ *  - uint32 info:                    bit 0 is the word-end flag, bits 8..16 hold the children count k.
+ *  - uint32 childOffsets[k]:         byte offset of each child's record from the image start.
+ *  - char   childChars[k]:           the children's characters, sorted ascending.
+ *  - padding to the next multiple of 4 bytes.
+ *
+ * @author Mahmoud Ashraf
+ * @date 18/10/2026
+ */
+#ifndef DSA_TRIEIMAGE_H
+#define DSA_TRIEIMAGE_H
+
+#include <cstdint>
+#include <cstring>
+
+
+struct TrieImage {
+
+    static constexpr char MAGIC[8] = {'D','S','A','T','R','I','E','1'};
+    static constexpr std::uint32_t WORD_END_FLAG = 1;
+
+    struct Header{
+        char magic[8];
+        std::uint32_t wordCount;
+        std::uint32_t nodeCount;
+        std::uint32_t rootOffset;
+        std::uint32_t imageSize;
+    };
+
+    /**
+     * @brief Gets the size in bytes of a node record with the given children count, padding included.
+     */
+    static std::uint32_t recordSize(std::uint32_t childCount){
+        return 4 + 4 * childCount + ((childCount + 3) & ~3u);
+    }
+
+    static std::uint32_t makeInfo(bool isWordEnd, std::uint32_t childCount){
+        return (isWordEnd ? WORD_END_FLAG : 0) | (childCount << 8);
+    }
+
+    static bool isWordEnd(std::uint32_t info){
+        return info & WORD_END_FLAG;
+    }
+
+    static std::uint32_t childCount(std::uint32_t info){
+        return info >> 8;
+    }
+
+    /**
+     * @brief Reads a native uint32 from an (aligned) position in the image.
+     */
+    static std::uint32_t read(const char* image, std::uint32_t offset){
+        std::uint32_t value;
+        std::memcpy(&value, image + offset, sizeof(value));
+        return value;
+    }
+};
+
+#endif //DSA_TRIEIMAGE_H